@@ -1,17 +1,23 @@
 from __future__ import annotations
 
-from io import BytesIO
+import asyncio
 import json
 from tempfile import SpooledTemporaryFile
 from typing import BinaryIO
 import zipfile
 
 from fastapi import APIRouter, Depends, Header, HTTPException, Request
-from fastapi.responses import JSONResponse, Response
+from fastapi.responses import JSONResponse, Response, StreamingResponse
 
 from backend.app.api.deps import get_container
 from backend.app.core.container import AppContainer
+from backend.app.engine.offline_render import (
+    OfflineRenderError,
+    OfflineRenderTimeoutError,
+    OfflineRenderUnavailableError,
+)
 from backend.app.models.export import PerformanceCsdExportRequest
+from backend.app.services.archive_stream import ArchiveBytesEntry, ArchiveEntry, ArchiveFileEntry, iter_zip_archive
 from backend.app.services.compiler_service import CompilationError
 from backend.app.services.gen_asset_references import (
     collect_persisted_gen_audio_stored_names,
@@ -20,7 +26,10 @@ from backend.app.services.gen_asset_references import (
     normalize_zip_member_name,
 )
 from backend.app.services.gen_asset_service import GenAudioAssetQuotaExceededError
-from backend.app.services.performance_export_service import PerformanceExportService
+from backend.app.services.performance_export_service import (
+    OfflineRenderDurationExceededError,
+    PerformanceExportService,
+)
 
 router = APIRouter(prefix="/bundles", tags=["bundles"])
 
@@ -64,16 +73,26 @@ async def export_performance_csd_bundle(
     exporter = PerformanceExportService(
         compiler_service=container.compiler_service,
         gen_asset_service=container.gen_asset_service,
+        offline_renderer=container.offline_renderer,
+        max_render_duration_seconds=container.settings.offline_render_max_duration_seconds,
     )
     try:
-        archive_bytes = exporter.build_performance_csd_archive(payload)
+        archive = await asyncio.to_thread(exporter.prepare_performance_csd_archive, payload)
+    except OfflineRenderDurationExceededError as err:
+        raise HTTPException(status_code=413, detail=str(err)) from err
     except ValueError as err:
         raise HTTPException(status_code=400, detail=str(err)) from err
     except CompilationError as err:
         raise HTTPException(status_code=422, detail={"diagnostics": err.diagnostics}) from err
-
-    return Response(
-        content=archive_bytes,
+    except OfflineRenderUnavailableError as err:
+        raise HTTPException(status_code=503, detail=str(err)) from err
+    except OfflineRenderTimeoutError as err:
+        raise HTTPException(status_code=503, detail=str(err)) from err
+    except OfflineRenderError as err:
+        raise HTTPException(status_code=422, detail=str(err)) from err
+
+    return StreamingResponse(
+        archive.iter_bytes(),
         media_type="application/zip",
         headers={"X-Orchestron-Export-Format": "zip"},
     )
@@ -129,20 +148,20 @@ def _build_export_response(
             headers={"X-Orchestron-Export-Format": "json"},
         )
 
-    archive_buffer = BytesIO()
+    # Assets are resolved before the response starts so missing files still fail with 400; their bytes are
+    # only read while the archive streams.
+    entries: list[ArchiveEntry] = [ArchiveBytesEntry(json_entry_name, json_bytes)]
     try:
-        with zipfile.ZipFile(archive_buffer, mode="w", compression=zipfile.ZIP_DEFLATED) as archive:
-            archive.writestr(json_entry_name, json_bytes)
-            for stored_name in stored_names:
-                source_path = container.gen_asset_service.resolve_audio_path(stored_name)
-                if not source_path.exists():
-                    raise ValueError(f"Referenced GEN audio asset '{stored_name}' does not exist on the backend.")
-                archive.writestr(f"audio/{stored_name}", source_path.read_bytes())
+        for stored_name in stored_names:
+            source_path = container.gen_asset_service.resolve_audio_path(stored_name)
+            if not source_path.is_file():
+                raise ValueError(f"Referenced GEN audio asset '{stored_name}' does not exist on the backend.")
+            entries.append(ArchiveFileEntry(f"audio/{stored_name}", source_path))
     except ValueError as err:
         raise HTTPException(status_code=400, detail=str(err)) from err
 
-    return Response(
-        content=archive_buffer.getvalue(),
+    return StreamingResponse(
+        iter_zip_archive(entries),
         media_type="application/zip",
         headers={"X-Orchestron-Export-Format": "zip"},
     )
@@ -1,10 +1,16 @@
 from __future__ import annotations
 
-from fastapi import APIRouter, Depends
+from fastapi import APIRouter, Depends, Response
 
 from backend.app.api.deps import get_container
 from backend.app.core.container import AppContainer
-from backend.app.models.runtime import RuntimeConfigResponse
+from backend.app.engine.render_metrics import OPENMETRICS_CONTENT_TYPE
+from backend.app.models.runtime import (
+    CsoundPoolStatusResponse,
+    RenderExecutorStatusResponse,
+    RenderWorkerStatus,
+    RuntimeConfigResponse,
+)
 
 router = APIRouter(prefix="/runtime-config", tags=["runtime"])
 
@@ -15,3 +21,47 @@ async def get_runtime_config(container: AppContainer = Depends(get_container)) -
         audio_output_mode=container.settings.audio_output_mode,
         browser_clock_enabled=container.settings.audio_output_mode == "browser_clock",
     )
+
+
+@router.get("/render-executor", response_model=RenderExecutorStatusResponse)
+async def get_render_executor_status(container: AppContainer = Depends(get_container)) -> RenderExecutorStatusResponse:
+    executor = container.render_executor
+    return RenderExecutorStatusResponse(
+        worker_count=executor.worker_count,
+        workers=[
+            RenderWorkerStatus(
+                worker_index=stats.worker_index,
+                cpu=stats.cpu,
+                queue_depth=stats.queue_depth,
+                pinned_sessions=stats.pinned_sessions,
+                completed_tasks=stats.completed_tasks,
+                busy_ms=stats.busy_ns / 1_000_000.0,
+                busy_ratio=(stats.busy_ns / stats.uptime_ns) if stats.uptime_ns > 0 else 0.0,
+            )
+            for stats in executor.stats()
+        ],
+    )
+
+
+@router.get("/csound-pool", response_model=CsoundPoolStatusResponse)
+async def get_csound_pool_status(container: AppContainer = Depends(get_container)) -> CsoundPoolStatusResponse:
+    stats = container.csound_pool.stats()
+    return CsoundPoolStatusResponse(
+        target_size=stats.target_size,
+        idle_instances=stats.idle_instances,
+        warm_acquires=stats.warm_acquires,
+        cold_acquires=stats.cold_acquires,
+        rtmidi_modules=stats.rtmidi_modules,
+        start_count=stats.start_count,
+        start_latency_p50_ms=stats.start_latency_p50_ms,
+        start_latency_p99_ms=stats.start_latency_p99_ms,
+        start_latency_max_ms=stats.start_latency_max_ms,
+    )
+
+
+@router.get("/metrics", response_class=Response)
+async def get_render_metrics(container: AppContainer = Depends(get_container)) -> Response:
+    return Response(
+        content=await container.session_service.render_metrics_exposition(),
+        media_type=OPENMETRICS_CONTENT_TYPE,
+    )
@@ -1,5 +1,7 @@
 from __future__ import annotations
 
+from typing import Any
+
 from fastapi import APIRouter, Depends, Request, Response
 
 from backend.app.api.deps import get_container
@@ -17,6 +19,8 @@ from backend.app.models.session import (
     SessionActionResponse,
     SessionCreateRequest,
     SessionCreateResponse,
+    SessionHotReloadRequest,
+    SessionHotReloadResponse,
     SessionInfo,
 )
 
@@ -53,6 +57,15 @@ async def start_session(session_id: str, container: AppContainer = Depends(get_c
     return await container.session_service.start_session(session_id)
 
 
+@router.post("/{session_id}/hot-reload", response_model=SessionHotReloadResponse)
+async def hot_reload_session(
+    session_id: str,
+    request: SessionHotReloadRequest | None = None,
+    container: AppContainer = Depends(get_container),
+) -> SessionHotReloadResponse:
+    return await container.session_service.hot_reload_session(session_id, request or SessionHotReloadRequest())
+
+
 @router.post("/{session_id}/stop", response_model=SessionActionResponse)
 async def stop_session(session_id: str, container: AppContainer = Depends(get_container)) -> SessionActionResponse:
     return await container.session_service.stop_session(session_id)
@@ -72,6 +85,14 @@ async def midi_event(
     return await container.session_service.send_midi_event(session_id, request)
 
 
+@router.get("/{session_id}/midi-trace")
+async def midi_trace(
+    session_id: str,
+    container: AppContainer = Depends(get_container),
+) -> dict[str, Any]:
+    return await container.session_service.get_session_midi_trace(session_id)
+
+
 @router.put("/{session_id}/sequencer/config", response_model=SessionSequencerStatus)
 async def configure_sequencer(
     session_id: str,
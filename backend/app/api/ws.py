@@ -3,6 +3,7 @@ from __future__ import annotations
 import asyncio
 import contextlib
 import json
+import math
 import time
 from uuid import uuid4
 
@@ -11,6 +12,7 @@ from fastapi.responses import JSONResponse
 from pydantic import ValidationError
 
 from backend.app.core.container import AppContainer
+from backend.app.engine.browser_clock_frames import BrowserClockRenderChunkEncoder
 from backend.app.models.session import (
     BROWSER_CLOCK_RENDER_QUEUE_MAXSIZE,
     BrowserClockClaimControllerRequest,
@@ -18,6 +20,7 @@ from backend.app.models.session import (
     BrowserClockManualMidiRequest,
     BrowserClockQueuePadControlRequest,
     BrowserClockReleaseControllerRequest,
+    BrowserClockRenderStatsRequest,
     BrowserClockRequestRenderRequest,
     BrowserClockSequencerCommandRequest,
     BrowserClockSequencerStartControlRequest,
@@ -44,6 +47,17 @@ def _http_error_detail(detail: object) -> str:
         return str(detail)
 
 
+def _sequencer_frame_ms(websocket: WebSocket, *, default: float) -> float:
+    raw_value = websocket.query_params.get("sequencer_frame_ms")
+    if raw_value is None:
+        return default
+    try:
+        value = float(raw_value)
+    except ValueError:
+        return default
+    return value if math.isfinite(value) else default
+
+
 async def _deny_websocket(websocket: WebSocket, *, status_code: int, detail: object) -> None:
     try:
         await websocket.send_denial_response(
@@ -62,7 +76,10 @@ async def session_events(websocket: WebSocket, session_id: str) -> None:
     client_key = websocket.client.host if websocket.client is not None else "unknown"
     try:
         await container.session_service.validate_session_event_ws_connect(session_id, client_key=client_key)
-        queue = await container.event_bus.subscribe(session_id)
+        subscription = await container.event_bus.subscribe(
+            session_id,
+            sequencer_frame_ms=_sequencer_frame_ms(websocket, default=container.settings.session_event_sequencer_frame_ms),
+        )
     except HTTPException as exc:
         await _deny_websocket(websocket, status_code=exc.status_code, detail=exc.detail)
         return
@@ -73,15 +90,14 @@ async def session_events(websocket: WebSocket, session_id: str) -> None:
     try:
         await websocket.accept()
     except Exception:
-        await container.event_bus.unsubscribe(session_id, queue)
+        await container.event_bus.unsubscribe(session_id, subscription)
         raise
     connection_id = str(uuid4())
     await container.session_service.frontend_connected(session_id, connection_id)
 
     async def send_loop() -> None:
         while True:
-            event = await queue.get()
-            await websocket.send_json(event.model_dump(mode="json"))
+            await websocket.send_text(await subscription.next_serialized())
 
     async def receive_loop() -> None:
         while True:
@@ -116,7 +132,7 @@ async def session_events(websocket: WebSocket, session_id: str) -> None:
     except WebSocketDisconnect:
         pass
     finally:
-        await container.event_bus.unsubscribe(session_id, queue)
+        await container.event_bus.unsubscribe(session_id, subscription)
         await container.session_service.frontend_disconnected(session_id, connection_id)
 
 
@@ -130,6 +146,7 @@ async def browser_clock_controller(websocket: WebSocket, session_id: str) -> Non
     render_queue: asyncio.Queue[BrowserClockRenderJob | None] = asyncio.Queue(
         maxsize=BROWSER_CLOCK_RENDER_QUEUE_MAXSIZE
     )
+    render_chunk_encoder: BrowserClockRenderChunkEncoder | None = None
 
     async def send_json(payload: dict[str, object]) -> None:
         async with send_lock:
@@ -209,7 +226,7 @@ async def browser_clock_controller(websocket: WebSocket, session_id: str) -> Non
 
             request, server_received_ns = job
             try:
-                metadata, pcm = await container.session_service.render_browser_clock_audio(
+                chunk = await container.session_service.render_browser_clock_audio(
                     session_id,
                     connection_id,
                     request,
@@ -219,7 +236,29 @@ async def browser_clock_controller(websocket: WebSocket, session_id: str) -> Non
                     await container.session_service.require_browser_clock_controller(session_id, connection_id)
                 except HTTPException:
                     continue
-                await send_render_chunk(metadata, pcm)
+                encoder = render_chunk_encoder
+                if encoder is None:
+                    await send_render_chunk(chunk.json_metadata(), chunk.render.pcm_f32le)
+                    container.session_service.record_browser_clock_chunk_sent(session_id, chunk.render)
+                    continue
+                # The encoder keeps per-connection state; this task is its only caller, so
+                # the encode can run on the session's render worker while the loop stays free.
+                frame = await container.render_executor.run(
+                    session_id,
+                    encoder.encode,
+                    engine_sample_start=chunk.render.engine_sample_start,
+                    engine_sample_end=chunk.render.engine_sample_end,
+                    engine_sample_rate=chunk.render.engine_sample_rate,
+                    target_sample_rate=chunk.render.target_sample_rate,
+                    target_frame_count=chunk.render.target_frame_count,
+                    block_count=chunk.render.block_count,
+                    channels=chunk.render.channels,
+                    pcm_f32le=chunk.render.pcm_f32le,
+                    sequencer_status=chunk.sequencer_status,
+                    telemetry=chunk.telemetry,
+                )
+                await send_bytes(frame)
+                container.session_service.record_browser_clock_chunk_sent(session_id, chunk.render)
             except asyncio.CancelledError:
                 raise
             except HTTPException as exc:
@@ -250,13 +289,19 @@ async def browser_clock_controller(websocket: WebSocket, session_id: str) -> Non
             server_received_ns = time.perf_counter_ns()
             try:
                 if message_type == "claim_controller":
+                    claim_request = BrowserClockClaimControllerRequest.model_validate(payload)
                     response = await container.session_service.claim_browser_clock_controller(
                         session_id,
                         connection_id,
-                        BrowserClockClaimControllerRequest.model_validate(payload),
+                        claim_request,
                         send_json=send_json,
                         close=close_socket,
                     )
+                    render_chunk_encoder = (
+                        BrowserClockRenderChunkEncoder(pcm_encoding=claim_request.pcm_encoding)
+                        if claim_request.render_chunk_format == "binary"
+                        else None
+                    )
                     await send_json(response)
                     continue
 
@@ -286,18 +331,22 @@ async def browser_clock_controller(websocket: WebSocket, session_id: str) -> Non
                     continue
 
                 if message_type == "clock_sync":
-                    await container.session_service.require_browser_clock_controller(session_id, connection_id)
-                    server_sent_ns = time.perf_counter_ns()
-                    request = BrowserClockClockSyncRequest.model_validate(payload)
-                    await send_json(
-                        {
-                            "type": "clock_sync",
-                            "request_id": request.request_id,
-                            "client_send_perf_ms": request.client_send_perf_ms,
-                            "server_received_monotonic_ns": server_received_ns,
-                            "server_sent_monotonic_ns": server_sent_ns,
-                        }
+                    response = await container.session_service.browser_clock_clock_sync(
+                        session_id,
+                        connection_id,
+                        BrowserClockClockSyncRequest.model_validate(payload),
+                        server_received_ns=server_received_ns,
                     )
+                    await send_json(response)
+                    continue
+
+                if message_type == "render_stats":
+                    response = await container.session_service.browser_clock_render_stats(
+                        session_id,
+                        connection_id,
+                        BrowserClockRenderStatsRequest.model_validate(payload),
+                    )
+                    await send_json(response)
                     continue
 
                 if message_type == "manual_midi":
@@ -418,7 +467,22 @@ async def host_midi_bridge(websocket: WebSocket) -> None:
 
     try:
         while True:
-            message = await websocket.receive_text()
+            frame = await websocket.receive()
+            if frame["type"] == "websocket.disconnect":
+                raise WebSocketDisconnect(code=frame.get("code", 1000))
+            binary_payload = frame.get("bytes")
+            if binary_payload is not None:
+                try:
+                    await container.session_service.host_midi_event_frame(connection_id, binary_payload)
+                except HTTPException as exc:
+                    await send_json({"type": "engine_error", "detail": _http_error_detail(exc.detail)})
+                except WebSocketDisconnect:
+                    raise
+                except Exception as exc:
+                    await send_json({"type": "engine_error", "detail": str(exc)})
+                continue
+
+            message = frame.get("text") or ""
             try:
                 payload = json.loads(message)
             except json.JSONDecodeError:
@@ -8,6 +8,11 @@ from typing import Literal
 from pydantic import Field, field_validator
 from pydantic_settings import BaseSettings, SettingsConfigDict
 
+from backend.app.engine.render_budget import (
+    DEFAULT_RENDER_BUDGET_OVERLOAD_LOAD,
+    DEFAULT_RENDER_BUDGET_WARNING_LOAD,
+    RenderBudgetPolicy,
+)
 from backend.app.services.persisted_json_limits import (
     DEFAULT_APP_STATE_MAX_BYTES,
     DEFAULT_PATCH_GRAPH_MAX_BYTES,
@@ -86,6 +91,8 @@ class Settings(BaseSettings):
     session_create_rate_burst: int = Field(default=10, gt=0)
     session_event_ws_max_subscriptions_total: int = Field(default=128, gt=0)
     session_event_ws_max_subscriptions_per_session: int = Field(default=8, gt=0)
+    session_event_ring_capacity: int = Field(default=256, gt=0)
+    session_event_sequencer_frame_ms: float = Field(default=0.0, ge=0.0, le=1000.0)
     session_event_ws_connect_rate_per_minute: float = Field(default=120.0, gt=0.0)
     session_event_ws_connect_rate_burst: int = Field(default=20, gt=0)
     session_idle_timeout_seconds: float = Field(default=30 * 60.0, gt=0.0)
@@ -93,6 +100,24 @@ class Settings(BaseSettings):
     browser_clock_manual_midi_max_future_ms: float = Field(default=2_000.0, gt=0.0)
     browser_clock_manual_midi_rate_per_second: float = Field(default=240.0, gt=0.0)
     browser_clock_manual_midi_burst: int = Field(default=480, gt=0)
+    browser_clock_midi_subblock_frames: int = Field(default=0, ge=0)
+    browser_clock_render_ahead_blocks: int = Field(default=0, ge=0)
+    midi_trace_capacity: int = Field(default=0, ge=0)
+    render_budget_warning_load: float = Field(default=DEFAULT_RENDER_BUDGET_WARNING_LOAD, gt=0.0)
+    render_budget_overload_load: float = Field(default=DEFAULT_RENDER_BUDGET_OVERLOAD_LOAD, gt=0.0)
+    render_budget_policies: list[RenderBudgetPolicy] = []
+    render_budget_voice_limit: int = Field(default=16, gt=0)
+    render_budget_reject_fraction: float = Field(default=0.5, gt=0.0, le=1.0)
+    render_executor_workers: int = Field(default=0, ge=0)
+    render_executor_pin_cpus: bool = False
+    render_executor_nice: int = Field(default=0, ge=-20, le=19)
+    render_executor_realtime_priority: int = Field(default=0, ge=0, le=99)
+    offline_render_workers: int = Field(default=0, ge=0)
+    offline_render_max_duration_seconds: float = Field(default=600.0, gt=0.0)
+    offline_render_timeout_seconds: float = Field(default=900.0, ge=0.0)
+    csound_pool_size: int = Field(default=0, ge=0)
+    compile_cache_max_entries: int = Field(default=512, ge=0)
+    compile_cache_dir: Path | None = None
 
     @field_validator("audio_output_mode", mode="before")
     @classmethod
@@ -3,6 +3,9 @@ from __future__ import annotations
 from dataclasses import dataclass
 
 from backend.app.core.config import Settings
+from backend.app.engine.csound_pool import CsoundInstancePool
+from backend.app.engine.offline_render import OfflineCsoundRenderer
+from backend.app.engine.render_executor import RenderExecutor
 from backend.app.services.compiler_service import CompilerService
 from backend.app.services.app_state_service import AppStateService
 from backend.app.services.event_bus import SessionEventBus
@@ -33,4 +36,7 @@ class AppContainer:
     compiler_service: CompilerService
     midi_service: MidiService
     event_bus: SessionEventBus
+    render_executor: RenderExecutor
+    csound_pool: CsoundInstancePool
+    offline_renderer: OfflineCsoundRenderer
     session_service: SessionService
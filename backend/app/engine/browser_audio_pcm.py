@@ -59,6 +59,25 @@ def resample_stereo_block_linear(block: Any, *, source_sample_rate: int, target_
     return np.stack([left, right], axis=1)
 
 
+def resample_stereo_block_nearest(block: Any, *, source_sample_rate: int, target_sample_rate: int) -> Any:
+    """Cheaper fallback to ``resample_stereo_block_linear`` that picks the nearest source frame."""
+
+    import numpy as np  # type: ignore
+
+    in_samples = int(block.shape[0])
+    if in_samples == 0:
+        return block
+    if in_samples == 1 or source_sample_rate == target_sample_rate:
+        return np.ascontiguousarray(block, dtype=np.float32)
+
+    out_samples = max(1, int(round(in_samples * (target_sample_rate / source_sample_rate))))
+    if out_samples == in_samples:
+        return np.ascontiguousarray(block, dtype=np.float32)
+
+    indices = np.rint(np.linspace(0.0, float(in_samples - 1), num=out_samples, endpoint=True)).astype(np.intp)
+    return np.ascontiguousarray(block[indices], dtype=np.float32)
+
+
 def csound_spout_to_pcm_block(
     spout: Any,
     *,
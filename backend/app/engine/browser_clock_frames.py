@@ -0,0 +1,165 @@
+from __future__ import annotations
+
+import json
+import math
+import struct
+from typing import Any
+
+from pydantic import BaseModel
+
+from backend.app.engine.lossless_pcm import encode_pcm_rice24
+
+RENDER_CHUNK_FRAME_MAGIC = b"OCRC"
+RENDER_CHUNK_FRAME_VERSION = 1
+RENDER_CHUNK_FLAG_STATUS_DELTA = 0x01
+
+# Little-endian, no padding: magic, version, pcm encoding, channels, flags, chunk sequence, block count,
+# engine sample start/end, engine/target sample rate, target frame count, transport subunit, compact telemetry
+# (render service time, websocket wait, note-on to render complete, NaN when unknown) and trailing JSON length.
+RENDER_CHUNK_HEADER = struct.Struct("<4sBBBBIIQQIIIQfffI")
+
+# The browser divides by the same constant, so full scale round-trips exactly.
+S16_FULL_SCALE = 32767
+
+# List fields whose entries are diffed individually by their id field. Only changed entries are resent while the
+# ids and their order stay the same; otherwise the whole list goes out as a regular changed field.
+STATUS_DELTA_KEYED_LISTS = {
+    "tracks": "track_id",
+    "controller_tracks": "track_id",
+    "arpeggiators": "arpeggiator_id",
+}
+
+PCM_ENCODING_CODES = {
+    "f32le": 0,
+    "s16le": 1,
+    "rice24": 2,
+}
+
+
+def encode_pcm_s16le_dithered(pcm_f32le: bytes, *, rng: Any | None = None) -> bytes:
+    """Converts interleaved float32 PCM to int16 with TPDF dither of one LSB peak."""
+    import numpy as np  # type: ignore
+
+    samples = np.frombuffer(pcm_f32le, dtype=np.float32)
+    if samples.size == 0:
+        return b""
+    generator = rng if rng is not None else np.random.default_rng()
+    dither = generator.random(samples.size, dtype=np.float32) - generator.random(samples.size, dtype=np.float32)
+    scaled = samples * np.float32(S16_FULL_SCALE) + dither
+    return np.clip(np.rint(scaled), -32768, 32767).astype("<i2").tobytes()
+
+
+class BrowserClockRenderChunkEncoder:
+    """Per-connection encoder for the negotiated binary ``render_chunk`` frame.
+
+    Sequencer status is diffed against the last status sent on this connection and only changed fields are
+    serialized; ``transport_subunit`` travels in the fixed header instead. Track and arpeggiator lists are diffed
+    per entry, and changed entries go out under ``sequencer_status_entries`` keyed by list name.
+    """
+
+    def __init__(self, *, pcm_encoding: str = "f32le") -> None:
+        import numpy as np  # type: ignore
+
+        if pcm_encoding not in PCM_ENCODING_CODES:
+            raise ValueError(f"Unsupported browser-clock PCM encoding: {pcm_encoding!r}")
+        self._pcm_encoding = pcm_encoding
+        self._sequence = 0
+        self._last_status_fields: dict[str, Any] | None = None
+        self._rng = np.random.default_rng()
+
+    @property
+    def pcm_encoding(self) -> str:
+        return self._pcm_encoding
+
+    def encode(
+        self,
+        *,
+        engine_sample_start: int,
+        engine_sample_end: int,
+        engine_sample_rate: int,
+        target_sample_rate: int,
+        target_frame_count: int,
+        block_count: int,
+        channels: int,
+        pcm_f32le: bytes,
+        sequencer_status: BaseModel,
+        telemetry: dict[str, Any],
+    ) -> bytes:
+        status_delta, entry_updates = self._status_delta(sequencer_status)
+        flags = 0
+        json_bytes = b""
+        if status_delta or entry_updates:
+            flags |= RENDER_CHUNK_FLAG_STATUS_DELTA
+            payload: dict[str, Any] = {"sequencer_status": status_delta}
+            if entry_updates:
+                payload["sequencer_status_entries"] = entry_updates
+            json_bytes = json.dumps(payload, separators=(",", ":")).encode("utf-8")
+            # Keep the PCM payload 4-byte aligned so the browser can view it without copying.
+            json_bytes += b" " * (-len(json_bytes) % 4)
+
+        if self._pcm_encoding == "s16le":
+            pcm = encode_pcm_s16le_dithered(pcm_f32le, rng=self._rng)
+        elif self._pcm_encoding == "rice24":
+            pcm = encode_pcm_rice24(pcm_f32le, channels=channels)
+        else:
+            pcm = pcm_f32le
+
+        sequence = self._sequence
+        self._sequence = (self._sequence + 1) & 0xFFFFFFFF
+        header = RENDER_CHUNK_HEADER.pack(
+            RENDER_CHUNK_FRAME_MAGIC,
+            RENDER_CHUNK_FRAME_VERSION,
+            PCM_ENCODING_CODES[self._pcm_encoding],
+            channels,
+            flags,
+            sequence,
+            block_count,
+            engine_sample_start,
+            engine_sample_end,
+            engine_sample_rate,
+            target_sample_rate,
+            target_frame_count,
+            int(getattr(sequencer_status, "transport_subunit", 0)),
+            _telemetry_float(telemetry.get("render_service_time_ms")),
+            _telemetry_float(telemetry.get("websocket_message_wait_ms")),
+            _telemetry_float(telemetry.get("note_on_to_render_complete_ms")),
+            len(json_bytes),
+        )
+        return b"".join((header, json_bytes, pcm))
+
+    def _status_delta(self, status: BaseModel) -> tuple[dict[str, Any], dict[str, list[dict[str, Any]]]]:
+        fields = {name: value for name, value in status.__dict__.items() if name != "transport_subunit"}
+        previous = self._last_status_fields
+        self._last_status_fields = fields
+        if previous is None:
+            return status.model_dump(mode="json", include=set(fields)), {}
+
+        changed: set[str] = set()
+        entry_updates: dict[str, list[dict[str, Any]]] = {}
+        for name, value in fields.items():
+            previous_value = previous.get(name)
+            if previous_value == value:
+                continue
+            id_field = STATUS_DELTA_KEYED_LISTS.get(name)
+            if id_field is None or _entry_ids(value, id_field) != _entry_ids(previous_value, id_field):
+                changed.add(name)
+                continue
+            entry_updates[name] = [
+                entry.model_dump(mode="json")
+                for entry, previous_entry in zip(value, previous_value)
+                if entry != previous_entry
+            ]
+        status_delta = status.model_dump(mode="json", include=changed) if changed else {}
+        return status_delta, entry_updates
+
+
+def _entry_ids(entries: Any, id_field: str) -> list[Any] | None:
+    if not isinstance(entries, list):
+        return None
+    return [getattr(entry, id_field, None) for entry in entries]
+
+
+def _telemetry_float(value: object) -> float:
+    if isinstance(value, (int, float)) and math.isfinite(value):
+        return float(value)
+    return math.nan
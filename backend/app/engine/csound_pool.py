@@ -0,0 +1,175 @@
+from __future__ import annotations
+
+from collections import deque
+from dataclasses import dataclass
+import logging
+import math
+import os
+import threading
+from typing import Any
+
+from backend.app.engine.ctcsound_loader import load_ctcsound_module
+
+logger = logging.getLogger(__name__)
+
+START_LATENCY_SAMPLE_CAPACITY = 1024
+
+
+@dataclass(slots=True)
+class CsoundPoolStats:
+    target_size: int
+    idle_instances: int
+    warm_acquires: int
+    cold_acquires: int
+    rtmidi_modules: dict[str, str]
+    start_count: int
+    start_latency_p50_ms: float | None
+    start_latency_p99_ms: float | None
+    start_latency_max_ms: float | None
+
+
+class CsoundInstancePool:
+    """Keeps constructed, pre-configured idle ``Csound`` instances for fast session starts.
+
+    Instances are single-use. A started session owns its instance until teardown, and a background thread
+    builds replacements. Only session-independent options (``-d``, ``-n``, ``SSDIR``) are applied ahead of
+    time. Buffer sizes, MIDI flags and host MIDI callbacks depend on the session and are set after
+    ``acquire``. The pool also remembers which rtmidi module last started for each requested module, so
+    later starts skip modules that are known to fail.
+    """
+
+    def __init__(
+        self,
+        *,
+        size: int = 0,
+        gen_audio_assets_dir: str | None = None,
+        ctcsound_module: Any | None = None,
+    ) -> None:
+        self._size = max(0, int(size))
+        self._gen_audio_assets_dir = os.path.abspath(gen_audio_assets_dir) if gen_audio_assets_dir else None
+        self._ctcsound = ctcsound_module
+        self._idle: deque[Any] = deque()
+        self._condition = threading.Condition()
+        self._closed = False
+        self._thread: threading.Thread | None = None
+        self._warm_acquires = 0
+        self._cold_acquires = 0
+        self._rtmidi_modules: dict[str, str] = {}
+        self._start_latencies_ns: deque[int] = deque(maxlen=START_LATENCY_SAMPLE_CAPACITY)
+        self._start_count = 0
+
+    @property
+    def size(self) -> int:
+        return self._size
+
+    def start(self) -> None:
+        """Resolves ctcsound and starts the refill thread. A mock engine or missing ctcsound leaves the pool empty."""
+
+        if self._size <= 0 or self._thread is not None:
+            return
+        if self._ctcsound is None:
+            force_mock = os.getenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "").strip().lower()
+            if force_mock in {"1", "true", "yes", "on"}:
+                return
+            try:
+                self._ctcsound = load_ctcsound_module()
+            except Exception as exc:
+                logger.info("Csound instance pool disabled; ctcsound not available: %s", exc)
+                return
+        self._thread = threading.Thread(target=self._refill_loop, name="csound-pool", daemon=True)
+        self._thread.start()
+
+    def acquire(self) -> Any | None:
+        """Returns a warm instance, or ``None`` when the pool is empty so the caller builds its own."""
+
+        with self._condition:
+            if self._idle:
+                self._warm_acquires += 1
+                instance = self._idle.popleft()
+                self._condition.notify_all()
+                return instance
+            self._cold_acquires += 1
+            self._condition.notify_all()
+            return None
+
+    def prepare_instance(self, csound: Any) -> Any:
+        csound.setOption("-d")
+        csound.setOption("-n")
+        if self._gen_audio_assets_dir:
+            csound.setOption(f"--env:SSDIR={self._gen_audio_assets_dir}")
+        return csound
+
+    def ordered_rtmidi_candidates(self, requested_module: str, candidates: list[str]) -> list[str]:
+        with self._condition:
+            known = self._rtmidi_modules.get(requested_module)
+        if known is None or known not in candidates:
+            return candidates
+        return [known, *[candidate for candidate in candidates if candidate != known]]
+
+    def record_start(self, *, requested_module: str, module: str, elapsed_ns: int) -> None:
+        with self._condition:
+            self._rtmidi_modules[requested_module] = module
+            self._start_latencies_ns.append(max(0, int(elapsed_ns)))
+            self._start_count += 1
+
+    def stats(self) -> CsoundPoolStats:
+        with self._condition:
+            latencies = sorted(self._start_latencies_ns)
+            return CsoundPoolStats(
+                target_size=self._size if self._thread is not None else 0,
+                idle_instances=len(self._idle),
+                warm_acquires=self._warm_acquires,
+                cold_acquires=self._cold_acquires,
+                rtmidi_modules=dict(self._rtmidi_modules),
+                start_count=self._start_count,
+                start_latency_p50_ms=_percentile_ms(latencies, 0.50),
+                start_latency_p99_ms=_percentile_ms(latencies, 0.99),
+                start_latency_max_ms=(latencies[-1] / 1_000_000.0) if latencies else None,
+            )
+
+    def close(self) -> None:
+        with self._condition:
+            self._closed = True
+            idle = list(self._idle)
+            self._idle.clear()
+            self._condition.notify_all()
+        if self._thread is not None:
+            self._thread.join(timeout=5.0)
+            self._thread = None
+        for instance in idle:
+            _teardown_idle_instance(instance)
+
+    def _refill_loop(self) -> None:
+        while True:
+            with self._condition:
+                while not self._closed and len(self._idle) >= self._size:
+                    self._condition.wait()
+                if self._closed:
+                    return
+            try:
+                instance = self.prepare_instance(self._ctcsound.Csound())
+            except Exception:
+                logger.exception("Failed to pre-initialize a pooled Csound instance; pool refill stopped")
+                return
+            with self._condition:
+                if self._closed:
+                    _teardown_idle_instance(instance)
+                    return
+                self._idle.append(instance)
+
+
+def _percentile_ms(sorted_ns: list[int], fraction: float) -> float | None:
+    if not sorted_ns:
+        return None
+    index = min(len(sorted_ns) - 1, max(0, math.ceil(fraction * len(sorted_ns)) - 1))
+    return sorted_ns[index] / 1_000_000.0
+
+
+def _teardown_idle_instance(instance: Any) -> None:
+    for method_name in ("cleanup", "reset"):
+        method = getattr(instance, method_name, None)
+        if callable(method):
+            try:
+                method()
+            except Exception:
+                pass
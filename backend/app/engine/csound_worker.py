@@ -9,20 +9,28 @@ import sys
 import threading
 import time
 from dataclasses import dataclass
-from typing import Any, Callable
+from typing import Any, Callable, Literal
 
 from backend.app.engine.browser_audio_pcm import (
     DEFAULT_BROWSER_AUDIO_SAMPLE_RATE,
     normalize_csound_spout_to_stereo,
     resample_stereo_block_linear,
+    resample_stereo_block_nearest,
 )
+from backend.app.engine.csound_pool import CsoundInstancePool
 from backend.app.engine.ctcsound_loader import load_ctcsound_module
-from backend.app.engine.midi_scheduler import EngineMidiOutputAdapter, EngineMidiScheduler
+from backend.app.engine.midi_scheduler import EngineMidiOutputAdapter, EngineMidiScheduler, ScheduledMidiInput
+from backend.app.engine.midi_trace import MidiTraceBuffer
+from backend.app.engine.render_budget import RenderBudgetMonitor
+from backend.app.engine.render_metrics import RenderLoopMetrics
 
 logger = logging.getLogger(__name__)
 
 DEFAULT_CSOUND_SOFTWARE_BUFFER_SAMPLES = 128
 DEFAULT_CSOUND_HARDWARE_BUFFER_SAMPLES = 512
+MAX_DEGRADED_KSMPS_SCALE = 4
+
+ResamplerTier = Literal["linear", "nearest"]
 
 
 @dataclass(slots=True)
@@ -44,13 +52,27 @@ class EngineRenderResult:
     pcm_f32le: bytes
 
 
+@dataclass(slots=True)
+class EngineBlockRender:
+    engine_sample_start: int
+    engine_sample_end: int
+    engine_sample_rate: int
+    block_count: int
+    frames: Any
+
+
 class CsoundWorker:
     def __init__(
         self,
         *,
         gen_audio_assets_dir: str | None = None,
+        midi_subblock_frames: int = 0,
+        instance_pool: CsoundInstancePool | None = None,
+        midi_trace_capacity: int = 0,
+        render_budget: RenderBudgetMonitor | None = None,
     ) -> None:
         self._backend = "mock"
+        self._instance_pool = instance_pool
         self._audio_output_mode = self._resolve_audio_output_mode(
             os.getenv("VISUALCSOUND_AUDIO_OUTPUT_MODE", "browser_clock")
         )
@@ -64,12 +86,23 @@ class CsoundWorker:
         self._runtime_sr = 0
         self._runtime_nchnls = 0
         self._runtime_ksmps = 0
+        # Csound's own k-period. Equals _runtime_ksmps unless MIDI sub-block delivery splits each render
+        # block into several shorter k-cycles so scheduled MIDI lands closer to its target sample.
+        self._engine_ksmps = 0
+        self._midi_subblock_frames = max(0, int(midi_subblock_frames))
         self._render_sample_cursor = 0
         self._host_midi_enabled = False
         self._host_midi_buffer = bytearray()
         self._host_midi_lock = threading.Lock()
         self._host_midi_callbacks: dict[str, Any] = {}
-        self._midi_scheduler = EngineMidiScheduler()
+        self._midi_trace = MidiTraceBuffer(midi_trace_capacity) if midi_trace_capacity > 0 else None
+        self._midi_scheduler = EngineMidiScheduler(trace=self._midi_trace)
+        self._render_metrics = RenderLoopMetrics()
+        self._render_budget = render_budget or RenderBudgetMonitor()
+        # Degradations applied by the render budget watchdog. They last for the lifetime of the worker;
+        # the ksmps scale only takes effect on the next start.
+        self._ksmps_scale = 1
+        self._resampler: ResamplerTier = "linear"
         self._midi_output = EngineMidiOutputAdapter(
             enqueue_message=self.queue_midi_message,
             output_name="engine:internal",
@@ -127,6 +160,10 @@ class CsoundWorker:
     def render_sample_cursor(self) -> int:
         return self._render_sample_cursor
 
+    @property
+    def supports_hot_swap(self) -> bool:
+        return self._backend == "ctcsound" and self._csound is not None and self._running
+
     @property
     def accepts_direct_midi(self) -> bool:
         return self._backend == "ctcsound" and self._host_midi_enabled and self._running
@@ -139,6 +176,36 @@ class CsoundWorker:
     def midi_overflow_count(self) -> int:
         return self._midi_scheduler.overflow_count
 
+    @property
+    def midi_trace(self) -> MidiTraceBuffer | None:
+        return self._midi_trace
+
+    @property
+    def render_metrics(self) -> RenderLoopMetrics:
+        return self._render_metrics
+
+    @property
+    def render_budget(self) -> RenderBudgetMonitor:
+        return self._render_budget
+
+    @property
+    def ksmps_scale(self) -> int:
+        return self._ksmps_scale
+
+    @property
+    def resampler(self) -> ResamplerTier:
+        return self._resampler
+
+    def scale_ksmps_on_restart(self) -> int:
+        """Doubles the orchestra ksmps used by the next start, up to ``MAX_DEGRADED_KSMPS_SCALE``."""
+
+        with self._lock:
+            self._ksmps_scale = min(MAX_DEGRADED_KSMPS_SCALE, self._ksmps_scale * 2)
+            return self._ksmps_scale
+
+    def use_resampler(self, tier: ResamplerTier) -> None:
+        self._resampler = tier
+
     def start(self, csd: str, midi_input: str, rtmidi_module: str) -> EngineStartResult:
         with self._lock:
             if self._running:
@@ -198,6 +265,7 @@ class CsoundWorker:
         source_timestamp_ns: int | None = None,
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> bool:
         if len(message) != 3:
             return False
@@ -213,6 +281,7 @@ class CsoundWorker:
                 mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
                 late=target_engine_sample < current_engine_sample,
                 sync_stale=sync_stale,
+                received_ns=received_ns,
             )
             return success
         success, _ = self._midi_scheduler.enqueue_after_delay(
@@ -222,9 +291,17 @@ class CsoundWorker:
             current_engine_sample=current_engine_sample,
             source_timestamp_ns=source_timestamp_ns,
             mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
+            received_ns=received_ns,
         )
         return success
 
+    def enqueue_timestamped_midi_batch(self, inputs: list[ScheduledMidiInput], *, source: str) -> int:
+        if not inputs:
+            return 0
+        with self._lock:
+            current_engine_sample = self._render_sample_cursor
+        return self._midi_scheduler.enqueue_many(inputs, source=source, current_engine_sample=current_engine_sample)
+
     def panic(self) -> str:
         with self._lock:
             if self._backend == "ctcsound" and self._csound is not None:
@@ -238,21 +315,67 @@ class CsoundWorker:
 
             return "panic ignored (mock backend)"
 
+    def hot_swap_orchestra(self, orc: str, *, score_lines: tuple[str, ...] = ()) -> str:
+        """Compiles replacement instrument definitions into the running engine.
+
+        Holding the render lock places the swap between ``performKsmps`` calls, so the render cursor,
+        MIDI scheduler and browser clock sync carry on without a restart.
+        """
+
+        with self._render_lock:
+            with self._lock:
+                if not self._running:
+                    raise RuntimeError("Session must be running to hot-swap instruments.")
+                if self._backend != "ctcsound" or self._csound is None:
+                    return "hot swap ignored (mock backend)"
+                compile_result = self._csound.compileOrc(orc)
+                if compile_result != 0:
+                    raise RuntimeError(f"CSound orchestra hot-swap failed with code {compile_result}")
+                for line in score_lines:
+                    self._csound.inputMessage(line)
+                return "instruments hot-swapped"
+
+    def limit_instrument_voices(self, instrument_refs: list[str], max_voices: int) -> str:
+        """Caps simultaneous instances of each instrument, numbered or named, with Csound ``maxalloc``."""
+
+        voices = max(1, int(max_voices))
+        lines: list[str] = []
+        for ref in sorted(set(instrument_refs)):
+            insnum = ref if ref.isdigit() else f'"{ref}"'
+            lines.append(f"maxalloc {insnum}, {voices}")
+        orc = "\n".join(lines)
+        if not orc:
+            return "no instruments to limit"
+        with self._render_lock:
+            with self._lock:
+                if not self._running:
+                    raise RuntimeError("Session must be running to limit instrument voices.")
+                if self._backend != "ctcsound" or self._csound is None:
+                    return "voice limit ignored (mock backend)"
+                compile_result = self._csound.compileOrc(orc)
+                if compile_result != 0:
+                    raise RuntimeError(f"CSound maxalloc failed with code {compile_result}")
+                return f"instruments limited to {voices} voices"
+
     def _start_ctcsound(self, csd: str, midi_input: str, rtmidi_module: str) -> EngineStartResult:
         return self._start_ctcsound_browser_clock(csd, midi_input, rtmidi_module)
 
     def _start_ctcsound_browser_clock(self, csd: str, midi_input: str, rtmidi_module: str) -> EngineStartResult:
         assert self._ctcsound is not None
 
+        started_ns = time.perf_counter_ns()
         requested_module = self._normalize_rtmidi_module(rtmidi_module)
         if sys.platform == "darwin":
             requested_module = "coremidi"
         attempts: list[str] = []
         errors: list[str] = []
+        candidates = self._headless_rtmidi_candidates(requested_module)
+        if self._instance_pool is not None:
+            candidates = self._instance_pool.ordered_rtmidi_candidates(requested_module, candidates)
 
-        for module in self._headless_rtmidi_candidates(requested_module):
+        for module in candidates:
             attempts.append(module)
-            csound = self._ctcsound.Csound()
+            csound = self._new_csound_instance()
             try:
                 software_buffer, hardware_buffer = self._extract_runtime_buffer_sizes(csd)
                 runtime_csd = self._apply_headless_runtime_options(
@@ -260,14 +383,12 @@ class CsoundWorker:
                     midi_input=midi_input,
                     rtmidi_module=module,
                 )
+                runtime_csd, block_ksmps = self._apply_runtime_ksmps(runtime_csd)
 
-                csound.setOption("-d")
-                csound.setOption("-n")
                 csound.setOption(f"-b{software_buffer}")
                 csound.setOption(f"-B{hardware_buffer}")
                 csound.setOption(f"-M{midi_input}")
                 csound.setOption(f"-+rtmidi={module}")
-                self._apply_gen_audio_search_dir_option(csound)
                 self._configure_host_midi_callbacks(csound)
 
                 compile_result = csound.compileCsdText(runtime_csd)
@@ -280,7 +401,10 @@ class CsoundWorker:
 
                 source_sr = self._resolve_runtime_sr(csound, runtime_csd)
                 source_nchnls = self._resolve_runtime_nchnls(csound, runtime_csd)
-                source_ksmps = self._resolve_runtime_ksmps(csound, runtime_csd)
+                engine_ksmps = self._resolve_runtime_ksmps(csound, runtime_csd)
+                source_ksmps = engine_ksmps
+                if block_ksmps is not None and block_ksmps > engine_ksmps and block_ksmps % engine_ksmps == 0:
+                    source_ksmps = block_ksmps
             except Exception as exc:
                 errors.append(f"{module}: {exc}")
                 self._teardown_csound(csound)
@@ -291,11 +415,18 @@ class CsoundWorker:
             self._runtime_sr = source_sr
             self._runtime_nchnls = source_nchnls
             self._runtime_ksmps = source_ksmps
+            self._engine_ksmps = engine_ksmps
             self._render_sample_cursor = 0
             self._host_midi_enabled = True
             self._thread = None
             self._midi_scheduler.reset()
             self._midi_scheduler.set_engine_sample_rate(source_sr)
+            if self._instance_pool is not None:
+                self._instance_pool.record_start(
+                    requested_module=requested_module,
+                    module=module,
+                    elapsed_ns=time.perf_counter_ns() - started_ns,
+                )
 
             if module != requested_module:
                 logger.warning(
@@ -326,21 +457,46 @@ class CsoundWorker:
         target_sample_rate: int,
         before_block: Callable[..., None] | None = None,
     ) -> EngineRenderResult:
-        requested_blocks = max(1, int(block_count))
         if target_sample_rate < 1:
             raise ValueError("target_sample_rate must be >= 1.")
+        rendered = self.render_engine_blocks(block_count=block_count, before_block=before_block)
+        encode_started_ns = time.perf_counter_ns()
+        encoded = self.encode_engine_blocks(
+            rendered,
+            target_sample_rate=target_sample_rate,
+            resampler=self._resampler,
+        )
+        self._render_metrics.encode.observe((time.perf_counter_ns() - encode_started_ns) * 1e-9)
+        return encoded
+
+    def render_engine_blocks(
+        self,
+        *,
+        block_count: int,
+        before_block: Callable[..., None] | None = None,
+        observe_budget: bool = True,
+    ) -> EngineBlockRender:
+        """Renders ``block_count`` engine blocks at the engine rate.
+
+        Callers that render one block at a time ahead of demand pass ``observe_budget=False`` and report the
+        summed wall time per delivered batch instead, so a single slow block does not swing the budget state.
+        """
+        requested_blocks = max(1, int(block_count))
         if self._audio_output_mode != "browser_clock":
             raise ValueError("Render requests are only available in browser_clock mode.")
         if not self.is_running:
             raise RuntimeError("Session must be running before rendering browser-clock audio.")
 
         with self._render_lock:
+            render_started_ns = time.perf_counter_ns()
             if self._backend != "ctcsound" or self._csound is None:
-                return self._render_mock_blocks(
+                rendered = self._render_mock_blocks(
                     block_count=requested_blocks,
-                    target_sample_rate=target_sample_rate,
                     before_block=before_block,
                 )
+                if observe_budget:
+                    self._observe_render_budget(rendered, render_started_ns=render_started_ns)
+                return rendered
 
             with self._lock:
                 if not self._running or self._csound is None:
@@ -349,6 +505,7 @@ class CsoundWorker:
                 source_sr = self._runtime_sr
                 source_nchnls = self._runtime_nchnls
                 source_ksmps = self._runtime_ksmps
+                engine_ksmps = self._engine_ksmps or source_ksmps
                 sample_start = self._render_sample_cursor
 
             import numpy as np  # type: ignore
@@ -356,30 +513,49 @@ class CsoundWorker:
             rendered_blocks: list[Any] = []
             source_frames_rendered = 0
             before_block_arity = self._callback_arity(before_block)
+            trace = self._midi_trace
+            metrics = self._render_metrics
             for block_index in range(requested_blocks):
                 block_start_sample = sample_start + source_frames_rendered
                 block_end_sample = block_start_sample + source_ksmps
+                block_started_ns = time.perf_counter_ns()
                 if before_block is not None:
                     if before_block_arity >= 2:
                         before_block(block_index, block_start_sample)
                     else:
                         before_block(block_index)
-                self._prepare_host_midi_block(
-                    block_start_sample=block_start_sample,
-                    block_end_sample=block_end_sample,
-                )
-
-                result = csound.performKsmps()
-                if result != 0:
-                    with self._lock:
-                        self._running = False
-                    raise RuntimeError(f"CSound performKsmps exited with status {result}")
-
-                block = normalize_csound_spout_to_stereo(
-                    csound.spout(),
-                    source_channels=source_nchnls,
-                )
-                rendered_blocks.append(block)
+                    metrics.before_block.observe((time.perf_counter_ns() - block_started_ns) * 1e-9)
+
+                # Events produced by before_block stay in the scheduler until the k-cycle that contains
+                # their target sample, so sub-block delivery only needs shorter drain windows.
+                midi_event_count = 0
+                for subblock_start_sample in range(block_start_sample, block_end_sample, engine_ksmps):
+                    midi_event_count += self._prepare_host_midi_block(
+                        block_start_sample=subblock_start_sample,
+                        block_end_sample=min(block_end_sample, subblock_start_sample + engine_ksmps),
+                    )
+
+                    perform_started_ns = time.perf_counter_ns()
+                    result = csound.performKsmps()
+                    metrics.perform_ksmps.observe((time.perf_counter_ns() - perform_started_ns) * 1e-9)
+                    if result != 0:
+                        with self._lock:
+                            self._running = False
+                        raise RuntimeError(f"CSound performKsmps exited with status {result}")
+
+                    block = normalize_csound_spout_to_stereo(
+                        csound.spout(),
+                        source_channels=source_nchnls,
+                    )
+                    rendered_blocks.append(block)
+                metrics.midi_events_per_block.observe(midi_event_count)
+                if trace is not None:
+                    trace.record_block(
+                        engine_sample_start=block_start_sample,
+                        engine_sample_end=block_end_sample,
+                        started_ns=block_started_ns,
+                        finished_ns=time.perf_counter_ns(),
+                    )
                 source_frames_rendered += source_ksmps
 
             if rendered_blocks:
@@ -387,36 +563,64 @@ class CsoundWorker:
             else:
                 merged = np.zeros((0, 2), dtype=np.float32)
 
-            if source_sr != target_sample_rate:
-                merged = resample_stereo_block_linear(
-                    merged,
-                    source_sample_rate=source_sr,
-                    target_sample_rate=target_sample_rate,
-                )
-
-            pcm = np.ascontiguousarray(merged.astype(np.float32, copy=False))
             with self._lock:
                 self._render_sample_cursor += source_frames_rendered
                 sample_end = self._render_sample_cursor
 
-            return EngineRenderResult(
+            rendered = EngineBlockRender(
                 engine_sample_start=sample_start,
                 engine_sample_end=sample_end,
                 engine_sample_rate=source_sr,
-                target_sample_rate=target_sample_rate,
-                channels=2,
                 block_count=requested_blocks,
-                target_frame_count=int(pcm.shape[0]),
-                pcm_f32le=pcm.tobytes(),
+                frames=merged,
+            )
+            if observe_budget:
+                self._observe_render_budget(rendered, render_started_ns=render_started_ns)
+            return rendered
+
+    def _observe_render_budget(self, rendered: EngineBlockRender, *, render_started_ns: int) -> None:
+        self._render_budget.observe(
+            wall_ns=time.perf_counter_ns() - render_started_ns,
+            frames=rendered.engine_sample_end - rendered.engine_sample_start,
+            sample_rate=rendered.engine_sample_rate,
+        )
+
+    @staticmethod
+    def encode_engine_blocks(
+        rendered: EngineBlockRender,
+        *,
+        target_sample_rate: int,
+        resampler: ResamplerTier = "linear",
+    ) -> EngineRenderResult:
+        import numpy as np  # type: ignore
+
+        merged = rendered.frames
+        if rendered.engine_sample_rate != target_sample_rate:
+            resample = resample_stereo_block_nearest if resampler == "nearest" else resample_stereo_block_linear
+            merged = resample(
+                merged,
+                source_sample_rate=rendered.engine_sample_rate,
+                target_sample_rate=target_sample_rate,
             )
 
+        pcm = np.ascontiguousarray(merged.astype(np.float32, copy=False))
+        return EngineRenderResult(
+            engine_sample_start=rendered.engine_sample_start,
+            engine_sample_end=rendered.engine_sample_end,
+            engine_sample_rate=rendered.engine_sample_rate,
+            target_sample_rate=target_sample_rate,
+            channels=2,
+            block_count=rendered.block_count,
+            target_frame_count=int(pcm.shape[0]),
+            pcm_f32le=pcm.tobytes(),
+        )
+
     def _render_mock_blocks(
         self,
         *,
         block_count: int,
-        target_sample_rate: int,
         before_block: Callable[..., None] | None = None,
-    ) -> EngineRenderResult:
+    ) -> EngineBlockRender:
         import numpy as np  # type: ignore
 
         source_sr = self._runtime_sr if self._runtime_sr > 0 else DEFAULT_BROWSER_AUDIO_SAMPLE_RATE
@@ -426,29 +630,35 @@ class CsoundWorker:
         for block_index in range(block_count):
             if before_block is not None:
                 block_start_sample = sample_start + (block_index * source_ksmps)
+                before_started_ns = time.perf_counter_ns()
                 if before_block_arity >= 2:
                     before_block(block_index, block_start_sample)
                 else:
                     before_block(block_index)
+                self._render_metrics.before_block.observe((time.perf_counter_ns() - before_started_ns) * 1e-9)
         sample_end = sample_start + (block_count * source_ksmps)
         self._render_sample_cursor = sample_end
-        target_frames = max(1, int(round((block_count * source_ksmps) * (target_sample_rate / source_sr))))
-        pcm = np.zeros((target_frames, 2), dtype=np.float32)
-        return EngineRenderResult(
+        if self._midi_trace is not None:
+            rendered_ns = time.perf_counter_ns()
+            self._midi_trace.record_block(
+                engine_sample_start=sample_start,
+                engine_sample_end=sample_end,
+                started_ns=rendered_ns,
+                finished_ns=rendered_ns,
+            )
+        return EngineBlockRender(
             engine_sample_start=sample_start,
             engine_sample_end=sample_end,
             engine_sample_rate=source_sr,
-            target_sample_rate=target_sample_rate,
-            channels=2,
             block_count=block_count,
-            target_frame_count=target_frames,
-            pcm_f32le=pcm.tobytes(),
+            frames=np.zeros((sample_end - sample_start, 2), dtype=np.float32),
         )
 
     def _stop_ctcsound(self) -> None:
         self._runtime_sr = 0
         self._runtime_nchnls = 0
         self._runtime_ksmps = 0
+        self._engine_ksmps = 0
         self._render_sample_cursor = 0
         self._host_midi_enabled = False
         self._host_midi_callbacks = {}
@@ -467,6 +677,18 @@ class CsoundWorker:
             self._csound = None
             self._thread = None
 
+    def _new_csound_instance(self) -> Any:
+        assert self._ctcsound is not None
+        if self._instance_pool is not None:
+            pooled = self._instance_pool.acquire()
+            if pooled is not None:
+                return pooled
+        csound = self._ctcsound.Csound()
+        csound.setOption("-d")
+        csound.setOption("-n")
+        self._apply_gen_audio_search_dir_option(csound)
+        return csound
+
     def _apply_gen_audio_search_dir_option(self, csound: Any) -> None:
         if not self._gen_audio_assets_dir:
             return
@@ -562,7 +784,7 @@ class CsoundWorker:
         ct.libcsound.csoundSetExternalMidiWriteCallback.argtypes = [ctypes.c_void_p, raw_midi_write_func]
         ct.libcsound.csoundSetExternalMidiWriteCallback(csound.cs, callbacks["write"])
 
-    def _prepare_host_midi_block(self, *, block_start_sample: int, block_end_sample: int) -> None:
+    def _prepare_host_midi_block(self, *, block_start_sample: int, block_end_sample: int) -> int:
         events = self._midi_scheduler.drain_block(
             block_start_sample=block_start_sample,
             block_end_sample=block_end_sample,
@@ -571,6 +793,7 @@ class CsoundWorker:
             self._host_midi_buffer.clear()
             for event in events:
                 self._host_midi_buffer.extend(event.message)
+        return len(events)
 
     @staticmethod
     def _callback_arity(callback: Callable[..., None] | None) -> int:
@@ -829,6 +1052,54 @@ class CsoundWorker:
             return parsed
         return 32
 
+    def _apply_runtime_ksmps(self, csd: str) -> tuple[str, int | None]:
+        """Rewrites the orchestra ksmps for the ksmps degradation and the MIDI sub-block.
+
+        Returns the rewritten CSD and the render block size. The sub-block limit scales with the
+        degradation, otherwise the sub-block rewrite would bring the engine back to the undegraded
+        k-cycle size.
+        """
+        block_ksmps = self._extract_orchestra_numeric_scalar(csd, "ksmps")
+        if block_ksmps is None:
+            return csd, None
+        if self._ksmps_scale > 1:
+            block_ksmps *= self._ksmps_scale
+            csd = self._rewrite_orchestra_ksmps(csd, block_ksmps)
+        subblock_ksmps = self._resolve_midi_subblock_ksmps(
+            block_ksmps,
+            self._midi_subblock_frames * self._ksmps_scale,
+        )
+        if subblock_ksmps != block_ksmps:
+            csd = self._rewrite_orchestra_ksmps(csd, subblock_ksmps)
+        return csd, block_ksmps
+
+    @staticmethod
+    def _resolve_midi_subblock_ksmps(block_ksmps: int | None, max_subblock_frames: int) -> int | None:
+        if block_ksmps is None or block_ksmps < 1 or max_subblock_frames < 1 or max_subblock_frames >= block_ksmps:
+            return block_ksmps
+        if max_subblock_frames == 1:
+            return 1
+        for candidate in range(max_subblock_frames, 1, -1):
+            if block_ksmps % candidate == 0:
+                return candidate
+        # Only ksmps=1 would divide the block; running the engine per sample is too costly for real time.
+        logger.warning(
+            "ksmps %d has no divisor between 2 and %d; MIDI stays quantized to the full block. "
+            "Set VISUALCSOUND_BROWSER_CLOCK_MIDI_SUBBLOCK_FRAMES=1 to force sample-accurate delivery.",
+            block_ksmps,
+            max_subblock_frames,
+        )
+        return block_ksmps
+
+    @staticmethod
+    def _rewrite_orchestra_ksmps(csd: str, ksmps: int) -> str:
+        return re.sub(
+            r"(?mi)^(\s*ksmps\s*=\s*)[0-9]+(?:\.[0-9]+)?(\s*)$",
+            lambda match: f"{match.group(1)}{ksmps}{match.group(2)}",
+            csd,
+            count=1,
+        )
+
     @staticmethod
     def _invoke_numeric_member(csound: object, candidate_names: tuple[str, ...]) -> int | None:
         for name in candidate_names:
@@ -860,7 +1131,7 @@ class CsoundWorker:
     def _start_mock(self, csd: str) -> EngineStartResult:
         self._runtime_sr = self._extract_orchestra_numeric_scalar(csd, "sr") or DEFAULT_BROWSER_AUDIO_SAMPLE_RATE
         self._runtime_nchnls = self._extract_orchestra_numeric_scalar(csd, "nchnls") or 2
-        self._runtime_ksmps = self._extract_orchestra_numeric_scalar(csd, "ksmps") or 32
+        self._runtime_ksmps = (self._extract_orchestra_numeric_scalar(csd, "ksmps") or 32) * self._ksmps_scale
         self._render_sample_cursor = 0
         self._midi_scheduler.reset()
         self._midi_scheduler.set_engine_sample_rate(self._runtime_sr)
@@ -0,0 +1,115 @@
+from __future__ import annotations
+
+import struct
+from typing import Any
+
+# Per-chunk lossless codec for int24-quantized PCM: a fixed polynomial predictor (FLAC "fixed" subframes, orders
+# 0-3) chosen per channel, with zigzagged residuals Rice-coded in partitions that each pick their own parameter.
+# Every chunk starts from zero predictor history, so frames decode independently and no lookahead is added.
+RICE24_MAX_ORDER = 3
+RICE24_PARTITION_FRAMES = 256
+RICE24_MAX_PARAMETER = 30
+RICE24_FULL_SCALE = 8_388_607
+
+# order, reserved, partition count, bitstream byte length; followed by one Rice parameter byte per partition
+# and the MSB-first bitstream (per residual: quotient zeros, a one bit, then ``k`` remainder bits).
+RICE24_CHANNEL_HEADER = struct.Struct("<BBHI")
+
+
+def encode_pcm_rice24(pcm_f32le: bytes, *, channels: int) -> bytes:
+    """Quantizes interleaved float32 PCM to int24 and returns the Rice-coded channel blocks."""
+    import numpy as np  # type: ignore
+
+    samples = np.frombuffer(pcm_f32le, dtype=np.float32)
+    channel_count = max(1, int(channels))
+    if samples.size % channel_count != 0:
+        raise ValueError("PCM payload is not a whole number of frames.")
+    quantized = np.clip(
+        np.rint(samples.astype(np.float64) * RICE24_FULL_SCALE), -RICE24_FULL_SCALE - 1, RICE24_FULL_SCALE
+    ).astype(np.int64)
+    interleaved = quantized.reshape(-1, channel_count)
+    return b"".join(_encode_channel(interleaved[:, channel]) for channel in range(channel_count))
+
+
+def decode_pcm_rice24(payload: bytes, *, channels: int, frame_count: int) -> Any:
+    """Reference decoder returning interleaved int24 sample values; the browser ships its own copy."""
+    import numpy as np  # type: ignore
+
+    channel_count = max(1, int(channels))
+    out = np.zeros((frame_count, channel_count), dtype=np.int64)
+    offset = 0
+    for channel in range(channel_count):
+        order, _reserved, partition_count, bit_bytes = RICE24_CHANNEL_HEADER.unpack_from(payload, offset)
+        offset += RICE24_CHANNEL_HEADER.size
+        parameters = payload[offset : offset + partition_count]
+        offset += partition_count
+        bits = np.unpackbits(np.frombuffer(payload, dtype=np.uint8, count=bit_bytes, offset=offset))
+        offset += bit_bytes
+
+        residual = np.zeros(frame_count, dtype=np.int64)
+        cursor = 0
+        for index in range(frame_count):
+            k = parameters[index // RICE24_PARTITION_FRAMES]
+            quotient = 0
+            while bits[cursor] == 0:
+                quotient += 1
+                cursor += 1
+            cursor += 1
+            remainder = 0
+            for _ in range(k):
+                remainder = (remainder << 1) | int(bits[cursor])
+                cursor += 1
+            folded = (quotient << k) | remainder
+            residual[index] = (folded >> 1) ^ -(folded & 1)
+
+        values = residual
+        for _ in range(order):
+            values = np.cumsum(values)
+        out[:, channel] = values
+    return out.reshape(-1)
+
+
+def _encode_channel(values: Any) -> bytes:
+    import numpy as np  # type: ignore
+
+    frame_count = int(values.size)
+    order, residual = _best_fixed_residual(values)
+    folded = (residual << 1) ^ (residual >> 63)
+
+    partition_count = (frame_count + RICE24_PARTITION_FRAMES - 1) // RICE24_PARTITION_FRAMES
+    parameters = np.zeros(partition_count, dtype=np.int64)
+    candidates = np.arange(RICE24_MAX_PARAMETER + 1, dtype=np.int64)
+    for partition in range(partition_count):
+        chunk = folded[partition * RICE24_PARTITION_FRAMES : (partition + 1) * RICE24_PARTITION_FRAMES]
+        costs = (chunk[:, None] >> candidates[None, :]).sum(axis=0) + chunk.size * (candidates + 1)
+        parameters[partition] = int(np.argmin(costs))
+
+    k = np.repeat(parameters, RICE24_PARTITION_FRAMES)[:frame_count]
+    quotients = folded >> k
+    lengths = quotients + 1 + k
+    starts = np.cumsum(lengths) - lengths
+    bits = np.zeros(int(lengths.sum()), dtype=np.uint8)
+    stop_positions = starts + quotients
+    bits[stop_positions] = 1
+    for bit in range(int(parameters.max(initial=0))):
+        mask = k > bit
+        bits[stop_positions[mask] + 1 + bit] = (folded[mask] >> (k[mask] - 1 - bit)) & 1
+    bitstream = np.packbits(bits).tobytes()
+
+    header = RICE24_CHANNEL_HEADER.pack(order, 0, partition_count, len(bitstream))
+    return b"".join((header, parameters.astype(np.uint8).tobytes(), bitstream))
+
+
+def _best_fixed_residual(values: Any) -> tuple[int, Any]:
+    import numpy as np  # type: ignore
+
+    best_order = 0
+    best_residual = values
+    best_cost = int(np.abs(values).sum())
+    padded = np.concatenate((np.zeros(RICE24_MAX_ORDER, dtype=np.int64), values))
+    for order in range(1, RICE24_MAX_ORDER + 1):
+        residual = np.diff(padded[RICE24_MAX_ORDER - order :], n=order)
+        cost = int(np.abs(residual).sum())
+        if cost < best_cost:
+            best_order, best_residual, best_cost = order, residual, cost
+    return best_order, best_residual
@@ -1,9 +1,13 @@
 from __future__ import annotations
 
+from collections import deque
 from dataclasses import dataclass, field
 import heapq
 import threading
-from typing import Callable
+import time
+from typing import Callable, NamedTuple
+
+from backend.app.engine.midi_trace import MidiTraceBuffer
 
 
 @dataclass(order=True, slots=True)
@@ -16,16 +20,30 @@ class EngineMidiEvent:
     mapped_backend_monotonic_ns: int | None = field(default=None, compare=False)
     late: bool = field(default=False, compare=False)
     sync_stale: bool = field(default=False, compare=False)
+    received_ns: int | None = field(default=None, compare=False)
+
+
+class ScheduledMidiInput(NamedTuple):
+    message: tuple[int, int, int]
+    target_engine_sample: int
+    mapped_backend_monotonic_ns: int | None = None
+    sync_stale: bool = False
+    received_ns: int | None = None
 
 
 class EngineMidiScheduler:
-    def __init__(self, *, max_events: int = 16_384) -> None:
+    def __init__(self, *, max_events: int = 16_384, trace: MidiTraceBuffer | None = None) -> None:
         self._max_events = max(1, int(max_events))
         self._lock = threading.Lock()
         self._events: list[EngineMidiEvent] = []
         self._sequence = 0
         self._overflow_count = 0
         self._engine_sample_rate = 0
+        self._trace = trace
+
+    @property
+    def trace(self) -> MidiTraceBuffer | None:
+        return self._trace
 
     @property
     def overflow_count(self) -> int:
@@ -47,6 +65,8 @@ class EngineMidiScheduler:
             self._sequence = 0
             self._overflow_count = 0
             self._engine_sample_rate = 0
+        if self._trace is not None:
+            self._trace.clear()
 
     def enqueue(
         self,
@@ -58,6 +78,7 @@ class EngineMidiScheduler:
         mapped_backend_monotonic_ns: int | None = None,
         late: bool = False,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> tuple[bool, EngineMidiEvent | None]:
         raw = bytes(int(value) & 0xFF for value in message)
         if len(raw) != 3:
@@ -72,6 +93,7 @@ class EngineMidiScheduler:
             mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
             late=late,
             sync_stale=sync_stale,
+            received_ns=received_ns,
         )
 
         with self._lock:
@@ -81,8 +103,53 @@ class EngineMidiScheduler:
             self._sequence += 1
             event.sequence = self._sequence
             heapq.heappush(self._events, event)
+        if self._trace is not None:
+            self._trace.record_enqueue(event, enqueued_ns=time.perf_counter_ns())
         return (True, event)
 
+    def enqueue_many(
+        self,
+        inputs: list[ScheduledMidiInput],
+        *,
+        source: str,
+        current_engine_sample: int,
+    ) -> int:
+        """Enqueues a batch under one lock acquisition and returns how many leading inputs were accepted.
+
+        Targets before ``current_engine_sample`` are clamped to it and flagged late, like ``enqueue`` callers do.
+        Once the queue is full every remaining input is rejected, so the accepted inputs are always a prefix.
+        """
+
+        current_engine_sample = max(0, int(current_engine_sample))
+        events: list[EngineMidiEvent] = []
+        for message, target_engine_sample, mapped_backend_monotonic_ns, sync_stale, received_ns in inputs:
+            target = int(target_engine_sample)
+            events.append(
+                EngineMidiEvent(
+                    target_engine_sample=max(current_engine_sample, target),
+                    sequence=0,
+                    source=source,
+                    message=bytes((message[0] & 0xFF, message[1] & 0xFF, message[2] & 0xFF)),
+                    mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
+                    late=target < current_engine_sample,
+                    sync_stale=sync_stale,
+                    received_ns=received_ns,
+                )
+            )
+
+        with self._lock:
+            accepted = min(len(events), max(0, self._max_events - len(self._events)))
+            for event in events[:accepted]:
+                self._sequence += 1
+                event.sequence = self._sequence
+                heapq.heappush(self._events, event)
+            self._overflow_count += len(events) - accepted
+        if self._trace is not None:
+            enqueued_ns = time.perf_counter_ns()
+            for event in events[:accepted]:
+                self._trace.record_enqueue(event, enqueued_ns=enqueued_ns)
+        return accepted
+
     def enqueue_after_delay(
         self,
         message: bytes | bytearray | list[int],
@@ -92,6 +159,7 @@ class EngineMidiScheduler:
         current_engine_sample: int,
         source_timestamp_ns: int | None = None,
         mapped_backend_monotonic_ns: int | None = None,
+        received_ns: int | None = None,
     ) -> tuple[bool, EngineMidiEvent | None]:
         with self._lock:
             sample_rate = self._engine_sample_rate
@@ -105,6 +173,7 @@ class EngineMidiScheduler:
             target_engine_sample=max(0, int(current_engine_sample)) + delay_samples,
             source_timestamp_ns=source_timestamp_ns,
             mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
+            received_ns=received_ns,
         )
 
     def drain_block(self, *, block_start_sample: int, block_end_sample: int) -> list[EngineMidiEvent]:
@@ -116,37 +185,147 @@ class EngineMidiScheduler:
                     event.late = True
                     event.target_engine_sample = block_start_sample
                 drained.append(event)
+        if drained and self._trace is not None:
+            self._trace.record_drain(drained, block_start_sample=block_start_sample, drained_ns=time.perf_counter_ns())
         return drained
 
 
+@dataclass(slots=True, frozen=True)
+class ClockDomainEstimate:
+    offset_ns: int
+    skew_ppm: float
+    residual_ns: int
+    sample_count: int
+    rejected_count: int
+    anchor_remote_ns: int
+
+
 class ClockDomainMapping:
+    """Maps remote monotonic timestamps onto the server clock with a fitted offset and skew.
+
+    Each sync is one ``(remote, server)`` pair whose observed offset is the true offset plus a non-negative
+    one-way delay. The estimator keeps a window of recent pairs. It takes the minimum-delay pair from each
+    of up to ``_FIT_BUCKETS`` time-ordered buckets and fits ``offset = a + b * (remote - anchor)`` through
+    those minima by least squares, so queueing delay does not bias the line. A pair that lands far above
+    the fitted line is a delayed sample and is rejected instead of pulling the offset. Many consecutive
+    rejections mean the remote clock stepped, and the window restarts. Mapped timestamps follow the
+    fitted line, so they keep pace with ppm drift between syncs.
+    """
+
     _STALE_AFTER_NS = 1_000_000_000
+    _WINDOW_SAMPLES = 128
+    _FIT_BUCKETS = 8
+    _MIN_FIT_SPAN_NS = 200_000_000
+    _MAX_SKEW_PPM = 500.0
+    _MIN_REJECT_THRESHOLD_NS = 2_000_000
+    _REJECT_RESIDUAL_FACTOR = 4.0
+    _MAX_CONSECUTIVE_REJECTIONS = 8
 
     def __init__(self) -> None:
         self._lock = threading.Lock()
-        self._offset_ns: int | None = None
+        self._samples: deque[tuple[int, int]] = deque(maxlen=self._WINDOW_SAMPLES)
+        self._pending_rejections: list[tuple[int, int]] = []
+        self._estimate: ClockDomainEstimate | None = None
+        self._rejected_count = 0
         self._last_server_ns: int | None = None
-        self._last_remote_ns: int | None = None
 
-    def update(self, *, remote_timestamp_ns: int, server_timestamp_ns: int) -> None:
-        sample_offset = int(server_timestamp_ns) - int(remote_timestamp_ns)
+    def update(self, *, remote_timestamp_ns: int, server_timestamp_ns: int) -> bool:
+        """Adds one sync pair. Returns ``False`` when the pair was rejected as a delayed outlier."""
+
+        remote_ns = int(remote_timestamp_ns)
+        sample = (remote_ns, int(server_timestamp_ns) - remote_ns)
         with self._lock:
-            if self._offset_ns is None:
-                self._offset_ns = sample_offset
-            else:
-                # Smooth noisy one-way samples without hiding larger drift.
-                self._offset_ns = int(round((self._offset_ns * 0.8) + (sample_offset * 0.2)))
             self._last_server_ns = int(server_timestamp_ns)
-            self._last_remote_ns = int(remote_timestamp_ns)
+            estimate = self._estimate
+            if estimate is not None and len(self._samples) >= self._FIT_BUCKETS:
+                residual_ns = sample[1] - self._predicted_offset_ns(estimate, remote_ns)
+                threshold_ns = max(
+                    self._MIN_REJECT_THRESHOLD_NS,
+                    int(estimate.residual_ns * self._REJECT_RESIDUAL_FACTOR),
+                )
+                if residual_ns > threshold_ns:
+                    self._rejected_count += 1
+                    self._pending_rejections.append(sample)
+                    if len(self._pending_rejections) < self._MAX_CONSECUTIVE_REJECTIONS:
+                        self._estimate = self._with_rejected_count(estimate)
+                        return False
+                    # The remote clock stepped; rebuild the window from the recent samples.
+                    self._samples.clear()
+                    self._samples.extend(self._pending_rejections)
+                    self._pending_rejections.clear()
+                    self._estimate = self._fit_locked()
+                    return True
+            self._pending_rejections.clear()
+            self._samples.append(sample)
+            self._estimate = self._fit_locked()
+            return True
+
+    def estimate(self) -> ClockDomainEstimate | None:
+        with self._lock:
+            return self._estimate
 
     def map_to_server_time(self, remote_timestamp_ns: int, *, now_server_ns: int) -> tuple[int | None, bool]:
         with self._lock:
-            offset_ns = self._offset_ns
+            estimate = self._estimate
             last_server_ns = self._last_server_ns
-        if offset_ns is None or last_server_ns is None:
+        if estimate is None or last_server_ns is None:
             return (None, True)
         stale = (int(now_server_ns) - last_server_ns) > self._STALE_AFTER_NS
-        return (int(remote_timestamp_ns) + offset_ns, stale)
+        remote_ns = int(remote_timestamp_ns)
+        return (remote_ns + self._predicted_offset_ns(estimate, remote_ns), stale)
+
+    @staticmethod
+    def _predicted_offset_ns(estimate: ClockDomainEstimate, remote_ns: int) -> int:
+        return estimate.offset_ns + int(round((remote_ns - estimate.anchor_remote_ns) * estimate.skew_ppm * 1e-6))
+
+    def _with_rejected_count(self, estimate: ClockDomainEstimate) -> ClockDomainEstimate:
+        return ClockDomainEstimate(
+            offset_ns=estimate.offset_ns,
+            skew_ppm=estimate.skew_ppm,
+            residual_ns=estimate.residual_ns,
+            sample_count=estimate.sample_count,
+            rejected_count=self._rejected_count,
+            anchor_remote_ns=estimate.anchor_remote_ns,
+        )
+
+    def _fit_locked(self) -> ClockDomainEstimate:
+        samples = list(self._samples)
+        anchor_remote_ns = samples[-1][0]
+        bucket_size = max(1, -(-len(samples) // self._FIT_BUCKETS))
+        minima = [
+            min(samples[index : index + bucket_size], key=lambda sample: sample[1])
+            for index in range(0, len(samples), bucket_size)
+        ]
+
+        skew = 0.0
+        span_ns = samples[-1][0] - samples[0][0]
+        if len(minima) >= 3 and span_ns >= self._MIN_FIT_SPAN_NS:
+            xs = [float(remote - anchor_remote_ns) for remote, _offset in minima]
+            ys = [float(offset) for _remote, offset in minima]
+            mean_x = sum(xs) / len(xs)
+            mean_y = sum(ys) / len(ys)
+            variance_x = sum((x - mean_x) ** 2 for x in xs)
+            if variance_x > 0.0:
+                skew = sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys, strict=True)) / variance_x
+                max_skew = self._MAX_SKEW_PPM * 1e-6
+                skew = min(max_skew, max(-max_skew, skew))
+            intercept = mean_y - (skew * mean_x)
+            # Keep the line on the lower envelope: no minimum may sit below it.
+            intercept += min(0.0, min(y - (intercept + skew * x) for x, y in zip(xs, ys, strict=True)))
+        else:
+            intercept = float(min(offset for _remote, offset in minima))
+
+        residuals = sorted(
+            offset - (intercept + skew * (remote - anchor_remote_ns)) for remote, offset in samples
+        )
+        return ClockDomainEstimate(
+            offset_ns=int(round(intercept)),
+            skew_ppm=skew * 1e6,
+            residual_ns=max(0, int(round(residuals[len(residuals) // 2]))),
+            sample_count=len(samples),
+            rejected_count=self._rejected_count,
+            anchor_remote_ns=anchor_remote_ns,
+        )
 
 
 class EngineMidiOutputAdapter:
@@ -0,0 +1,239 @@
+from __future__ import annotations
+
+from bisect import bisect_right
+from collections import deque
+from typing import TYPE_CHECKING, Any, NamedTuple
+
+if TYPE_CHECKING:
+    from backend.app.engine.midi_scheduler import EngineMidiEvent
+
+_NS_PER_US = 1_000.0
+
+_TRACE_PID = 1
+_MIDI_EVENT_TID = 1
+_RENDER_BLOCK_TID = 2
+_RENDER_CHUNK_TID = 3
+
+
+class _EnqueueRecord(NamedTuple):
+    sequence: int
+    source: str
+    message: bytes
+    target_engine_sample: int
+    source_timestamp_ns: int | None
+    mapped_backend_monotonic_ns: int | None
+    received_ns: int | None
+    enqueued_ns: int
+    late: bool
+    sync_stale: bool
+
+
+class _DrainRecord(NamedTuple):
+    sequence: int
+    block_start_sample: int
+    drained_ns: int
+    late: bool
+
+
+class _SampleSpanRecord(NamedTuple):
+    engine_sample_start: int
+    engine_sample_end: int
+    started_ns: int
+    finished_ns: int
+
+
+class MidiTraceBuffer:
+    """Bounded per-session record of MIDI event timing, exportable as Chrome/Perfetto trace JSON.
+
+    Each stage is recorded where it happens: scheduler enqueue and drain, render block completion on the
+    render thread, and ``render_chunk`` send on the socket task. Recording only appends a tuple to a
+    bounded deque. ``deque.append`` is atomic in CPython, so writers take no lock and the render thread
+    never waits on an export. Records are stitched into per-event spans only when exported. Events are
+    keyed by scheduler sequence and blocks by engine sample, so the buffer is cleared whenever the
+    scheduler resets. All timestamps are ``time.perf_counter_ns`` values.
+    """
+
+    __slots__ = ("_capacity", "_enqueued", "_drained", "_blocks", "_chunks")
+
+    def __init__(self, capacity: int) -> None:
+        self._capacity = max(1, int(capacity))
+        self._enqueued: deque[_EnqueueRecord] = deque(maxlen=self._capacity)
+        self._drained: deque[_DrainRecord] = deque(maxlen=self._capacity)
+        self._blocks: deque[_SampleSpanRecord] = deque(maxlen=self._capacity)
+        self._chunks: deque[_SampleSpanRecord] = deque(maxlen=self._capacity)
+
+    @property
+    def capacity(self) -> int:
+        return self._capacity
+
+    def clear(self) -> None:
+        self._enqueued.clear()
+        self._drained.clear()
+        self._blocks.clear()
+        self._chunks.clear()
+
+    def record_enqueue(self, event: EngineMidiEvent, *, enqueued_ns: int) -> None:
+        self._enqueued.append(
+            _EnqueueRecord(
+                event.sequence,
+                event.source,
+                event.message,
+                event.target_engine_sample,
+                event.source_timestamp_ns,
+                event.mapped_backend_monotonic_ns,
+                event.received_ns,
+                enqueued_ns,
+                event.late,
+                event.sync_stale,
+            )
+        )
+
+    def record_drain(self, events: list[EngineMidiEvent], *, block_start_sample: int, drained_ns: int) -> None:
+        for event in events:
+            self._drained.append(_DrainRecord(event.sequence, block_start_sample, drained_ns, event.late))
+
+    def record_block(
+        self,
+        *,
+        engine_sample_start: int,
+        engine_sample_end: int,
+        started_ns: int,
+        finished_ns: int,
+    ) -> None:
+        self._blocks.append(_SampleSpanRecord(engine_sample_start, engine_sample_end, started_ns, finished_ns))
+
+    def record_chunk_sent(self, *, engine_sample_start: int, engine_sample_end: int, sent_ns: int) -> None:
+        self._chunks.append(_SampleSpanRecord(engine_sample_start, engine_sample_end, sent_ns, sent_ns))
+
+    def export_chrome_trace(self, *, session_id: str) -> dict[str, Any]:
+        """Returns a Chrome trace-event document that loads in ``chrome://tracing`` and Perfetto.
+
+        Each MIDI event becomes an async span with one nested slice per stage it has reached:
+        ``source_to_receipt``, ``receipt_to_enqueue``, ``queued``, ``render`` and ``delivery``. Render
+        blocks are complete events and chunk sends are instant events on their own tracks.
+        """
+
+        enqueued = self._enqueued.copy()
+        drained = {record.sequence: record for record in self._drained.copy()}
+        blocks = sorted(self._blocks.copy())
+        chunks = sorted(self._chunks.copy())
+        block_starts = [block.engine_sample_start for block in blocks]
+        chunk_starts = [chunk.engine_sample_start for chunk in chunks]
+
+        trace_events: list[dict[str, Any]] = [
+            _metadata_event("process_name", {"name": f"session {session_id}"}),
+            _metadata_event("thread_name", {"name": "midi events"}, tid=_MIDI_EVENT_TID),
+            _metadata_event("thread_name", {"name": "render blocks"}, tid=_RENDER_BLOCK_TID),
+            _metadata_event("thread_name", {"name": "render_chunk sends"}, tid=_RENDER_CHUNK_TID),
+        ]
+
+        for record in enqueued:
+            drain = drained.get(record.sequence)
+            block = None
+            chunk = None
+            if drain is not None:
+                block = _span_containing(blocks, block_starts, drain.block_start_sample)
+                chunk = _span_containing(chunks, chunk_starts, drain.block_start_sample)
+            stages = (
+                ("source_to_receipt", record.mapped_backend_monotonic_ns, record.received_ns),
+                ("receipt_to_enqueue", record.received_ns, record.enqueued_ns),
+                ("queued", record.enqueued_ns, None if drain is None else drain.drained_ns),
+                ("render", None if drain is None else drain.drained_ns, None if block is None else block.finished_ns),
+                ("delivery", None if block is None else block.finished_ns, None if chunk is None else chunk.started_ns),
+            )
+            points = [point for _name, start, end in stages for point in (start, end) if point is not None]
+            args: dict[str, Any] = {
+                "sequence": record.sequence,
+                "source": record.source,
+                "message": list(record.message),
+                "target_engine_sample": record.target_engine_sample,
+                "source_timestamp_ns": record.source_timestamp_ns,
+                "late": record.late or (drain is not None and drain.late),
+                "sync_stale": record.sync_stale,
+            }
+            if drain is not None:
+                args["block_start_sample"] = drain.block_start_sample
+            if chunk is not None:
+                args["engine_sample_start"] = chunk.engine_sample_start
+
+            span_id = f"0x{record.sequence:x}"
+            name = f"midi {record.message.hex()}"
+            trace_events.append(_async_event("b", name, span_id, min(points), args=args))
+            for stage_name, start_ns, end_ns in stages:
+                if start_ns is None or end_ns is None:
+                    continue
+                trace_events.append(_async_event("b", stage_name, span_id, start_ns))
+                trace_events.append(_async_event("e", stage_name, span_id, max(start_ns, end_ns)))
+            trace_events.append(_async_event("e", name, span_id, max(points)))
+
+        for block in blocks:
+            trace_events.append(
+                {
+                    "ph": "X",
+                    "name": "render block",
+                    "cat": "engine",
+                    "pid": _TRACE_PID,
+                    "tid": _RENDER_BLOCK_TID,
+                    "ts": block.started_ns / _NS_PER_US,
+                    "dur": max(0, block.finished_ns - block.started_ns) / _NS_PER_US,
+                    "args": {
+                        "engine_sample_start": block.engine_sample_start,
+                        "engine_sample_end": block.engine_sample_end,
+                    },
+                }
+            )
+        for chunk in chunks:
+            trace_events.append(
+                {
+                    "ph": "i",
+                    "s": "t",
+                    "name": "render_chunk sent",
+                    "cat": "transport",
+                    "pid": _TRACE_PID,
+                    "tid": _RENDER_CHUNK_TID,
+                    "ts": chunk.started_ns / _NS_PER_US,
+                    "args": {
+                        "engine_sample_start": chunk.engine_sample_start,
+                        "engine_sample_end": chunk.engine_sample_end,
+                    },
+                }
+            )
+
+        return {"traceEvents": trace_events, "displayTimeUnit": "ms"}
+
+
+def _span_containing(
+    spans: list[_SampleSpanRecord],
+    starts: list[int],
+    engine_sample: int,
+) -> _SampleSpanRecord | None:
+    index = bisect_right(starts, engine_sample) - 1
+    if index < 0 or spans[index].engine_sample_end <= engine_sample:
+        return None
+    return spans[index]
+
+
+def _metadata_event(name: str, args: dict[str, Any], *, tid: int = 0) -> dict[str, Any]:
+    return {"ph": "M", "name": name, "pid": _TRACE_PID, "tid": tid, "args": args}
+
+
+def _async_event(
+    phase: str,
+    name: str,
+    span_id: str,
+    timestamp_ns: int,
+    *,
+    args: dict[str, Any] | None = None,
+) -> dict[str, Any]:
+    event: dict[str, Any] = {
+        "ph": phase,
+        "name": name,
+        "cat": "midi",
+        "id": span_id,
+        "pid": _TRACE_PID,
+        "tid": _MIDI_EVENT_TID,
+        "ts": timestamp_ns / _NS_PER_US,
+    }
+    if args is not None:
+        event["args"] = args
+    return event
@@ -0,0 +1,357 @@
+from __future__ import annotations
+
+from concurrent.futures import Future, ThreadPoolExecutor, wait
+from dataclasses import dataclass, field
+import logging
+import os
+from pathlib import Path
+import re
+import shutil
+import struct
+import threading
+from typing import Any, Sequence
+
+from backend.app.engine.browser_audio_pcm import normalize_csound_spout_to_stereo
+from backend.app.engine.ctcsound_loader import load_ctcsound_module
+
+logger = logging.getLogger(__name__)
+
+WAVE_FORMAT_IEEE_FLOAT = 0x0003
+WAVE_FORMAT_EXTENSIBLE = 0xFFFE
+_MIX_CHUNK_FRAMES = 1 << 18
+# ``stop()`` only flags a running ``perform()``; it is repeated until every stopped job has returned.
+_STOP_RETRY_SECONDS = 0.1
+
+
+class OfflineRenderUnavailableError(RuntimeError):
+    pass
+
+
+class OfflineRenderError(RuntimeError):
+    pass
+
+
+class OfflineRenderTimeoutError(OfflineRenderError):
+    pass
+
+
+@dataclass(slots=True)
+class OfflineRenderJob:
+    name: str
+    csd: str
+    midi_bytes: bytes | None = None
+
+
+@dataclass(slots=True)
+class _RenderCall:
+    """Csound instances performing for one ``render()`` call, so a timeout can stop exactly those."""
+
+    lock: threading.Lock = field(default_factory=threading.Lock)
+    active: set[Any] = field(default_factory=set)
+    aborted: bool = False
+
+    def enter(self, csound: Any) -> bool:
+        with self.lock:
+            if self.aborted:
+                return False
+            self.active.add(csound)
+            return True
+
+    def leave(self, csound: Any) -> None:
+        with self.lock:
+            self.active.discard(csound)
+
+    def abort(self) -> None:
+        with self.lock:
+            self.aborted = True
+            active = list(self.active)
+        for csound in active:
+            try:
+                csound.stop()
+            except Exception:
+                logger.debug("Offline Csound stop() failed during abort", exc_info=True)
+
+
+@dataclass(slots=True)
+class FloatWavInfo:
+    sample_rate: int
+    channels: int
+    frame_count: int
+    data_offset: int
+
+
+class OfflineCsoundRenderer:
+    """Renders complete CSD documents to 32-bit float WAV files with one Csound instance per job.
+
+    ``perform()`` runs the whole score inside Csound without returning to Python, so independent jobs
+    render in parallel. One renderer is shared by every request, and its pool caps the Csound instances
+    performing at once across all exports. A ``render()`` call that outlives ``max_render_seconds`` stops
+    its running jobs, drops its queued ones and removes the files it wrote.
+    """
+
+    def __init__(
+        self,
+        *,
+        max_workers: int = 0,
+        max_render_seconds: float = 0.0,
+        ctcsound_module: Any | None = None,
+    ) -> None:
+        self._max_workers = max(1, int(max_workers) or os.cpu_count() or 1)
+        self._max_render_seconds = max(0.0, float(max_render_seconds))
+        self._ctcsound = ctcsound_module
+        self._load_error: str | None = None
+        self._pool_lock = threading.Lock()
+        self._pool: ThreadPoolExecutor | None = None
+        self._closed = False
+
+    @property
+    def max_workers(self) -> int:
+        return self._max_workers
+
+    def render(
+        self,
+        jobs: Sequence[OfflineRenderJob],
+        *,
+        work_dir: Path,
+        assets: Sequence[tuple[Path, str]] = (),
+    ) -> list[Path]:
+        ctcsound = self._require_ctcsound()
+        work_dir.mkdir(parents=True, exist_ok=True)
+        self._stage_assets(work_dir, assets)
+        if not jobs:
+            return []
+
+        pool = self._shared_pool()
+        call = _RenderCall()
+        futures = [pool.submit(self._render_job, ctcsound, job, work_dir, call) for job in jobs]
+        try:
+            _done, pending = wait(futures, timeout=self._max_render_seconds or None)
+            if pending:
+                raise OfflineRenderTimeoutError(
+                    f"Offline render exceeded its {self._max_render_seconds:g} s wall-time budget."
+                )
+            return [future.result() for future in futures]
+        except BaseException:
+            self._abort(call, futures)
+            self._remove_job_files(jobs, work_dir)
+            raise
+
+    def close(self) -> None:
+        with self._pool_lock:
+            self._closed = True
+            pool, self._pool = self._pool, None
+        if pool is not None:
+            pool.shutdown(wait=False, cancel_futures=True)
+
+    def _shared_pool(self) -> ThreadPoolExecutor:
+        with self._pool_lock:
+            if self._closed:
+                raise OfflineRenderUnavailableError("Offline renderer has been shut down.")
+            if self._pool is None:
+                self._pool = ThreadPoolExecutor(max_workers=self._max_workers, thread_name_prefix="offline-render")
+            return self._pool
+
+    @staticmethod
+    def _abort(call: _RenderCall, futures: Sequence[Future[Path]]) -> None:
+        for future in futures:
+            future.cancel()
+        call.abort()
+        while wait(futures, timeout=_STOP_RETRY_SECONDS).not_done:
+            call.abort()
+
+    @staticmethod
+    def _remove_job_files(jobs: Sequence[OfflineRenderJob], work_dir: Path) -> None:
+        for job in jobs:
+            for suffix in (".wav", ".mid"):
+                (work_dir / f"{job.name}{suffix}").unlink(missing_ok=True)
+
+    def _require_ctcsound(self) -> Any:
+        if self._ctcsound is not None:
+            return self._ctcsound
+        force_mock = os.getenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "").strip().lower()
+        if force_mock in {"1", "true", "yes", "on"}:
+            raise OfflineRenderUnavailableError("Offline audio render is unavailable with the mock engine.")
+        if self._load_error is None:
+            try:
+                self._ctcsound = load_ctcsound_module()
+                return self._ctcsound
+            except Exception as exc:
+                self._load_error = str(exc)
+        raise OfflineRenderUnavailableError(f"Offline audio render requires ctcsound: {self._load_error}")
+
+    def _render_job(self, ctcsound: Any, job: OfflineRenderJob, work_dir: Path, call: _RenderCall) -> Path:
+        output_path = work_dir / f"{job.name}.wav"
+        midi_path: Path | None = None
+        if job.midi_bytes is not None:
+            midi_path = work_dir / f"{job.name}.mid"
+            midi_path.write_bytes(job.midi_bytes)
+
+        csound = ctcsound.Csound()
+        try:
+            # File output and MIDI file input are passed as options rather than through CsOptions, so
+            # absolute work-directory paths never need quoting and never leak into exported documents.
+            csound.setOption("-d")
+            csound.setOption("-W")
+            csound.setOption("-f")
+            csound.setOption(f"-o{output_path}")
+            if midi_path is not None:
+                csound.setOption(f"-F{midi_path}")
+            csound.setOption(f"--env:SSDIR={work_dir}")
+
+            compile_result = csound.compileCsdText(self._strip_csoptions(job.csd))
+            if compile_result != 0:
+                raise OfflineRenderError(f"Offline render of '{job.name}' failed to compile (code {compile_result}).")
+            start_result = csound.start()
+            if start_result != 0:
+                raise OfflineRenderError(f"Offline render of '{job.name}' failed to start (code {start_result}).")
+            if not call.enter(csound):
+                raise OfflineRenderTimeoutError(f"Offline render of '{job.name}' was aborted.")
+            try:
+                perform_result = csound.perform()
+            finally:
+                call.leave(csound)
+            if call.aborted:
+                raise OfflineRenderTimeoutError(f"Offline render of '{job.name}' was aborted.")
+            if perform_result < 0:
+                raise OfflineRenderError(f"Offline render of '{job.name}' failed (code {perform_result}).")
+        finally:
+            self._teardown_csound(csound)
+
+        if not output_path.is_file():
+            raise OfflineRenderError(f"Offline render of '{job.name}' produced no audio file.")
+        return output_path
+
+    @staticmethod
+    def _stage_assets(work_dir: Path, assets: Sequence[tuple[Path, str]]) -> None:
+        for source_path, archive_path in assets:
+            target = work_dir / archive_path
+            if target.exists():
+                continue
+            target.parent.mkdir(parents=True, exist_ok=True)
+            try:
+                target.symlink_to(source_path.resolve())
+            except OSError:
+                shutil.copyfile(source_path, target)
+
+    @staticmethod
+    def _strip_csoptions(csd: str) -> str:
+        return re.sub(r"<CsOptions>.*?</CsOptions>\s*", "", csd, count=1, flags=re.DOTALL)
+
+    @staticmethod
+    def _teardown_csound(csound: object) -> None:
+        for method_name in ("stop", "cleanup", "reset"):
+            method = getattr(csound, method_name, None)
+            if not callable(method):
+                continue
+            try:
+                method()
+            except Exception:
+                logger.debug("Offline Csound %s() failed during teardown", method_name, exc_info=True)
+
+
+def read_float_wav_info(path: Path) -> FloatWavInfo:
+    with path.open("rb") as handle:
+        header = handle.read(12)
+        if len(header) < 12 or header[:4] != b"RIFF" or header[8:12] != b"WAVE":
+            raise OfflineRenderError(f"'{path.name}' is not a RIFF/WAVE file.")
+        channels = 0
+        sample_rate = 0
+        while True:
+            chunk_header = handle.read(8)
+            if len(chunk_header) < 8:
+                raise OfflineRenderError(f"'{path.name}' has no data chunk.")
+            chunk_id = chunk_header[:4]
+            chunk_size = struct.unpack("<I", chunk_header[4:])[0]
+            if chunk_id == b"fmt ":
+                fmt = handle.read(chunk_size)
+                format_tag, channels, sample_rate = struct.unpack("<HHI", fmt[:8])
+                bits_per_sample = struct.unpack("<H", fmt[14:16])[0]
+                if format_tag == WAVE_FORMAT_EXTENSIBLE and len(fmt) >= 26:
+                    format_tag = struct.unpack("<H", fmt[24:26])[0]
+                if format_tag != WAVE_FORMAT_IEEE_FLOAT or bits_per_sample != 32:
+                    raise OfflineRenderError(f"'{path.name}' is not a 32-bit float WAV file.")
+                if chunk_size % 2:
+                    handle.seek(1, os.SEEK_CUR)
+                continue
+            if chunk_id == b"data":
+                if channels <= 0:
+                    raise OfflineRenderError(f"'{path.name}' has a data chunk before its fmt chunk.")
+                data_offset = handle.tell()
+                available = max(0, path.stat().st_size - data_offset)
+                data_size = min(chunk_size, available)
+                return FloatWavInfo(
+                    sample_rate=sample_rate,
+                    channels=channels,
+                    frame_count=data_size // (4 * channels),
+                    data_offset=data_offset,
+                )
+            handle.seek(chunk_size + (chunk_size % 2), os.SEEK_CUR)
+
+
+def float_wav_header(*, sample_rate: int, channels: int, frame_count: int) -> bytes:
+    block_align = 4 * channels
+    data_size = frame_count * block_align
+    return b"".join(
+        [
+            b"RIFF",
+            struct.pack("<I", 4 + (8 + 16) + (8 + data_size)),
+            b"WAVE",
+            b"fmt ",
+            struct.pack(
+                "<IHHIIHH",
+                16,
+                WAVE_FORMAT_IEEE_FLOAT,
+                channels,
+                sample_rate,
+                sample_rate * block_align,
+                block_align,
+                32,
+            ),
+            b"data",
+            struct.pack("<I", data_size),
+        ]
+    )
+
+
+def mix_float_wav_files(stem_paths: Sequence[Path], output_path: Path) -> FloatWavInfo:
+    """Sums float WAV stems into one stereo float WAV.
+
+    Stems are memory-mapped and mixed in fixed-size chunks with whole-array numpy adds, so peak memory
+    stays bounded by the chunk size rather than the performance length.
+    """
+
+    import numpy as np  # type: ignore
+
+    if not stem_paths:
+        raise OfflineRenderError("Offline mixdown requires at least one stem.")
+    infos = [read_float_wav_info(path) for path in stem_paths]
+    sample_rate = infos[0].sample_rate
+    if any(info.sample_rate != sample_rate for info in infos):
+        raise OfflineRenderError("Offline render stems use different sample rates.")
+
+    stems = [
+        np.memmap(path, dtype="<f4", mode="r", offset=info.data_offset, shape=(info.frame_count, info.channels))
+        if info.frame_count > 0
+        else np.zeros((0, info.channels), dtype=np.float32)
+        for path, info in zip(stem_paths, infos)
+    ]
+    frame_count = max(info.frame_count for info in infos)
+    mix = np.zeros((_MIX_CHUNK_FRAMES, 2), dtype=np.float32)
+    with output_path.open("wb") as output:
+        output.write(float_wav_header(sample_rate=sample_rate, channels=2, frame_count=frame_count))
+        for chunk_start in range(0, frame_count, _MIX_CHUNK_FRAMES):
+            chunk_frames = min(_MIX_CHUNK_FRAMES, frame_count - chunk_start)
+            chunk = mix[:chunk_frames]
+            chunk.fill(0.0)
+            for stem, info in zip(stems, infos):
+                stem_frames = min(chunk_frames, info.frame_count - chunk_start)
+                if stem_frames <= 0:
+                    continue
+                block = stem[chunk_start : chunk_start + stem_frames]
+                if info.channels == 2:
+                    chunk[:stem_frames] += block
+                else:
+                    chunk[:stem_frames] += normalize_csound_spout_to_stereo(block, source_channels=info.channels)
+            chunk.tofile(output)
+    del stems
+    return FloatWavInfo(sample_rate=sample_rate, channels=2, frame_count=frame_count, data_offset=44)
@@ -0,0 +1,271 @@
+from __future__ import annotations
+
+import asyncio
+from collections import deque
+import contextlib
+from dataclasses import dataclass
+import logging
+import threading
+import time
+from typing import Any, Callable
+
+from backend.app.engine.csound_worker import CsoundWorker, EngineBlockRender
+from backend.app.engine.render_executor import RenderExecutor
+
+logger = logging.getLogger(__name__)
+
+
+class StereoPcmRing:
+    """Single-producer/single-consumer ring of engine-rate stereo float32 frames.
+
+    The producer only advances ``_write_index`` and the consumer only advances ``_read_index``. Each side
+    publishes its index after copying frames, so the audio path never takes a lock.
+    """
+
+    def __init__(self, capacity_frames: int) -> None:
+        import numpy as np  # type: ignore
+
+        self._capacity = max(1, int(capacity_frames))
+        self._frames = np.zeros((self._capacity, 2), dtype=np.float32)
+        self._write_index = 0
+        self._read_index = 0
+
+    @property
+    def capacity_frames(self) -> int:
+        return self._capacity
+
+    @property
+    def readable_frames(self) -> int:
+        return self._write_index - self._read_index
+
+    @property
+    def writable_frames(self) -> int:
+        return self._capacity - self.readable_frames
+
+    @property
+    def read_index(self) -> int:
+        return self._read_index
+
+    def write(self, frames: Any) -> int:
+        count = min(int(frames.shape[0]), self.writable_frames)
+        if count <= 0:
+            return 0
+        offset = self._write_index % self._capacity
+        head = min(count, self._capacity - offset)
+        self._frames[offset : offset + head] = frames[:head]
+        if head < count:
+            self._frames[: count - head] = frames[head:count]
+        self._write_index += count
+        return count
+
+    def read(self, frame_count: int) -> Any:
+        import numpy as np  # type: ignore
+
+        count = max(0, min(int(frame_count), self.readable_frames))
+        offset = self._read_index % self._capacity
+        head = min(count, self._capacity - offset)
+        if head == count:
+            out = self._frames[offset : offset + count].copy()
+        else:
+            out = np.concatenate((self._frames[offset:], self._frames[: count - head]), axis=0)
+        self._read_index += count
+        return out
+
+
+@dataclass(slots=True)
+class _RenderedBlock:
+    engine_sample_end: int
+    snapshot: Any
+    render_ns: int
+
+
+class BrowserClockRenderAhead:
+    """Dedicated render thread that keeps a browser-clock session a bounded number of blocks ahead.
+
+    ``request_render`` then copies ready frames from the ring instead of waiting for a render per chunk. The
+    thread only paces the ring: it submits one ``RenderExecutor`` call per lookahead deficit, and that call
+    renders the missing blocks back to back on the session's worker, so Csound stays on one thread. After each
+    block the worker records ``block_snapshot()``, and the reader gets the snapshots of the blocks it delivers,
+    so status reflects the audio being sent rather than the render position. Render wall time is reported to the
+    worker's render budget once per chunk, matching the on-demand path. Live MIDI that arrives for samples
+    already rendered is delivered in the next rendered block, so the added MIDI latency is bounded by the
+    lookahead window.
+    """
+
+    def __init__(
+        self,
+        *,
+        worker: CsoundWorker,
+        render_executor: RenderExecutor,
+        session_id: str,
+        lookahead_frames: int,
+        max_request_frames: int,
+        before_block: Callable[..., None],
+        block_snapshot: Callable[[], Any],
+        name: str = "render-ahead",
+    ) -> None:
+        self._worker = worker
+        self._render_executor = render_executor
+        self._session_id = session_id
+        self._block_frames = max(1, worker.runtime_ksmps)
+        self._lookahead_frames = max(self._block_frames, int(lookahead_frames))
+        self._ring = StereoPcmRing(
+            max(self._lookahead_frames, int(max_request_frames)) + self._block_frames
+        )
+        self._before_block = before_block
+        self._block_snapshot = block_snapshot
+        self._engine_sample_rate = max(1, worker.runtime_sample_rate)
+        self._engine_sample_base = worker.render_sample_cursor
+        self._blocks: deque[_RenderedBlock] = deque()
+        self._demand_frames = 0
+        self._error: Exception | None = None
+        self._stop_event = threading.Event()
+        self._space_event = threading.Event()
+        # A reader waiting for frames parks a future on its own loop; the producer resolves it thread-safely.
+        self._waiter_lock = threading.Lock()
+        self._waiter: tuple[asyncio.AbstractEventLoop, asyncio.Future[None], int] | None = None
+        self._thread = threading.Thread(target=self._run, name=name, daemon=True)
+
+    @property
+    def block_frames(self) -> int:
+        return self._block_frames
+
+    @property
+    def lookahead_frames(self) -> int:
+        return self._lookahead_frames
+
+    @property
+    def ready_blocks(self) -> int:
+        return self._ring.readable_frames // self._block_frames
+
+    @property
+    def delivered_sample_cursor(self) -> int:
+        return self._engine_sample_base + self._ring.read_index
+
+    @property
+    def error(self) -> Exception | None:
+        return self._error
+
+    def start(self) -> None:
+        self._thread.start()
+
+    def stop(self, timeout: float = 1.0) -> None:
+        self._stop_event.set()
+        self._space_event.set()
+        self._wake_waiter()
+        if self._thread.is_alive() and self._thread is not threading.current_thread():
+            self._thread.join(timeout)
+
+    def read_blocks(self, block_count: int) -> tuple[EngineBlockRender, list[Any]] | None:
+        """Returns the next ``block_count`` blocks and the snapshots recorded after each of them, in order."""
+
+        frame_count = max(1, int(block_count)) * self._block_frames
+        if self._ring.readable_frames < frame_count:
+            return None
+
+        sample_start = self.delivered_sample_cursor
+        frames = self._ring.read(frame_count)
+        sample_end = sample_start + frame_count
+        snapshots: list[Any] = []
+        render_ns = 0
+        while self._blocks and self._blocks[0].engine_sample_end <= sample_end:
+            block = self._blocks.popleft()
+            snapshots.append(block.snapshot)
+            render_ns += block.render_ns
+        self._space_event.set()
+        self._worker.render_budget.observe(
+            wall_ns=render_ns,
+            frames=frame_count,
+            sample_rate=self._engine_sample_rate,
+        )
+        return (
+            EngineBlockRender(
+                engine_sample_start=sample_start,
+                engine_sample_end=sample_end,
+                engine_sample_rate=self._engine_sample_rate,
+                block_count=max(1, int(block_count)),
+                frames=frames,
+            ),
+            snapshots,
+        )
+
+    async def wait_for_blocks(self, block_count: int, timeout: float) -> bool:
+        """Waits on the caller's event loop, without a helper thread, until ``block_count`` blocks are ready."""
+
+        frame_count = max(1, int(block_count)) * self._block_frames
+        loop = asyncio.get_running_loop()
+        waiter: asyncio.Future[None] = loop.create_future()
+        with self._waiter_lock:
+            self._waiter = (loop, waiter, frame_count)
+            self._demand_frames = frame_count
+        self._space_event.set()
+        try:
+            # The producer may have finished before the waiter was parked.
+            self._wake_waiter()
+            await asyncio.wait_for(waiter, timeout)
+        except asyncio.TimeoutError:
+            pass
+        finally:
+            with self._waiter_lock:
+                self._waiter = None
+                self._demand_frames = 0
+        return self._ring.readable_frames >= frame_count
+
+    def _wake_waiter(self) -> None:
+        with self._waiter_lock:
+            if self._waiter is None:
+                return
+            loop, waiter, frame_count = self._waiter
+            if self._ring.readable_frames < frame_count and self._error is None and not self._stop_event.is_set():
+                return
+            self._waiter = None
+        with contextlib.suppress(RuntimeError):
+            loop.call_soon_threadsafe(self._resolve_waiter, waiter)
+
+    @staticmethod
+    def _resolve_waiter(waiter: asyncio.Future[None]) -> None:
+        if not waiter.done():
+            waiter.set_result(None)
+
+    def _target_frames(self) -> int:
+        return min(self._ring.capacity_frames, max(self._lookahead_frames, self._demand_frames))
+
+    def _deficit_blocks(self) -> int:
+        return max(0, (self._target_frames() - self._ring.readable_frames) // self._block_frames)
+
+    def _run(self) -> None:
+        while not self._stop_event.is_set():
+            self._space_event.clear()
+            if self._deficit_blocks() <= 0:
+                self._space_event.wait(self._block_frames / self._engine_sample_rate)
+                continue
+            try:
+                self._render_executor.submit(self._session_id, self._render_deficit).result()
+            except Exception as exc:
+                if not self._stop_event.is_set():
+                    logger.warning("Browser-clock render-ahead stopped: %s", exc)
+                self._error = exc
+                self._wake_waiter()
+                return
+
+    def _render_deficit(self) -> None:
+        # Runs on the render worker. Each block is published as soon as it is rendered, so a waiting reader
+        # does not sit out the rest of the batch.
+        while not self._stop_event.is_set() and self._deficit_blocks() > 0:
+            started_ns = time.perf_counter_ns()
+            rendered = self._worker.render_engine_blocks(
+                block_count=1,
+                before_block=self._before_block,
+                observe_budget=False,
+            )
+            render_ns = time.perf_counter_ns() - started_ns
+            snapshot = self._block_snapshot()
+            self._ring.write(rendered.frames)
+            self._blocks.append(
+                _RenderedBlock(
+                    engine_sample_end=rendered.engine_sample_end,
+                    snapshot=snapshot,
+                    render_ns=render_ns,
+                )
+            )
+            self._wake_waiter()
@@ -0,0 +1,93 @@
+from __future__ import annotations
+
+from dataclasses import dataclass
+import threading
+from typing import Literal
+
+RenderBudgetState = Literal["ok", "warning", "overloaded"]
+RenderBudgetPolicy = Literal["ksmps", "voice_limit", "resampler", "reject_sessions"]
+
+DEFAULT_RENDER_BUDGET_WARNING_LOAD = 0.7
+DEFAULT_RENDER_BUDGET_OVERLOAD_LOAD = 0.9
+
+
+@dataclass(frozen=True, slots=True)
+class RenderBudgetTransition:
+    previous_state: RenderBudgetState
+    state: RenderBudgetState
+    load: float
+
+
+class RenderBudgetMonitor:
+    """Tracks how much of the real-time budget a session's renders consume.
+
+    Load is render wall time divided by the duration of the audio it produced, smoothed with an EWMA.
+    A load of 1.0 means rendering only just keeps up with playback. The state rises to ``warning`` or
+    ``overloaded`` as soon as the smoothed load crosses a threshold. It falls back only once the load
+    drops below ``_RECOVERY_FACTOR`` times that threshold, so a session hovering at a threshold does not
+    flap. The render thread observes; the event loop takes the latest unreported transition.
+    """
+
+    _SMOOTHING = 0.2
+    _RECOVERY_FACTOR = 0.8
+
+    def __init__(
+        self,
+        *,
+        warning_load: float = DEFAULT_RENDER_BUDGET_WARNING_LOAD,
+        overload_load: float = DEFAULT_RENDER_BUDGET_OVERLOAD_LOAD,
+    ) -> None:
+        self._warning_load = float(warning_load)
+        self._overload_load = max(self._warning_load, float(overload_load))
+        self._lock = threading.Lock()
+        self._load: float | None = None
+        self._state: RenderBudgetState = "ok"
+        self._reported_state: RenderBudgetState = "ok"
+
+    @property
+    def load(self) -> float | None:
+        with self._lock:
+            return self._load
+
+    @property
+    def state(self) -> RenderBudgetState:
+        with self._lock:
+            return self._state
+
+    def observe(self, *, wall_ns: int, frames: int, sample_rate: int) -> None:
+        if frames <= 0 or sample_rate <= 0:
+            return
+        audio_ns = frames * 1_000_000_000 / sample_rate
+        sample_load = max(0, int(wall_ns)) / audio_ns
+        with self._lock:
+            if self._load is None:
+                self._load = sample_load
+            else:
+                self._load += self._SMOOTHING * (sample_load - self._load)
+            self._state = self._next_state_locked(self._load)
+
+    def take_transition(self) -> RenderBudgetTransition | None:
+        """Returns the state change since the last call, or ``None`` when the state is unchanged."""
+
+        with self._lock:
+            if self._state == self._reported_state:
+                return None
+            transition = RenderBudgetTransition(
+                previous_state=self._reported_state,
+                state=self._state,
+                load=self._load or 0.0,
+            )
+            self._reported_state = self._state
+            return transition
+
+    def _next_state_locked(self, load: float) -> RenderBudgetState:
+        state = self._state
+        if load >= self._overload_load:
+            return "overloaded"
+        if state == "overloaded" and load >= self._overload_load * self._RECOVERY_FACTOR:
+            return "overloaded"
+        if load >= self._warning_load:
+            return "warning"
+        if state != "ok" and load >= self._warning_load * self._RECOVERY_FACTOR:
+            return "warning"
+        return "ok"
@@ -0,0 +1,221 @@
+from __future__ import annotations
+
+import asyncio
+from concurrent.futures import Future
+from dataclasses import dataclass
+import logging
+import os
+import queue
+import threading
+import time
+from typing import Any, Callable
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass(slots=True)
+class _RenderTask:
+    fn: Callable[..., Any]
+    args: tuple[Any, ...]
+    kwargs: dict[str, Any]
+    future: Future[Any]
+
+
+@dataclass(slots=True)
+class RenderWorkerStats:
+    worker_index: int
+    cpu: int | None
+    queue_depth: int
+    pinned_sessions: int
+    completed_tasks: int
+    busy_ns: int
+    uptime_ns: int
+
+
+class _RenderWorker:
+    def __init__(
+        self,
+        *,
+        index: int,
+        cpu: int | None,
+        nice: int,
+        realtime_priority: int,
+    ) -> None:
+        self.index = index
+        self.cpu = cpu
+        self._nice = nice
+        self._realtime_priority = realtime_priority
+        self._queue: queue.SimpleQueue[_RenderTask | None] = queue.SimpleQueue()
+        self._stats_lock = threading.Lock()
+        self._queued = 0
+        self._completed = 0
+        self._busy_ns = 0
+        self._started_ns = time.perf_counter_ns()
+        self._thread = threading.Thread(target=self._run, name=f"render-worker-{index}", daemon=True)
+
+    def start(self) -> None:
+        self._thread.start()
+
+    def submit(self, task: _RenderTask) -> None:
+        with self._stats_lock:
+            self._queued += 1
+        self._queue.put(task)
+
+    def shutdown(self, timeout: float) -> None:
+        self._queue.put(None)
+        if self._thread.is_alive():
+            self._thread.join(timeout)
+
+    def stats(self, pinned_sessions: int) -> RenderWorkerStats:
+        with self._stats_lock:
+            return RenderWorkerStats(
+                worker_index=self.index,
+                cpu=self.cpu,
+                queue_depth=self._queued,
+                pinned_sessions=pinned_sessions,
+                completed_tasks=self._completed,
+                busy_ns=self._busy_ns,
+                uptime_ns=time.perf_counter_ns() - self._started_ns,
+            )
+
+    def _run(self) -> None:
+        self._apply_thread_scheduling()
+        while True:
+            task = self._queue.get()
+            if task is None:
+                return
+            started_ns = time.perf_counter_ns()
+            if task.future.set_running_or_notify_cancel():
+                try:
+                    result = task.fn(*task.args, **task.kwargs)
+                except BaseException as exc:
+                    task.future.set_exception(exc)
+                else:
+                    task.future.set_result(result)
+            elapsed_ns = time.perf_counter_ns() - started_ns
+            with self._stats_lock:
+                self._queued -= 1
+                self._completed += 1
+                self._busy_ns += elapsed_ns
+
+    def _apply_thread_scheduling(self) -> None:
+        # pid 0 targets the calling thread for the Linux scheduling syscalls below.
+        if self.cpu is not None and hasattr(os, "sched_setaffinity"):
+            try:
+                os.sched_setaffinity(0, {self.cpu})
+            except OSError as exc:
+                logger.warning("Could not pin render worker %d to CPU %d: %s", self.index, self.cpu, exc)
+        if self._realtime_priority > 0 and hasattr(os, "sched_setscheduler"):
+            try:
+                os.sched_setscheduler(0, os.SCHED_FIFO, os.sched_param(self._realtime_priority))
+                return
+            except OSError as exc:
+                logger.warning("Could not enable SCHED_FIFO for render worker %d: %s", self.index, exc)
+        if self._nice != 0 and hasattr(os, "setpriority"):
+            try:
+                os.setpriority(os.PRIO_PROCESS, threading.get_native_id(), self._nice)
+            except OSError as exc:
+                logger.warning("Could not set niceness %d for render worker %d: %s", self._nice, self.index, exc)
+
+
+class RenderExecutor:
+    """Fixed pool of render threads with per-session affinity.
+
+    Browser-clock rendering used to share asyncio's default executor with SQLite, bundle import and asset GC work.
+    Each session is pinned to one worker on first use, so its Csound instance keeps running on the same thread
+    (and optionally the same CPU), and render deadlines never queue behind unrelated blocking calls.
+    """
+
+    def __init__(
+        self,
+        *,
+        worker_count: int = 0,
+        pin_cpus: bool = False,
+        nice: int = 0,
+        realtime_priority: int = 0,
+    ) -> None:
+        count = worker_count if worker_count > 0 else physical_core_count()
+        cpus = sorted(os.sched_getaffinity(0)) if pin_cpus and hasattr(os, "sched_getaffinity") else []
+        self._workers = [
+            _RenderWorker(
+                index=index,
+                cpu=cpus[index % len(cpus)] if cpus else None,
+                nice=nice,
+                realtime_priority=realtime_priority,
+            )
+            for index in range(max(1, count))
+        ]
+        self._lock = threading.Lock()
+        self._session_workers: dict[str, _RenderWorker] = {}
+        self._started = False
+        self._closed = False
+
+    @property
+    def worker_count(self) -> int:
+        return len(self._workers)
+
+    def submit(self, session_id: str, fn: Callable[..., Any], /, *args: Any, **kwargs: Any) -> Future[Any]:
+        future: Future[Any] = Future()
+        with self._lock:
+            if self._closed:
+                raise RuntimeError("Render executor has been shut down.")
+            if not self._started:
+                for worker in self._workers:
+                    worker.start()
+                self._started = True
+            worker = self._worker_for_session_unlocked(session_id)
+        worker.submit(_RenderTask(fn=fn, args=args, kwargs=kwargs, future=future))
+        return future
+
+    async def run(self, session_id: str, fn: Callable[..., Any], /, *args: Any, **kwargs: Any) -> Any:
+        return await asyncio.wrap_future(self.submit(session_id, fn, *args, **kwargs))
+
+    def release_session(self, session_id: str) -> None:
+        with self._lock:
+            self._session_workers.pop(session_id, None)
+
+    def stats(self) -> list[RenderWorkerStats]:
+        with self._lock:
+            pinned: dict[int, int] = {}
+            for worker in self._session_workers.values():
+                pinned[worker.index] = pinned.get(worker.index, 0) + 1
+        return [worker.stats(pinned.get(worker.index, 0)) for worker in self._workers]
+
+    def shutdown(self, timeout: float = 1.0) -> None:
+        with self._lock:
+            if self._closed:
+                return
+            self._closed = True
+            started = self._started
+        if started:
+            for worker in self._workers:
+                worker.shutdown(timeout)
+
+    def _worker_for_session_unlocked(self, session_id: str) -> _RenderWorker:
+        worker = self._session_workers.get(session_id)
+        if worker is not None:
+            return worker
+        load = {item.index: 0 for item in self._workers}
+        for assigned in self._session_workers.values():
+            load[assigned.index] += 1
+        worker = min(self._workers, key=lambda item: (load[item.index], item.index))
+        self._session_workers[session_id] = worker
+        return worker
+
+
+def physical_core_count() -> int:
+    logical = os.cpu_count() or 1
+    try:
+        with open("/proc/cpuinfo", encoding="utf-8") as handle:
+            cores: set[tuple[str, str]] = set()
+            physical_id = ""
+            for line in handle:
+                key, _, value = line.partition(":")
+                key = key.strip()
+                if key == "physical id":
+                    physical_id = value.strip()
+                elif key == "core id":
+                    cores.add((physical_id, value.strip()))
+    except OSError:
+        return logical
+    return max(1, min(logical, len(cores))) if cores else logical
@@ -0,0 +1,172 @@
+from __future__ import annotations
+
+from bisect import bisect_left
+from collections.abc import Iterable
+from dataclasses import dataclass
+import threading
+
+OPENMETRICS_CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+# Upper bounds in seconds. A 64-frame block at 48 kHz lasts about 1.3 ms, so the buckets are densest there.
+DURATION_BUCKETS_SECONDS = (
+    0.000_025,
+    0.000_05,
+    0.000_1,
+    0.000_25,
+    0.000_5,
+    0.001,
+    0.002_5,
+    0.005,
+    0.01,
+    0.025,
+    0.05,
+    0.1,
+    0.25,
+)
+MIDI_EVENT_COUNT_BUCKETS = (0.0, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0, 128.0)
+
+
+@dataclass(frozen=True, slots=True)
+class RenderHistogramSnapshot:
+    bounds: tuple[float, ...]
+    counts: tuple[int, ...]
+    total: float
+    count: int
+
+    @property
+    def mean(self) -> float | None:
+        return (self.total / self.count) if self.count > 0 else None
+
+    def quantile(self, fraction: float) -> float | None:
+        """Upper bound of the bucket holding the ``fraction`` quantile, or ``None`` past the last bound."""
+
+        if self.count <= 0:
+            return None
+        rank = fraction * self.count
+        cumulative = 0
+        for bound, bucket_count in zip(self.bounds, self.counts):
+            cumulative += bucket_count
+            if cumulative >= rank:
+                return bound
+        return None
+
+
+class RenderHistogram:
+    """Fixed-bucket histogram safe for concurrent writers.
+
+    ``observe`` is a bisect and three increments under an uncontended lock. Writers can be on different
+    threads: ``encode`` is recorded by the render thread on the synchronous path and by the event loop
+    when it reads from render-ahead, and the render-ahead thread and the render executor can both drive
+    the per-block histograms. ``snapshot`` takes the same lock, so ``total``, ``count`` and the buckets
+    always agree.
+    """
+
+    __slots__ = ("_bounds", "_counts", "_total", "_count", "_lock")
+
+    def __init__(self, bounds: tuple[float, ...]) -> None:
+        self._bounds = bounds
+        self._counts = [0] * (len(bounds) + 1)
+        self._total = 0.0
+        self._count = 0
+        self._lock = threading.Lock()
+
+    def observe(self, value: float) -> None:
+        index = bisect_left(self._bounds, value)
+        with self._lock:
+            self._counts[index] += 1
+            self._total += value
+            self._count += 1
+
+    def snapshot(self) -> RenderHistogramSnapshot:
+        with self._lock:
+            return RenderHistogramSnapshot(
+                bounds=self._bounds,
+                counts=tuple(self._counts),
+                total=self._total,
+                count=self._count,
+            )
+
+
+class RenderLoopMetrics:
+    """Always-on per-session render loop histograms.
+
+    The render thread records ``performKsmps`` per k-cycle, ``before_block`` per render block (sequencer
+    and arpeggiator ticks), and drained MIDI events per render block. Resample and PCM conversion time is
+    recorded per rendered chunk. Render queue wait runs from socket receipt of ``request_render`` until
+    rendering starts, and is recorded on the event loop.
+    """
+
+    __slots__ = ("perform_ksmps", "before_block", "encode", "render_queue_wait", "midi_events_per_block")
+
+    def __init__(self) -> None:
+        self.perform_ksmps = RenderHistogram(DURATION_BUCKETS_SECONDS)
+        self.before_block = RenderHistogram(DURATION_BUCKETS_SECONDS)
+        self.encode = RenderHistogram(DURATION_BUCKETS_SECONDS)
+        self.render_queue_wait = RenderHistogram(DURATION_BUCKETS_SECONDS)
+        self.midi_events_per_block = RenderHistogram(MIDI_EVENT_COUNT_BUCKETS)
+
+    def compact_stats(self) -> dict[str, object]:
+        """Returns ``{count, mean, p50, p99}`` per histogram, with durations in ms."""
+
+        return {
+            "perform_ksmps_ms": _compact_summary(self.perform_ksmps.snapshot(), scale=1_000.0),
+            "before_block_ms": _compact_summary(self.before_block.snapshot(), scale=1_000.0),
+            "encode_ms": _compact_summary(self.encode.snapshot(), scale=1_000.0),
+            "render_queue_wait_ms": _compact_summary(self.render_queue_wait.snapshot(), scale=1_000.0),
+            "midi_events_per_block": _compact_summary(self.midi_events_per_block.snapshot(), scale=1.0),
+        }
+
+
+_HISTOGRAM_FAMILIES = (
+    ("perform_ksmps", "visualcsound_render_perform_ksmps_seconds", "Csound performKsmps duration per k-cycle."),
+    ("before_block", "visualcsound_render_before_block_seconds", "Sequencer and arpeggiator work per render block."),
+    ("encode", "visualcsound_render_encode_seconds", "Resample and PCM conversion time per rendered chunk."),
+    ("render_queue_wait", "visualcsound_render_queue_wait_seconds", "Wait from request_render receipt to render."),
+    ("midi_events_per_block", "visualcsound_render_midi_events_per_block", "MIDI events drained per render block."),
+)
+
+
+def format_openmetrics(
+    sessions: Iterable[tuple[str, RenderLoopMetrics, int]],
+) -> str:
+    """Formats ``(session_id, metrics, midi_overflow_count)`` rows as OpenMetrics text exposition."""
+
+    rows = list(sessions)
+    lines: list[str] = []
+    for attribute, name, help_text in _HISTOGRAM_FAMILIES:
+        lines.append(f"# TYPE {name} histogram")
+        lines.append(f"# HELP {name} {help_text}")
+        for session_id, metrics, _overflow_count in rows:
+            snapshot = getattr(metrics, attribute).snapshot()
+            label = f'session_id="{_escape_label(session_id)}"'
+            cumulative = 0
+            for bound, bucket_count in zip(snapshot.bounds, snapshot.counts):
+                cumulative += bucket_count
+                lines.append(f'{name}_bucket{{{label},le="{bound!r}"}} {cumulative}')
+            lines.append(f'{name}_bucket{{{label},le="+Inf"}} {snapshot.count}')
+            lines.append(f"{name}_count{{{label}}} {snapshot.count}")
+            lines.append(f"{name}_sum{{{label}}} {snapshot.total!r}")
+
+    overflow_name = "visualcsound_midi_scheduler_overflow"
+    lines.append(f"# TYPE {overflow_name} counter")
+    lines.append(f"# HELP {overflow_name} MIDI events rejected because the engine scheduler queue was full.")
+    for session_id, _metrics, overflow_count in rows:
+        lines.append(f'{overflow_name}_total{{session_id="{_escape_label(session_id)}"}} {overflow_count}')
+    lines.append("# EOF")
+    return "\n".join(lines) + "\n"
+
+
+def _compact_summary(snapshot: RenderHistogramSnapshot, *, scale: float) -> dict[str, object]:
+    def scaled(value: float | None) -> float | None:
+        return None if value is None else value * scale
+
+    return {
+        "count": snapshot.count,
+        "mean": scaled(snapshot.mean),
+        "p50": scaled(snapshot.quantile(0.50)),
+        "p99": scaled(snapshot.quantile(0.99)),
+    }
+
+
+def _escape_label(value: str) -> str:
+    return value.replace("\\", "\\\\").replace('"', '\\"').replace("\n", "\\n")
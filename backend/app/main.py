@@ -18,6 +18,10 @@ from backend.app.api.persisted_json_request_limits import PersistedJsonRequestLi
 from backend.app.core.config import Settings, get_settings
 from backend.app.core.container import AppContainer
 from backend.app.core.logging import configure_logging
+from backend.app.engine.csound_pool import CsoundInstancePool
+from backend.app.engine.offline_render import OfflineCsoundRenderer
+from backend.app.engine.render_executor import RenderExecutor
+from backend.app.services.compile_cache import CompiledInstrumentCache
 from backend.app.services.compiler_service import CompilerService
 from backend.app.services.app_state_service import AppStateService
 from backend.app.services.event_bus import SessionEventBus
@@ -69,11 +73,34 @@ def _build_container(settings: Settings) -> AppContainer:
         max_config_bytes=settings.performance_config_max_bytes,
         max_string_bytes=settings.persisted_json_string_max_bytes,
     )
-    compiler_service = CompilerService(opcode_service=opcode_service, gen_asset_service=gen_asset_service)
+    compiler_service = CompilerService(
+        opcode_service=opcode_service,
+        gen_asset_service=gen_asset_service,
+        compile_cache=CompiledInstrumentCache(
+            max_entries=settings.compile_cache_max_entries,
+            cache_dir=settings.compile_cache_dir,
+        ),
+    )
     midi_service = MidiService()
     event_bus = SessionEventBus(
         max_subscriptions_total=settings.session_event_ws_max_subscriptions_total,
         max_subscriptions_per_session=settings.session_event_ws_max_subscriptions_per_session,
+        ring_capacity=settings.session_event_ring_capacity,
+    )
+    render_executor = RenderExecutor(
+        worker_count=settings.render_executor_workers,
+        pin_cpus=settings.render_executor_pin_cpus,
+        nice=settings.render_executor_nice,
+        realtime_priority=settings.render_executor_realtime_priority,
+    )
+    csound_pool = CsoundInstancePool(
+        size=settings.csound_pool_size,
+        gen_audio_assets_dir=str(settings.gen_audio_assets_dir),
+    )
+    csound_pool.start()
+    offline_renderer = OfflineCsoundRenderer(
+        max_workers=settings.offline_render_workers,
+        max_render_seconds=settings.offline_render_timeout_seconds,
     )
     session_service = SessionService(
         settings=settings,
@@ -81,6 +108,8 @@ def _build_container(settings: Settings) -> AppContainer:
         compiler_service=compiler_service,
         midi_service=midi_service,
         event_bus=event_bus,
+        render_executor=render_executor,
+        csound_pool=csound_pool,
     )
 
     container = AppContainer(
@@ -97,6 +126,9 @@ def _build_container(settings: Settings) -> AppContainer:
         compiler_service=compiler_service,
         midi_service=midi_service,
         event_bus=event_bus,
+        render_executor=render_executor,
+        csound_pool=csound_pool,
+        offline_renderer=offline_renderer,
         session_service=session_service,
     )
     referenced_assets = collect_persisted_gen_audio_stored_names(
@@ -118,6 +150,9 @@ async def lifespan(app: FastAPI):
 
     app.state.container = _build_container(settings)
     yield
+    app.state.container.render_executor.shutdown()
+    app.state.container.csound_pool.close()
+    app.state.container.offline_renderer.close()
 
 
 def create_app() -> FastAPI:
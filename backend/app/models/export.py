@@ -22,7 +22,6 @@ from backend.app.models.source_text import reject_control_characters
 OFFLINE_CSD_EXPORT_MAX_PLAYBACK_STEPS = 65_536
 OFFLINE_CSD_EXPORT_MAX_MIDI_EVENTS = 200_000
 OFFLINE_CSD_EXPORT_MAX_STEP_NOTES = 16
-OFFLINE_CSD_EXPORT_MAX_WALL_SECONDS = 5.0
 _OFFLINE_TRANSPORT_STEPS_PER_BEAT = 8
 _OFFLINE_TRANSPORT_SUBUNITS_PER_STEP = 420
 _OFFLINE_TRANSPORT_SUBUNITS_PER_BEAT = _OFFLINE_TRANSPORT_STEPS_PER_BEAT * _OFFLINE_TRANSPORT_SUBUNITS_PER_STEP
@@ -119,6 +118,7 @@ class PerformanceCsdExportRequest(BaseModel):
     performance_export: PerformanceExportPayload = Field(alias="performanceExport")
     sequencer_config: SessionSequencerConfigRequest = Field(alias="sequencerConfig")
     event_source: Literal["midiFile", "score"] = Field(default="midiFile", alias="eventSource")
+    render_audio: bool = Field(default=False, alias="renderAudio")
     midi_controllers: list[PerformanceCsdMidiControllerState] = Field(
         default_factory=list,
         alias="midiControllers",
@@ -567,6 +567,8 @@ def _estimate_controller_track_events(
         return 0
 
     pads = _pad_by_index(track.pads)
+    # Every cycle of a pad samples the same curve, so sample each pad once rather than once per cycle.
+    pad_events_by_token: dict[int, tuple[tuple[int, int], ...]] = {}
     event_count = 0
     last_value: int | None = None
     segments, _sequence_end_subunit = _iter_track_token_segments(
@@ -576,9 +578,14 @@ def _estimate_controller_track_events(
     for token, segment_start, segment_end in segments:
         if _pause_beat_count_from_token(token) is not None or token < 0:
             continue
-        pad = pads.get(token)
-        length_beats = _pad_length_beats(track, token)
-        for offset_subunit, value in _controller_pad_events(pad, length_beats=length_beats, timing=track.timing):
+        pad_events = pad_events_by_token.get(token)
+        if pad_events is None:
+            pad_events = pad_events_by_token[token] = _controller_pad_events(
+                pads.get(token),
+                length_beats=_pad_length_beats(track, token),
+                timing=track.timing,
+            )
+        for offset_subunit, value in pad_events:
             event_subunit = segment_start + offset_subunit
             if event_subunit >= segment_end:
                 break
@@ -8,3 +8,30 @@ from backend.app.models.session import SessionAudioOutputMode
 class RuntimeConfigResponse(BaseModel):
     audio_output_mode: SessionAudioOutputMode
     browser_clock_enabled: bool
+
+
+class RenderWorkerStatus(BaseModel):
+    worker_index: int
+    cpu: int | None = None
+    queue_depth: int
+    pinned_sessions: int
+    completed_tasks: int
+    busy_ms: float
+    busy_ratio: float
+
+
+class RenderExecutorStatusResponse(BaseModel):
+    worker_count: int
+    workers: list[RenderWorkerStatus]
+
+
+class CsoundPoolStatusResponse(BaseModel):
+    target_size: int
+    idle_instances: int
+    warm_acquires: int
+    cold_acquires: int
+    rtmidi_modules: dict[str, str]
+    start_count: int
+    start_latency_p50_ms: float | None = None
+    start_latency_p99_ms: float | None = None
+    start_latency_max_ms: float | None = None
@@ -72,6 +72,8 @@ def _is_valid_pad_loop_token(token: int) -> bool:
 SessionAudioOutputMode = Literal["browser_clock"]
 TimestampQuality = Literal["authoritative", "best_effort"]
 BrowserClockRenderPriority = Literal["steady", "interactive"]
+BrowserClockRenderChunkFormat = Literal["json", "binary"]
+BrowserClockPcmEncoding = Literal["f32le", "s16le", "rice24"]
 
 BROWSER_CLOCK_MAX_SAMPLE_RATE = 192_000
 BROWSER_CLOCK_MAX_QUEUE_WATERMARK_MS = 2_000
@@ -142,15 +144,31 @@ class SessionActionResponse(BaseModel):
     detail: str
 
 
+class SessionHotReloadRequest(BaseModel):
+    voice_policy: Literal["release", "cut"] = "release"
+
+
+class SessionHotReloadResponse(BaseModel):
+    session_id: str
+    state: SessionState
+    detail: str
+    swapped_instruments: list[str] = Field(default_factory=list)
+    diagnostics: list[str] = Field(default_factory=list)
+
+
 class BrowserClockClaimControllerRequest(BaseModel):
     type: Literal["claim_controller"]
     audio_context_sample_rate: int = Field(ge=1, le=BROWSER_CLOCK_MAX_SAMPLE_RATE)
     queue_low_water_frames: int = Field(ge=1)
     queue_high_water_frames: int = Field(ge=1)
     max_blocks_per_request: int = Field(ge=1, le=BROWSER_CLOCK_MAX_BLOCKS_PER_REQUEST)
+    render_chunk_format: BrowserClockRenderChunkFormat = "json"
+    pcm_encoding: BrowserClockPcmEncoding = "f32le"
 
     @model_validator(mode="after")
     def validate_queue_targets(self) -> "BrowserClockClaimControllerRequest":
+        if self.render_chunk_format == "json" and self.pcm_encoding != "f32le":
+            raise ValueError("pcm_encoding other than f32le requires render_chunk_format 'binary'.")
         if self.queue_high_water_frames <= self.queue_low_water_frames:
             raise ValueError("queue_high_water_frames must be greater than queue_low_water_frames.")
         max_queue_frames = int(
@@ -178,6 +196,11 @@ class BrowserClockClockSyncRequest(BaseModel):
     client_send_perf_ms: float = Field(ge=0.0)
 
 
+class BrowserClockRenderStatsRequest(BaseModel):
+    type: Literal["render_stats"]
+    request_id: str = Field(min_length=1, max_length=128)
+
+
 class BrowserClockReleaseControllerRequest(BaseModel):
     type: Literal["release_controller"]
 
@@ -602,6 +625,8 @@ class SessionEvent(BaseModel):
     ts: datetime = Field(default_factory=lambda: datetime.now(timezone.utc))
     type: str
     payload: dict[str, Any] = Field(default_factory=dict)
+    # Per-session publish sequence assigned by the event bus; ``None`` for per-subscriber notices.
+    seq: int | None = None
 
 
 @dataclass
@@ -6,6 +6,7 @@ import random
 import threading
 from typing import Callable, Iterable, Protocol
 
+from backend.app.engine.midi_scheduler import ScheduledMidiInput
 from backend.app.models.session import (
     SessionArpeggiatorConfig,
     SessionArpeggiatorStatus,
@@ -25,9 +26,13 @@ class TimestampedMidiEnqueue(Protocol):
         source_timestamp_ns: int | None = None,
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> bool: ...
 
 
+TimestampedMidiBatchEnqueue = Callable[..., int]
+
+
 @dataclass(frozen=True, slots=True)
 class MidiSourceContext:
     source_id: str | None = None
@@ -52,16 +57,147 @@ class PendingInputEvent:
     source_context: MidiSourceContext | None = field(default=None, compare=False)
 
 
+class HeldNoteSet:
+    """Held input notes of one arpeggiator with their pattern orders maintained incrementally.
+
+    MIDI bounds the set to 128 notes, so notes live in a fixed slot array indexed by note number. The
+    ascending and as-played orders are updated on note on/off, and the octave-expanded pattern order is
+    rebuilt only after the set changes instead of on every step.
+    """
+
+    CAPACITY = 128
+    __slots__ = ("_slots", "_ascending", "_played", "_order_sequence", "_ordered", "_ordered_key")
+
+    def __init__(self) -> None:
+        self._slots: list[HeldNote | None] = [None] * self.CAPACITY
+        self._ascending: list[int] = []
+        self._played: list[int] = []
+        self._order_sequence = 0
+        self._ordered: list[HeldNote] = []
+        self._ordered_key: tuple[str, int] | None = None
+
+    def __len__(self) -> int:
+        return len(self._ascending)
+
+    def __bool__(self) -> bool:
+        return bool(self._ascending)
+
+    def __contains__(self, note: object) -> bool:
+        return isinstance(note, int) and 0 <= note < self.CAPACITY and self._slots[note] is not None
+
+    def __iter__(self):
+        return iter(self._ascending)
+
+    def add(self, note: int, velocity: int, source_context: MidiSourceContext | None = None) -> None:
+        if self._slots[note] is None:
+            bisect.insort(self._ascending, note)
+        else:
+            self._played.remove(note)
+        self._order_sequence += 1
+        self._slots[note] = HeldNote(
+            note=note,
+            velocity=velocity,
+            order=self._order_sequence,
+            source_context=source_context,
+        )
+        self._played.append(note)
+        self._ordered_key = None
+
+    def discard(self, note: int) -> bool:
+        if self._slots[note] is None:
+            return False
+        self._slots[note] = None
+        del self._ascending[bisect.bisect_left(self._ascending, note)]
+        self._played.remove(note)
+        self._ordered_key = None
+        return True
+
+    def clear(self) -> None:
+        for note in self._ascending:
+            self._slots[note] = None
+        self._ascending.clear()
+        self._played.clear()
+        self._ordered = []
+        self._ordered_key = None
+
+    def ordered(self, pattern: str, octaves: int, rng: random.Random, *, reshuffle: bool = False) -> list[HeldNote]:
+        """Returns the cached octave-expanded step order; callers must not mutate it.
+
+        ``random`` keeps one shuffled permutation per cycle, so every held note sounds once before the
+        order is reshuffled with ``reshuffle=True``.
+        """
+
+        key = (pattern, max(1, int(octaves)))
+        if self._ordered_key != key or (reshuffle and pattern == "random"):
+            self._ordered = self._expand(self._base_order(pattern, rng), key[1])
+            self._ordered_key = key
+        return self._ordered
+
+    def _expand(self, base: list[HeldNote], octaves: int) -> list[HeldNote]:
+        if octaves == 1:
+            return base
+        expanded: list[HeldNote] = []
+        for octave in range(octaves):
+            for held in base:
+                expanded.append(
+                    HeldNote(
+                        note=_clamp_midi_note(held.note + (12 * octave)),
+                        velocity=held.velocity,
+                        order=held.order,
+                        source_context=held.source_context,
+                    )
+                )
+        return expanded
+
+    def _base_order(self, pattern: str, rng: random.Random) -> list[HeldNote]:
+        slots = self._slots
+        ascending = [slots[note] for note in self._ascending]
+        if pattern == "as_played":
+            return [slots[note] for note in self._played]
+        if pattern == "random":
+            shuffled = [slots[note] for note in self._played]
+            rng.shuffle(shuffled)
+            return shuffled
+        if pattern in {"up", "chord"}:
+            return ascending  # type: ignore[return-value]
+        descending = ascending[::-1]
+        if pattern == "down":
+            return descending  # type: ignore[return-value]
+        if pattern == "up_down":
+            return ascending + descending[1:-1]  # type: ignore[return-value]
+        if pattern == "down_up":
+            return descending + ascending[1:-1]  # type: ignore[return-value]
+        if pattern == "inside_out":
+            center = len(ascending) // 2
+            result = [ascending[center]] if ascending else []
+            for offset in range(1, len(ascending)):
+                for index in (center - offset, center + offset):
+                    if 0 <= index < len(ascending):
+                        result.append(ascending[index])
+            return result  # type: ignore[return-value]
+        if pattern == "outside_in":
+            result = []
+            left = 0
+            right = len(ascending) - 1
+            while left <= right:
+                result.append(ascending[left])
+                if right != left:
+                    result.append(ascending[right])
+                left += 1
+                right -= 1
+            return result  # type: ignore[return-value]
+        return ascending  # type: ignore[return-value]
+
+
 @dataclass(slots=True)
 class ArpeggiatorRuntimeState:
     config: SessionArpeggiatorConfig
-    held_notes: dict[int, HeldNote] = field(default_factory=dict)
+    held_notes: HeldNoteSet = field(default_factory=HeldNoteSet)
     active_note: int | None = None
     active_notes: set[int] = field(default_factory=set)
     active_note_off_sample: int | None = None
     next_step_sample: int | None = None
     step_index: int = 0
-    held_order_sequence: int = 0
     last_velocity: int | None = None
 
 
@@ -110,6 +246,28 @@ _RATE_BEATS: dict[str, float] = {
 }
 
 
+def _build_scale_quantize_table(root_pitch_class: int, intervals: tuple[int, ...]) -> tuple[int, ...]:
+    allowed = {(root_pitch_class + interval) % 12 for interval in intervals}
+    table: list[int] = []
+    for note in range(128):
+        if note % 12 in allowed:
+            table.append(note)
+            continue
+        candidates = [
+            candidate for candidate in range(max(0, note - 6), min(127, note + 6) + 1) if candidate % 12 in allowed
+        ]
+        table.append(min(candidates, key=lambda candidate: (abs(candidate - note), candidate)) if candidates else note)
+    return tuple(table)
+
+
+# Every (root pitch class, mode) pair maps all 128 notes ahead of time, so quantizing is one lookup.
+_SCALE_QUANTIZE_TABLES: dict[tuple[int, str], tuple[int, ...]] = {
+    (root_pitch_class, mode): _build_scale_quantize_table(root_pitch_class, intervals)
+    for root_pitch_class in range(12)
+    for mode, intervals in _MODE_INTERVALS.items()
+}
+
+
 def _clamp_midi_note(value: int) -> int:
     return max(0, min(127, int(value)))
 
@@ -144,8 +302,10 @@ class PerformanceMidiRouter:
         output_name: str = "engine:internal",
         max_pending_inputs: int = 16_384,
         max_future_samples: int | Callable[[], int] | None = None,
+        enqueue_timestamped_midi_batch: TimestampedMidiBatchEnqueue | None = None,
     ) -> None:
         self._enqueue_timestamped_midi = enqueue_timestamped_midi
+        self._enqueue_timestamped_midi_batch = enqueue_timestamped_midi_batch
         self._current_engine_sample = current_engine_sample
         self._output_name = output_name
         self._max_pending_inputs = max(1, int(max_pending_inputs))
@@ -290,6 +450,7 @@ class PerformanceMidiRouter:
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
         source_context: MidiSourceContext | None = None,
+        received_ns: int | None = None,
     ) -> bool:
         if len(message) != 3:
             return False
@@ -298,34 +459,12 @@ class PerformanceMidiRouter:
         with self._lock:
             arpeggiator_id = self._input_channel_to_id.get(channel)
             if arpeggiator_id is not None:
-                state = self._states.get(arpeggiator_id)
-                if state is None:
-                    return True
-                if state.config.enabled:
-                    event_sample = (
-                        max(0, int(target_engine_sample))
-                        if target_engine_sample is not None
-                        else max(0, int(self._current_engine_sample()))
-                    )
-                    if len(self._pending_inputs) >= self._max_pending_inputs:
-                        return False
-                    max_future_samples = self._max_future_sample_horizon()
-                    if max_future_samples is not None:
-                        current_sample = max(0, int(self._current_engine_sample()))
-                        if event_sample > current_sample + max_future_samples:
-                            return False
-                    self._pending_sequence += 1
-                    bisect.insort(
-                        self._pending_inputs,
-                        PendingInputEvent(
-                            target_sample=event_sample,
-                            sequence=self._pending_sequence,
-                            arpeggiator_id=arpeggiator_id,
-                            message=normalized,
-                            source_context=source_context,
-                        )
-                    )
-                return True
+                return self._capture_input_locked(
+                    arpeggiator_id,
+                    normalized,
+                    target_engine_sample=target_engine_sample,
+                    source_context=source_context,
+                )
 
         return self._enqueue_timestamped_midi(
             list(normalized),
@@ -335,8 +474,90 @@ class PerformanceMidiRouter:
             source_timestamp_ns=source_timestamp_ns,
             mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
             sync_stale=sync_stale,
+            received_ns=received_ns,
         )
 
+    def route_messages(self, inputs: list[ScheduledMidiInput], *, source: str) -> list[bool]:
+        """Routes a batch and returns per-input acceptance.
+
+        Arpeggiator inputs are captured under one lock acquisition. Everything else reaches the engine
+        scheduler in a single batch enqueue when the router has one.
+        """
+
+        accepted = [False] * len(inputs)
+        direct_indices: list[int] = []
+        direct_inputs: list[ScheduledMidiInput] = []
+        with self._lock:
+            for index, scheduled in enumerate(inputs):
+                normalized = (scheduled.message[0] & 0xFF, scheduled.message[1] & 0xFF, scheduled.message[2] & 0xFF)
+                arpeggiator_id = self._input_channel_to_id.get(_midi_channel(normalized))
+                if arpeggiator_id is None:
+                    direct_indices.append(index)
+                    direct_inputs.append(scheduled._replace(message=normalized))
+                    continue
+                accepted[index] = self._capture_input_locked(
+                    arpeggiator_id,
+                    normalized,
+                    target_engine_sample=scheduled.target_engine_sample,
+                    source_context=None,
+                )
+
+        if not direct_inputs:
+            return accepted
+        if self._enqueue_timestamped_midi_batch is not None:
+            accepted_count = self._enqueue_timestamped_midi_batch(direct_inputs, source=source)
+            for index in direct_indices[:accepted_count]:
+                accepted[index] = True
+            return accepted
+        for index, scheduled in zip(direct_indices, direct_inputs):
+            accepted[index] = self._enqueue_timestamped_midi(
+                list(scheduled.message),
+                source=source,
+                target_engine_sample=scheduled.target_engine_sample,
+                mapped_backend_monotonic_ns=scheduled.mapped_backend_monotonic_ns,
+                sync_stale=scheduled.sync_stale,
+                received_ns=scheduled.received_ns,
+            )
+        return accepted
+
+    def _capture_input_locked(
+        self,
+        arpeggiator_id: str,
+        normalized: tuple[int, ...],
+        *,
+        target_engine_sample: int | None,
+        source_context: MidiSourceContext | None,
+    ) -> bool:
+        state = self._states.get(arpeggiator_id)
+        if state is None:
+            return True
+        if not state.config.enabled:
+            return True
+        event_sample = (
+            max(0, int(target_engine_sample))
+            if target_engine_sample is not None
+            else max(0, int(self._current_engine_sample()))
+        )
+        if len(self._pending_inputs) >= self._max_pending_inputs:
+            return False
+        max_future_samples = self._max_future_sample_horizon()
+        if max_future_samples is not None:
+            current_sample = max(0, int(self._current_engine_sample()))
+            if event_sample > current_sample + max_future_samples:
+                return False
+        self._pending_sequence += 1
+        bisect.insort(
+            self._pending_inputs,
+            PendingInputEvent(
+                target_sample=event_sample,
+                sequence=self._pending_sequence,
+                arpeggiator_id=arpeggiator_id,
+                message=normalized,
+                source_context=source_context,
+            )
+        )
+        return True
+
     def _max_future_sample_horizon(self) -> int | None:
         max_future_samples = self._max_future_samples
         if max_future_samples is None:
@@ -377,7 +598,7 @@ class PerformanceMidiRouter:
                     enabled=state.config.enabled,
                     input_channel=state.config.input_channel,
                     target_channel=state.config.target_channel,
-                    held_notes=sorted(state.held_notes),
+                    held_notes=list(state.held_notes),
                     active_note=state.active_note,
                     step_index=state.step_index,
                     last_velocity=state.last_velocity,
@@ -396,14 +617,14 @@ class PerformanceMidiRouter:
             self._pending_inputs.clear()
 
     def _apply_pending_inputs_locked(self, block_start_sample: int) -> None:
-        due: list[PendingInputEvent] = []
-        pending: list[PendingInputEvent] = []
-        for event in self._pending_inputs:
-            if event.target_sample <= block_start_sample:
-                due.append(event)
-            else:
-                pending.append(event)
-        self._pending_inputs = pending
+        # Pending inputs stay sorted by target sample, so the due events are a prefix of the queue.
+        due_count = bisect.bisect_right(
+            self._pending_inputs, block_start_sample, key=lambda event: event.target_sample
+        )
+        if due_count == 0:
+            return
+        due = self._pending_inputs[:due_count]
+        del self._pending_inputs[:due_count]
 
         for event in due:
             state = self._states.get(event.arpeggiator_id)
@@ -424,15 +645,9 @@ class PerformanceMidiRouter:
 
         if status == 0x90 and velocity > 0:
             if state.config.latch and note in state.held_notes:
-                state.held_notes.pop(note, None)
+                state.held_notes.discard(note)
             else:
-                state.held_order_sequence += 1
-                state.held_notes[note] = HeldNote(
-                    note=note,
-                    velocity=velocity,
-                    order=state.held_order_sequence,
-                    source_context=source_context,
-                )
+                state.held_notes.add(note, velocity, source_context)
             if state.held_notes and (
                 state.next_step_sample is None
                 or state.config.restart_mode == "first_note"
@@ -444,7 +659,7 @@ class PerformanceMidiRouter:
 
         if status in {0x80, 0x90}:
             if not state.config.latch:
-                state.held_notes.pop(note, None)
+                state.held_notes.discard(note)
             if not state.held_notes:
                 state.next_step_sample = None
                 self._release_active_note_locked(state, event_sample)
@@ -484,7 +699,10 @@ class PerformanceMidiRouter:
         while state.next_step_sample is not None and state.next_step_sample < block_end_sample:
             step_sample = state.next_step_sample
             if state.active_note is not None:
-                self._release_active_note_locked(state, step_sample)
+                # Blocks may span several steps (offline export advances event to event), so honour the gate.
+                off_sample = state.active_note_off_sample
+                release_sample = step_sample if off_sample is None else min(off_sample, step_sample)
+                self._release_active_note_locked(state, release_sample)
 
             if self._rng.random() <= state.config.probability:
                 selected_notes = self._select_step_notes(state)
@@ -513,75 +731,27 @@ class PerformanceMidiRouter:
             swing_offset = int(round(step_samples * state.config.swing * 0.5)) if state.step_index % 2 == 1 else 0
             state.next_step_sample = step_sample + max(1, step_samples) + swing_offset
 
+        if (
+            state.active_note is not None
+            and state.active_note_off_sample is not None
+            and state.active_note_off_sample < block_end_sample
+        ):
+            self._release_active_note_locked(state, state.active_note_off_sample)
+
     def _select_step_notes(self, state: ArpeggiatorRuntimeState) -> list[HeldNote]:
-        notes = list(state.held_notes.values())
-        if not notes:
-            return []
-        ordered = self._ordered_notes(state, notes)
-        if not ordered:
+        held_notes = state.held_notes
+        if not held_notes:
             return []
-        if state.config.pattern == "chord":
+        config = state.config
+        ordered = held_notes.ordered(config.pattern, config.octaves, self._rng)
+        if config.pattern == "chord":
             return ordered
-        repeat_count = max(1, state.config.repeats)
+        repeat_count = max(1, config.repeats)
         sequence_index = state.step_index // repeat_count
+        if config.pattern == "random" and sequence_index % len(ordered) == 0 and state.step_index % repeat_count == 0:
+            ordered = held_notes.ordered(config.pattern, config.octaves, self._rng, reshuffle=True)
         return [ordered[sequence_index % len(ordered)]]
 
-    def _ordered_notes(self, state: ArpeggiatorRuntimeState, notes: list[HeldNote]) -> list[HeldNote]:
-        expanded: list[HeldNote] = []
-        base = self._base_ordered_notes(state.config.pattern, notes)
-        for octave in range(max(1, state.config.octaves)):
-            for note in base:
-                expanded_note = _clamp_midi_note(note.note + (12 * octave))
-                expanded.append(
-                    HeldNote(
-                        note=expanded_note,
-                        velocity=note.velocity,
-                        order=note.order,
-                        source_context=note.source_context,
-                    )
-                )
-        return expanded
-
-    def _base_ordered_notes(self, pattern: str, notes: list[HeldNote]) -> list[HeldNote]:
-        ascending = sorted(notes, key=lambda entry: (entry.note, entry.order))
-        descending = list(reversed(ascending))
-        played = sorted(notes, key=lambda entry: entry.order)
-
-        if pattern == "down":
-            return descending
-        if pattern == "up_down":
-            return ascending + descending[1:-1]
-        if pattern == "down_up":
-            return descending + ascending[1:-1]
-        if pattern == "as_played":
-            return played
-        if pattern == "random":
-            shuffled = played[:]
-            self._rng.shuffle(shuffled)
-            return shuffled
-        if pattern == "chord":
-            return ascending
-        if pattern == "inside_out":
-            center = len(ascending) // 2
-            result: list[HeldNote] = []
-            for offset in range(len(ascending)):
-                for index in (center - offset, center + offset):
-                    if 0 <= index < len(ascending) and ascending[index] not in result:
-                        result.append(ascending[index])
-            return result
-        if pattern == "outside_in":
-            result = []
-            left = 0
-            right = len(ascending) - 1
-            while left <= right:
-                result.append(ascending[left])
-                if right != left:
-                    result.append(ascending[right])
-                left += 1
-                right -= 1
-            return result
-        return ascending
-
     def _output_note_for(self, state: ArpeggiatorRuntimeState, held_note: HeldNote) -> int:
         note = _clamp_midi_note(held_note.note + state.config.transpose)
         if not state.config.scale_quantize:
@@ -643,16 +813,10 @@ class PerformanceMidiRouter:
 
     @staticmethod
     def _quantize_note_to_scale(note: int, root: SequencerScaleRoot, mode: SequencerMode) -> int:
-        root_pc = _ROOT_PITCH_CLASS.get(root, 0)
-        intervals = _MODE_INTERVALS.get(mode, _MODE_INTERVALS["aeolian"])
-        allowed = {((root_pc + interval) % 12) for interval in intervals}
-        if note % 12 in allowed:
-            return _clamp_midi_note(note)
-        candidates = range(max(0, note - 6), min(127, note + 6) + 1)
-        allowed_candidates = [candidate for candidate in candidates if candidate % 12 in allowed]
-        if not allowed_candidates:
-            return _clamp_midi_note(note)
-        return min(allowed_candidates, key=lambda candidate: (abs(candidate - note), candidate))
+        table = _SCALE_QUANTIZE_TABLES[
+            (_ROOT_PITCH_CLASS.get(root, 0), mode if mode in _MODE_INTERVALS else "aeolian")
+        ]
+        return table[_clamp_midi_note(note)]
 
     def panic(self) -> None:
         with self._lock:
@@ -0,0 +1,184 @@
+from __future__ import annotations
+
+from collections import OrderedDict
+from dataclasses import asdict
+import hashlib
+import json
+import logging
+import os
+from pathlib import Path
+import tempfile
+import threading
+
+from backend.app.models.patch import PatchGraph
+from backend.app.services import compiler_common, compiler_formula, compiler_graph, compiler_orchestra
+from backend.app.services.compiler_common import (
+    GEN_NODES_LAYOUT_KEY,
+    SFLOAD_NODES_LAYOUT_KEY,
+    CompiledInstrumentLines,
+    SfloadGlobalRequest,
+)
+
+logger = logging.getLogger(__name__)
+
+_COMPILER_SOURCE_DIGEST: str | None = None
+
+
+def compiler_source_digest() -> str:
+    """Hash of the compiler modules, so cached output never outlives the code that emitted it."""
+
+    global _COMPILER_SOURCE_DIGEST
+    if _COMPILER_SOURCE_DIGEST is None:
+        digest = hashlib.sha256()
+        for module in (compiler_common, compiler_formula, compiler_graph, compiler_orchestra):
+            digest.update(Path(module.__file__ or "").read_bytes())
+        _COMPILER_SOURCE_DIGEST = digest.hexdigest()
+    return _COMPILER_SOURCE_DIGEST
+
+
+def graph_uses_backend_assets(graph: PatchGraph) -> bool:
+    """True when compiling ``graph`` resolves uploaded assets.
+
+    Those compiles check asset files and create GEN01 aliases on disk, so they must run every time.
+    """
+
+    return any(
+        _contains_key(graph.ui_layout.get(layout_key), "stored_name")
+        for layout_key in (GEN_NODES_LAYOUT_KEY, SFLOAD_NODES_LAYOUT_KEY)
+    )
+
+
+def _contains_key(value: object, key: str) -> bool:
+    if isinstance(value, dict):
+        return key in value or any(_contains_key(item, key) for item in value.values())
+    if isinstance(value, list):
+        return any(_contains_key(item, key) for item in value)
+    return False
+
+
+def instrument_cache_key(graph: PatchGraph, *, opcode_catalog_digest: str, **emit_options: object) -> str:
+    """Canonical content hash of one instrument compile.
+
+    The graph is dumped to sorted-key JSON, so dict ordering and model construction do not change the key.
+    """
+
+    payload = {
+        "compiler": compiler_source_digest(),
+        "opcodes": opcode_catalog_digest,
+        "graph": graph.model_dump(mode="json", by_alias=True),
+        "options": emit_options,
+    }
+    encoded = json.dumps(payload, sort_keys=True, separators=(",", ":"), ensure_ascii=False, default=str)
+    return hashlib.sha256(encoded.encode("utf-8")).hexdigest()
+
+
+class CompiledInstrumentCache:
+    """Content-addressed cache of emitted instrument lines.
+
+    An LRU dict serves repeated compiles in-process. With ``cache_dir`` set, entries are also written as
+    JSON files, so restarts start warm. A damaged or unreadable file counts as a miss.
+    """
+
+    def __init__(self, *, max_entries: int = 512, cache_dir: Path | None = None) -> None:
+        self._max_entries = max(0, int(max_entries))
+        self._cache_dir = cache_dir
+        self._entries: OrderedDict[str, CompiledInstrumentLines] = OrderedDict()
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+
+    @property
+    def enabled(self) -> bool:
+        return self._max_entries > 0
+
+    def get(self, key: str) -> CompiledInstrumentLines | None:
+        if not self.enabled:
+            return None
+        with self._lock:
+            cached = self._entries.get(key)
+            if cached is not None:
+                self._entries.move_to_end(key)
+                self.hits += 1
+                return _copy_lines(cached)
+        cached = self._read_disk_entry(key)
+        with self._lock:
+            if cached is None:
+                self.misses += 1
+                return None
+            self.hits += 1
+            self._store_locked(key, cached)
+        return _copy_lines(cached)
+
+    def put(self, key: str, lines: CompiledInstrumentLines) -> None:
+        if not self.enabled:
+            return
+        stored = _copy_lines(lines)
+        with self._lock:
+            self._store_locked(key, stored)
+        self._write_disk_entry(key, stored)
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
+
+    def __len__(self) -> int:
+        with self._lock:
+            return len(self._entries)
+
+    def _store_locked(self, key: str, lines: CompiledInstrumentLines) -> None:
+        self._entries[key] = lines
+        self._entries.move_to_end(key)
+        while len(self._entries) > self._max_entries:
+            self._entries.popitem(last=False)
+
+    def _entry_path(self, key: str) -> Path | None:
+        if self._cache_dir is None:
+            return None
+        return self._cache_dir / key[:2] / f"{key}.json"
+
+    def _read_disk_entry(self, key: str) -> CompiledInstrumentLines | None:
+        path = self._entry_path(key)
+        if path is None:
+            return None
+        try:
+            raw = json.loads(path.read_text(encoding="utf-8"))
+            return CompiledInstrumentLines(
+                instrument_lines=[str(line) for line in raw["instrument_lines"]],
+                sfload_global_requests=[SfloadGlobalRequest(**request) for request in raw["sfload_global_requests"]],
+                global_header_lines=[str(line) for line in raw["global_header_lines"]],
+                diagnostics=[str(line) for line in raw["diagnostics"]],
+            )
+        except FileNotFoundError:
+            return None
+        except (OSError, ValueError, KeyError, TypeError):
+            logger.warning("Ignoring unreadable compile cache entry %s", path)
+            return None
+
+    def _write_disk_entry(self, key: str, lines: CompiledInstrumentLines) -> None:
+        path = self._entry_path(key)
+        if path is None:
+            return
+        try:
+            path.parent.mkdir(parents=True, exist_ok=True)
+            descriptor, temp_name = tempfile.mkstemp(dir=path.parent, prefix=".", suffix=".tmp")
+            try:
+                with os.fdopen(descriptor, "w", encoding="utf-8") as handle:
+                    json.dump(asdict(lines), handle, separators=(",", ":"))
+                os.replace(temp_name, path)
+            except BaseException:
+                Path(temp_name).unlink(missing_ok=True)
+                raise
+        except OSError:
+            logger.warning("Failed to write compile cache entry %s", path, exc_info=True)
+
+
+def _copy_lines(lines: CompiledInstrumentLines) -> CompiledInstrumentLines:
+    return CompiledInstrumentLines(
+        instrument_lines=list(lines.instrument_lines),
+        sfload_global_requests=[
+            SfloadGlobalRequest(node_id=request.node_id, var_name=request.var_name, filename=request.filename)
+            for request in lines.sfload_global_requests
+        ],
+        global_header_lines=list(lines.global_header_lines),
+        diagnostics=list(lines.diagnostics),
+    )
@@ -13,6 +13,7 @@ from backend.app.services.compiler_common import (
     SfloadGlobalRequest,
 )
 from backend.app.services.audio_port_names import audio_port_names
+from backend.app.services.compile_cache import CompiledInstrumentCache, graph_uses_backend_assets, instrument_cache_key
 from backend.app.services.compiler_graph import compile_graph_context, resolve_shared_engine, validate_target_channels
 from backend.app.services.compiler_orchestra import OrchestraEmitter, wrap_csd
 from backend.app.services.gen_asset_service import GenAssetService
@@ -25,9 +26,15 @@ class CompilerService:
         self,
         opcode_service: OpcodeService,
         gen_asset_service: GenAssetService | None = None,
+        compile_cache: CompiledInstrumentCache | None = None,
     ) -> None:
         self._opcode_service = opcode_service
         self._orchestra_emitter = OrchestraEmitter(gen_asset_service=gen_asset_service)
+        self._compile_cache = compile_cache if compile_cache is not None else CompiledInstrumentCache()
+
+    @property
+    def compile_cache(self) -> CompiledInstrumentCache:
+        return self._compile_cache
 
     def compile_patch(
         self,
@@ -87,16 +94,12 @@ class CompilerService:
         diagnostics: list[str] = []
 
         for instrument_number, target in enumerate(targets, start=1):
-            graph_context = compile_graph_context(target.patch.graph, self._opcode_service)
-            compiled_lines = self._orchestra_emitter.compile_instrument_lines(
-                target.patch,
-                graph_context=graph_context,
+            compiled_lines = self._compile_instrument(
+                target,
                 instrument_number=instrument_number,
                 instrument_name=instrument_names[instrument_number - 1] if instrument_names is not None else None,
-                global_scope_key=f"{instrument_number}_{target.patch.id}",
                 allow_packaged_asset_paths=allow_packaged_asset_paths,
                 performance_input_mode=performance_input_mode,
-                score_midi_channel=target.midi_channel,
             )
             compiled_instruments.append((instrument_number, target, compiled_lines))
             global_header_lines.extend(compiled_lines.global_header_lines)
@@ -146,6 +149,45 @@ class CompilerService:
         )
         return CompileArtifact(orc=orc, csd=csd, diagnostics=diagnostics)
 
+    def _compile_instrument(
+        self,
+        target: PatchInstrumentTarget,
+        *,
+        instrument_number: int,
+        instrument_name: str | None,
+        allow_packaged_asset_paths: bool,
+        performance_input_mode: str,
+    ) -> CompiledInstrumentLines:
+        graph = target.patch.graph
+        emit_options = {
+            "instrument_number": instrument_number,
+            "instrument_name": instrument_name,
+            "global_scope_key": f"{instrument_number}_{target.patch.id}",
+            "allow_packaged_asset_paths": allow_packaged_asset_paths,
+            "performance_input_mode": performance_input_mode,
+            "score_midi_channel": target.midi_channel,
+        }
+        cache_key: str | None = None
+        if self._compile_cache.enabled and not graph_uses_backend_assets(graph):
+            cache_key = instrument_cache_key(
+                graph,
+                opcode_catalog_digest=self._opcode_service.catalog_digest,
+                **emit_options,
+            )
+            cached = self._compile_cache.get(cache_key)
+            if cached is not None:
+                return cached
+
+        graph_context = compile_graph_context(graph, self._opcode_service)
+        compiled_lines = self._orchestra_emitter.compile_instrument_lines(
+            target.patch,
+            graph_context=graph_context,
+            **emit_options,  # type: ignore[arg-type]
+        )
+        if cache_key is not None:
+            self._compile_cache.put(cache_key, compiled_lines)
+        return compiled_lines
+
     @staticmethod
     def _instrument_names(targets: list[PatchInstrumentTarget]) -> list[str] | None:
         if not any(target.always_on or target.effect_source_ids or target.effect_routes for target in targets):
@@ -2,9 +2,16 @@ from __future__ import annotations
 
 import asyncio
 from dataclasses import dataclass
+import time
 
 from backend.app.models.session import SessionEvent
 
+DEFAULT_SESSION_EVENT_RING_CAPACITY = 256
+MAX_SEQUENCER_FRAME_MS = 1000.0
+
+# Event types that carry a complete transport snapshot, so a newer one supersedes an older one for display.
+COALESCIBLE_EVENT_TYPES = frozenset({"sequencer_step"})
+
 
 class SessionEventSubscriptionLimitExceededError(RuntimeError):
     pass
@@ -15,72 +22,261 @@ class SessionEventBusStats:
     session_count: int
     subscription_count: int
     subscriptions_by_session: dict[str, int]
+    lagged_events_total: int = 0
+    coalesced_events_total: int = 0
+
+
+class SessionEventRing:
+    """Fixed-capacity ring of serialized events for one session, shared by all of its subscribers.
+
+    ``head`` is the sequence number of the next event, which is also the ``seq`` written into it. Slot
+    ``sequence % capacity`` holds event ``sequence`` until it is overwritten ``capacity`` events later.
+    Each slot keeps the JSON text and, for coalescible events, their transport time in ms. Waiting
+    subscribers share one wakeup future, so a publish costs the same regardless of how many sockets
+    observe the session.
+    """
+
+    __slots__ = ("_capacity", "_slots", "_head", "_wakeup", "subscriptions")
+
+    def __init__(self, capacity: int) -> None:
+        self._capacity = max(1, int(capacity))
+        self._slots: list[tuple[str, float | None] | None] = [None] * self._capacity
+        self._head = 0
+        self._wakeup: asyncio.Future[None] | None = None
+        self.subscriptions: set[SessionEventSubscription] = set()
+
+    @property
+    def capacity(self) -> int:
+        return self._capacity
+
+    @property
+    def head(self) -> int:
+        return self._head
+
+    def append(self, serialized: str, coalesce_time_ms: float | None = None) -> None:
+        self._slots[self._head % self._capacity] = (serialized, coalesce_time_ms)
+        self._head += 1
+        wakeup = self._wakeup
+        if wakeup is not None:
+            self._wakeup = None
+            if not wakeup.done():
+                wakeup.set_result(None)
+
+    def read(self, sequence: int) -> tuple[str, float | None]:
+        entry = self._slots[sequence % self._capacity]
+        assert entry is not None
+        return entry
+
+    def wakeup(self) -> asyncio.Future[None]:
+        if self._wakeup is None:
+            self._wakeup = asyncio.get_running_loop().create_future()
+        return self._wakeup
+
+
+class SessionEventSubscription:
+    """A subscriber cursor into a session's event ring.
+
+    A subscriber that falls more than ``capacity`` events behind skips to the oldest retained event. It
+    receives one ``events_dropped`` notice that names the skipped ``seq`` range. With a positive
+    ``sequencer_frame_ms``, a coalescible step snapshot that lands less than one frame of transport time
+    after the last snapshot this subscriber received is held back instead of sent, and a newer one replaces
+    it. The held snapshot goes out once a frame of wall time has passed without a newer frame-boundary
+    snapshot, or just before the next non-step event, so the newest transport state in a frame always
+    arrives. Snapshots that go backwards in time (seek, loop, restart) are always sent.
+    """
+
+    __slots__ = (
+        "session_id",
+        "_ring",
+        "_cursor",
+        "_sequencer_frame_ms",
+        "_last_coalesced_time_ms",
+        "_last_coalesced_sent_at",
+        "_held",
+        "lagged_events",
+        "coalesced_events",
+    )
+
+    def __init__(self, session_id: str, ring: SessionEventRing, *, sequencer_frame_ms: float = 0.0) -> None:
+        self.session_id = session_id
+        self._ring = ring
+        self._cursor = ring.head
+        self._sequencer_frame_ms = min(MAX_SEQUENCER_FRAME_MS, max(0.0, float(sequencer_frame_ms)))
+        self._last_coalesced_time_ms: float | None = None
+        self._last_coalesced_sent_at = 0.0
+        self._held: tuple[str, float] | None = None
+        self.lagged_events = 0
+        self.coalesced_events = 0
+
+    @property
+    def sequencer_frame_ms(self) -> float:
+        return self._sequencer_frame_ms
+
+    @property
+    def pending_count(self) -> int:
+        return min(self._ring.head - self._cursor, self._ring.capacity)
+
+    def next_serialized_nowait(self) -> str | None:
+        ring = self._ring
+        while True:
+            head = ring.head
+            if self._cursor >= head:
+                return None
+            oldest = head - ring.capacity
+            if self._cursor < oldest:
+                skipped_from = self._cursor
+                self.lagged_events += oldest - skipped_from
+                self._cursor = oldest
+                self._last_coalesced_time_ms = None
+                if self._held is not None:
+                    self._held = None
+                    self.coalesced_events += 1
+                return self._events_dropped_notice(skipped_from, oldest)
+            serialized, coalesce_time_ms = ring.read(self._cursor)
+            if coalesce_time_ms is None or self._sequencer_frame_ms <= 0.0:
+                # Keep seq order: a held snapshot precedes any later event.
+                if self._held is not None:
+                    return self.flush_held_nowait()
+                self._cursor += 1
+                return serialized
+            self._cursor += 1
+            last_time_ms = self._last_coalesced_time_ms
+            if last_time_ms is not None and 0.0 <= coalesce_time_ms - last_time_ms < self._sequencer_frame_ms:
+                if self._held is not None:
+                    self.coalesced_events += 1
+                self._held = (serialized, coalesce_time_ms)
+                continue
+            if self._held is not None:
+                self._held = None
+                self.coalesced_events += 1
+            self._mark_coalesced_sent(coalesce_time_ms)
+            return serialized
+
+    def flush_held_nowait(self) -> str | None:
+        """Returns the held step snapshot, if any, and counts it as delivered."""
+
+        held = self._held
+        if held is None:
+            return None
+        self._held = None
+        self._mark_coalesced_sent(held[1])
+        return held[0]
+
+    async def next_serialized(self) -> str:
+        """Returns the next event as JSON text, waiting for a publish when the cursor is caught up."""
+
+        while True:
+            serialized = self.next_serialized_nowait()
+            if serialized is not None:
+                return serialized
+            # The wakeup future is shared by every waiter; shield it so one cancelled socket task does not
+            # cancel the wakeup for the others.
+            wakeup = asyncio.shield(self._ring.wakeup())
+            if self._held is None:
+                await wakeup
+                continue
+            frame_remaining = self._last_coalesced_sent_at + self._sequencer_frame_ms / 1000.0 - time.monotonic()
+            try:
+                await asyncio.wait_for(wakeup, timeout=max(0.0, frame_remaining))
+            except asyncio.TimeoutError:
+                held = self.flush_held_nowait()
+                if held is not None:
+                    return held
+
+    def _mark_coalesced_sent(self, coalesce_time_ms: float) -> None:
+        self._last_coalesced_time_ms = coalesce_time_ms
+        self._last_coalesced_sent_at = time.monotonic()
+
+    def _events_dropped_notice(self, first_seq: int, next_seq: int) -> str:
+        return SessionEvent(
+            session_id=self.session_id,
+            type="events_dropped",
+            payload={"first_seq": first_seq, "next_seq": next_seq, "count": next_seq - first_seq},
+        ).model_dump_json()
 
 
 class SessionEventBus:
+    """Per-session broadcast of session events.
+
+    Each event gets the next per-session ``seq`` and is serialized once on publish into the session's ring.
+    Every subscriber reads it through its own cursor. All methods run on the event loop and never await
+    while touching shared state, so the bus needs no lock.
+    """
+
     def __init__(
         self,
         *,
         max_subscriptions_total: int,
         max_subscriptions_per_session: int,
+        ring_capacity: int = DEFAULT_SESSION_EVENT_RING_CAPACITY,
     ) -> None:
-        self._queues: dict[str, set[asyncio.Queue[SessionEvent]]] = {}
+        self._rings: dict[str, SessionEventRing] = {}
         self._max_subscriptions_total = max(1, int(max_subscriptions_total))
         self._max_subscriptions_per_session = max(1, int(max_subscriptions_per_session))
-        self._lock = asyncio.Lock()
-
-    async def subscribe(self, session_id: str) -> asyncio.Queue[SessionEvent]:
-        async with self._lock:
-            queues = self._queues.get(session_id)
-            session_subscription_count = len(queues) if queues is not None else 0
-            if session_subscription_count >= self._max_subscriptions_per_session:
-                raise SessionEventSubscriptionLimitExceededError(
-                    "Session event WebSocket subscription capacity reached for this session."
-                )
-            if self._subscription_count_unlocked() >= self._max_subscriptions_total:
-                raise SessionEventSubscriptionLimitExceededError(
-                    "Session event WebSocket subscription capacity reached."
-                )
-
-            queue: asyncio.Queue[SessionEvent] = asyncio.Queue(maxsize=100)
-            if queues is None:
-                queues = set()
-                self._queues[session_id] = queues
-            queues.add(queue)
-        return queue
-
-    async def unsubscribe(self, session_id: str, queue: asyncio.Queue[SessionEvent]) -> None:
-        async with self._lock:
-            queues = self._queues.get(session_id)
-            if not queues:
-                return
-            queues.discard(queue)
-            if not queues:
-                self._queues.pop(session_id, None)
+        self._ring_capacity = max(1, int(ring_capacity))
+        self._subscription_count = 0
+        self._lagged_events_released = 0
+        self._coalesced_events_released = 0
 
-    async def publish(self, event: SessionEvent) -> None:
-        async with self._lock:
-            queues = list(self._queues.get(event.session_id, set()))
+    async def subscribe(self, session_id: str, *, sequencer_frame_ms: float = 0.0) -> SessionEventSubscription:
+        ring = self._rings.get(session_id)
+        session_subscription_count = len(ring.subscriptions) if ring is not None else 0
+        if session_subscription_count >= self._max_subscriptions_per_session:
+            raise SessionEventSubscriptionLimitExceededError(
+                "Session event WebSocket subscription capacity reached for this session."
+            )
+        if self._subscription_count >= self._max_subscriptions_total:
+            raise SessionEventSubscriptionLimitExceededError(
+                "Session event WebSocket subscription capacity reached."
+            )
+
+        if ring is None:
+            ring = SessionEventRing(self._ring_capacity)
+            self._rings[session_id] = ring
+        subscription = SessionEventSubscription(session_id, ring, sequencer_frame_ms=sequencer_frame_ms)
+        ring.subscriptions.add(subscription)
+        self._subscription_count += 1
+        return subscription
 
-        for queue in queues:
-            if queue.full():
-                try:
-                    queue.get_nowait()
-                except asyncio.QueueEmpty:
-                    pass
-            await queue.put(event)
+    async def unsubscribe(self, session_id: str, subscription: SessionEventSubscription) -> None:
+        ring = self._rings.get(session_id)
+        if ring is None or subscription not in ring.subscriptions:
+            return
+        ring.subscriptions.discard(subscription)
+        self._subscription_count -= 1
+        self._lagged_events_released += subscription.lagged_events
+        self._coalesced_events_released += subscription.coalesced_events
+        if not ring.subscriptions:
+            self._rings.pop(session_id, None)
+
+    async def publish(self, event: SessionEvent) -> None:
+        ring = self._rings.get(event.session_id)
+        if ring is None:
+            return
+        event.seq = ring.head
+        ring.append(event.model_dump_json(), _coalesce_time_ms(event))
 
     async def stats(self) -> SessionEventBusStats:
-        async with self._lock:
-            subscriptions_by_session = {
-                session_id: len(queues)
-                for session_id, queues in self._queues.items()
-            }
-            return SessionEventBusStats(
-                session_count=len(subscriptions_by_session),
-                subscription_count=sum(subscriptions_by_session.values()),
-                subscriptions_by_session=subscriptions_by_session,
-            )
+        subscriptions_by_session = {
+            session_id: len(ring.subscriptions)
+            for session_id, ring in self._rings.items()
+        }
+        subscriptions = [subscription for ring in self._rings.values() for subscription in ring.subscriptions]
+        return SessionEventBusStats(
+            session_count=len(subscriptions_by_session),
+            subscription_count=self._subscription_count,
+            subscriptions_by_session=subscriptions_by_session,
+            lagged_events_total=self._lagged_events_released + sum(item.lagged_events for item in subscriptions),
+            coalesced_events_total=(
+                self._coalesced_events_released + sum(item.coalesced_events for item in subscriptions)
+            ),
+        )
+
 
-    def _subscription_count_unlocked(self) -> int:
-        return sum(len(queues) for queues in self._queues.values())
+def _coalesce_time_ms(event: SessionEvent) -> float | None:
+    if event.type not in COALESCIBLE_EVENT_TYPES or event.payload.get("running") is not True:
+        return None
+    transport_time_ms = event.payload.get("transport_time_ms")
+    if isinstance(transport_time_ms, bool) or not isinstance(transport_time_ms, (int, float)):
+        return None
+    return float(transport_time_ms)
@@ -0,0 +1,135 @@
+from __future__ import annotations
+
+from collections.abc import Iterator
+from dataclasses import dataclass
+import struct
+
+HOST_MIDI_JSON_PROTOCOL_VERSION = 1
+HOST_MIDI_BINARY_PROTOCOL_VERSION = 2
+HOST_MIDI_LATEST_PROTOCOL_VERSION = HOST_MIDI_BINARY_PROTOCOL_VERSION
+
+HOST_MIDI_FRAME_MAGIC = b"VM"
+HOST_MIDI_FRAME_KIND_EVENTS = 1
+HOST_MIDI_NO_TIMESTAMP = 0xFFFF_FFFF_FFFF_FFFF
+HOST_MIDI_MAX_DEVICE_TABLE_SIZE = 4096
+
+# All integers are little-endian.
+# Header: magic "VM", protocol version u8, frame kind u8, device definition count u16, record count u16.
+_FRAME_HEADER = struct.Struct("<2sBBHH")
+# Device definition: table index u16, UTF-8 id length u8, followed by the id bytes.
+_DEVICE_DEFINITION = struct.Struct("<HB")
+# Event record: device table index u16, helper monotonic timestamp u64 (all ones when absent), 3 MIDI bytes.
+_EVENT_RECORD = struct.Struct("<HQBBB")
+
+HOST_MIDI_EVENT_RECORD_SIZE = _EVENT_RECORD.size
+
+
+class HostMidiProtocolError(ValueError):
+    """A binary host MIDI frame is malformed or uses an unsupported version."""
+
+
+@dataclass(frozen=True, slots=True)
+class HostMidiEventFrame:
+    """Event records of one decoded frame. ``records`` unpacks lazily from the websocket payload buffer."""
+
+    record_count: int
+    _records: memoryview
+
+    def records(self) -> Iterator[tuple[int, int, int, int, int]]:
+        """Yields ``(device_index, timestamp_ns, status, data1, data2)`` per record."""
+
+        return _EVENT_RECORD.iter_unpack(self._records)
+
+
+def negotiate_host_midi_protocol_version(requested: int) -> int:
+    return max(HOST_MIDI_JSON_PROTOCOL_VERSION, min(int(requested), HOST_MIDI_LATEST_PROTOCOL_VERSION))
+
+
+def decode_host_midi_frame(payload: bytes | bytearray | memoryview, device_table: list[str]) -> HostMidiEventFrame:
+    """Validates a binary ``midi_events`` frame and applies its device definitions to ``device_table``.
+
+    The helper interns each device id once per connection. A frame carries definitions only for devices
+    it has not sent yet, and every record refers to its device by table index. The frame is validated
+    completely before the table changes, so a rejected frame leaves the connection state untouched.
+    """
+
+    view = memoryview(payload).cast("B")
+    if len(view) < _FRAME_HEADER.size:
+        raise HostMidiProtocolError("Host MIDI frame is shorter than its header.")
+    magic, version, kind, definition_count, record_count = _FRAME_HEADER.unpack_from(view, 0)
+    if magic != HOST_MIDI_FRAME_MAGIC:
+        raise HostMidiProtocolError("Host MIDI frame has an invalid magic prefix.")
+    if version != HOST_MIDI_BINARY_PROTOCOL_VERSION:
+        raise HostMidiProtocolError(f"Unsupported host MIDI frame version: {version}.")
+    if kind != HOST_MIDI_FRAME_KIND_EVENTS:
+        raise HostMidiProtocolError(f"Unsupported host MIDI frame kind: {kind}.")
+
+    offset = _FRAME_HEADER.size
+    definitions: list[tuple[int, str]] = []
+    table_size = len(device_table)
+    for _ in range(definition_count):
+        if offset + _DEVICE_DEFINITION.size > len(view):
+            raise HostMidiProtocolError("Host MIDI frame ends inside a device definition.")
+        index, id_length = _DEVICE_DEFINITION.unpack_from(view, offset)
+        offset += _DEVICE_DEFINITION.size
+        if id_length == 0 or offset + id_length > len(view):
+            raise HostMidiProtocolError("Host MIDI frame has an invalid device id length.")
+        try:
+            device_id = bytes(view[offset : offset + id_length]).decode("utf-8")
+        except UnicodeDecodeError as exc:
+            raise HostMidiProtocolError("Host MIDI device ids must be UTF-8.") from exc
+        offset += id_length
+        if index > table_size or index >= HOST_MIDI_MAX_DEVICE_TABLE_SIZE:
+            raise HostMidiProtocolError(f"Host MIDI device index {index} skips ahead of the interned table.")
+        if index == table_size:
+            table_size += 1
+        definitions.append((index, device_id))
+
+    records_length = record_count * _EVENT_RECORD.size
+    if len(view) - offset != records_length:
+        raise HostMidiProtocolError(
+            f"Host MIDI frame declares {record_count} records but carries {len(view) - offset} record bytes."
+        )
+
+    for index, device_id in definitions:
+        if index == len(device_table):
+            device_table.append(device_id)
+        else:
+            device_table[index] = device_id
+    return HostMidiEventFrame(record_count=record_count, _records=view[offset:])
+
+
+def encode_host_midi_frame(
+    events: list[tuple[str, int | None, bytes | list[int]]],
+    device_table: dict[str, int],
+) -> bytes:
+    """Encodes ``(device_id, timestamp_ns, midi)`` events the way ``host-midi-helper`` does.
+
+    ``device_table`` is the sender's interned table and is extended in place. Used by tests and tooling.
+    """
+
+    definitions = bytearray()
+    definition_count = 0
+    records = bytearray()
+    for device_id, timestamp_ns, midi in events:
+        index = device_table.get(device_id)
+        if index is None:
+            index = len(device_table)
+            device_table[device_id] = index
+            encoded_id = device_id.encode("utf-8")
+            definitions += _DEVICE_DEFINITION.pack(index, len(encoded_id))
+            definitions += encoded_id
+            definition_count += 1
+        records += _EVENT_RECORD.pack(
+            index,
+            HOST_MIDI_NO_TIMESTAMP if timestamp_ns is None else timestamp_ns,
+            *bytes(midi[:3]),
+        )
+    header = _FRAME_HEADER.pack(
+        HOST_MIDI_FRAME_MAGIC,
+        HOST_MIDI_BINARY_PROTOCOL_VERSION,
+        HOST_MIDI_FRAME_KIND_EVENTS,
+        definition_count,
+        len(events),
+    )
+    return header + bytes(definitions) + bytes(records)
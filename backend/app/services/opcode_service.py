@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import hashlib
 import json
 from collections import defaultdict
 from pathlib import Path
@@ -39,10 +40,18 @@ class StoredOpcodeSpec(BaseModel):
 class OpcodeService:
     def __init__(self, icon_prefix: str) -> None:
         self._icon_prefix = icon_prefix.rstrip("/")
+        catalog_path = self._catalog_path()
         self._opcodes = {
             opcode.name: opcode
-            for opcode in self._load_catalog(self._catalog_path(), icon_prefix=self._icon_prefix)
+            for opcode in self._load_catalog(catalog_path, icon_prefix=self._icon_prefix)
         }
+        self._catalog_digest = hashlib.sha256(catalog_path.read_bytes()).hexdigest()
+
+    @property
+    def catalog_digest(self) -> str:
+        """Content hash of the opcode catalog, used to key compiled output."""
+
+        return self._catalog_digest
 
     def list_opcodes(self, category: str | None = None) -> list[OpcodeSpec]:
         opcodes = list(self._opcodes.values())
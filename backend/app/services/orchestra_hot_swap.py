@@ -0,0 +1,136 @@
+from __future__ import annotations
+
+from dataclasses import dataclass
+import re
+from typing import Literal
+
+from backend.app.services.compiler_orchestra import OrchestraEmitter
+
+HotSwapVoicePolicy = Literal["release", "cut"]
+
+HOT_SWAP_HELPER_INSTRUMENT = "vcs_hot_swap"
+_ALWAYS_ON_PATTERN = re.compile(r'^alwayson\s+"((?:[^"\\]|\\.)*)"')
+
+
+class OrchestraHotSwapError(Exception):
+    """The new orchestra changes more than instrument bodies and needs a session restart."""
+
+
+@dataclass(frozen=True, slots=True)
+class OrchestraLayout:
+    header_lines: tuple[str, ...]
+    instruments: dict[str, str]
+    always_on_refs: frozenset[str]
+
+
+@dataclass(frozen=True, slots=True)
+class OrchestraHotSwapPlan:
+    changed_instruments: tuple[str, ...]
+    orc: str
+    score_lines: tuple[str, ...]
+
+    @property
+    def is_empty(self) -> bool:
+        return not self.changed_instruments
+
+
+def split_orchestra(orc: str) -> OrchestraLayout:
+    """Splits compiler output into the global header and one text block per ``instr ... endin``.
+
+    Comment and blank lines are dropped from the header, so patch renames in the ``; patch:`` comments
+    do not count as structural changes.
+    """
+
+    header_lines: list[str] = []
+    instruments: dict[str, str] = {}
+    always_on_refs: set[str] = set()
+    current_ref: str | None = None
+    current_lines: list[str] = []
+
+    for line in orc.splitlines():
+        if current_ref is not None:
+            current_lines.append(line)
+            if line == "endin":
+                instruments[current_ref] = "\n".join(current_lines)
+                current_ref = None
+                current_lines = []
+            continue
+        if line.startswith("instr "):
+            current_ref = line[len("instr ") :].strip()
+            current_lines = [line]
+            continue
+        stripped = line.strip()
+        if not stripped or stripped.startswith(";"):
+            continue
+        header_lines.append(stripped)
+        always_on = _ALWAYS_ON_PATTERN.match(stripped)
+        if always_on is not None:
+            always_on_refs.add(always_on.group(1).replace('\\"', '"').replace("\\\\", "\\"))
+
+    if current_ref is not None:
+        raise OrchestraHotSwapError(f"Instrument '{current_ref}' is missing 'endin'.")
+    return OrchestraLayout(
+        header_lines=tuple(header_lines),
+        instruments=instruments,
+        always_on_refs=frozenset(always_on_refs),
+    )
+
+
+def plan_orchestra_hot_swap(
+    previous_orc: str,
+    next_orc: str,
+    *,
+    voice_policy: HotSwapVoicePolicy = "release",
+) -> OrchestraHotSwapPlan:
+    """Builds the ``compileOrc`` text that moves a running engine from ``previous_orc`` to ``next_orc``.
+
+    Only changed instrument definitions are recompiled. With ``release`` active MIDI voices finish on the
+    definition they started with and new notes use the new one. With ``cut`` they get a release-enabled
+    ``turnoff2``. Always-on instruments never retrigger by themselves, so their indefinite instance is
+    released and a new one is started in the same k-cycle. The outgoing instance's release segment
+    overlaps the new instance, which crossfades instruments that declare a release.
+    """
+
+    previous = split_orchestra(previous_orc)
+    upcoming = split_orchestra(next_orc)
+    if previous.header_lines != upcoming.header_lines:
+        raise OrchestraHotSwapError("Orchestra header, routing or global tables changed; restart the session.")
+    if previous.instruments.keys() != upcoming.instruments.keys():
+        raise OrchestraHotSwapError("Instrument set changed; restart the session.")
+
+    changed = tuple(ref for ref, text in upcoming.instruments.items() if previous.instruments[ref] != text)
+    if not changed:
+        return OrchestraHotSwapPlan(changed_instruments=(), orc="", score_lines=())
+
+    helper_lines: list[str] = []
+    for ref in changed:
+        instrument = _instrument_operand(ref)
+        if ref in upcoming.always_on_refs:
+            # kmode 8 only releases indefinite-duration instances, which is what alwayson starts.
+            helper_lines.append(f"turnoff2 {instrument}, 8, 1")
+            helper_lines.append(f'event "i", {instrument}, 0, -1')
+        elif voice_policy == "cut":
+            helper_lines.append(f"turnoff2 {instrument}, 0, 1")
+
+    orc_blocks = [upcoming.instruments[ref] for ref in changed]
+    score_lines: tuple[str, ...] = ()
+    if helper_lines:
+        orc_blocks.append(
+            "\n".join(
+                [
+                    f"instr {HOT_SWAP_HELPER_INSTRUMENT}",
+                    *[f"  {line}" for line in helper_lines],
+                    "  turnoff",
+                    "endin",
+                ]
+            )
+        )
+        score_lines = (f"i {_instrument_operand(HOT_SWAP_HELPER_INSTRUMENT)} 0 1",)
+
+    return OrchestraHotSwapPlan(changed_instruments=changed, orc="\n\n".join(orc_blocks), score_lines=score_lines)
+
+
+def _instrument_operand(ref: str) -> str:
+    if ref.isdigit():
+        return ref
+    return OrchestraEmitter._format_csound_string(ref)
@@ -1,26 +1,39 @@
 from __future__ import annotations
 
+from contextlib import ExitStack
 from dataclasses import dataclass
-from io import BytesIO
 from pathlib import Path, PurePosixPath
 import re
-from time import perf_counter as _monotonic_seconds
-from unittest.mock import patch
+from tempfile import TemporaryDirectory
+from typing import Iterator
 import zipfile
 
+from backend.app.engine.offline_render import (
+    OfflineCsoundRenderer,
+    OfflineRenderJob,
+    OfflineRenderUnavailableError,
+    mix_float_wav_files,
+)
+
 from backend.app.models.export import (
     ExportedPatchDefinition,
     OFFLINE_CSD_EXPORT_MAX_MIDI_EVENTS,
-    OFFLINE_CSD_EXPORT_MAX_WALL_SECONDS,
     PerformanceCsdExportRequest,
     PerformanceExportPayload,
 )
 from backend.app.models.patch import EngineConfig, PatchDocument, PatchGraph
+from backend.app.models.session import CompileArtifact
+from backend.app.services.archive_stream import (
+    ArchiveBytesEntry,
+    ArchiveEntry,
+    ArchiveFileEntry,
+    iter_zip_archive,
+)
 from backend.app.services.compiler_service import CompilerService, PatchInstrumentTarget
 from backend.app.services.compiler_orchestra import OrchestraEmitter, SCORE_CONTROLLER_ARRAY_NAME
 from backend.app.services.gen_asset_service import GenAssetService
 from backend.app.services.arpeggiator_runtime import PerformanceMidiRouter
-from backend.app.services.sequencer_runtime import SessionSequencerRuntime
+from backend.app.services.sequencer_runtime import OfflineClock, SessionSequencerRuntime
 
 OFFLINE_RENDER_SR = 48_000
 OFFLINE_RENDER_KSMPS = 1
@@ -61,27 +74,46 @@ class ScoreControllerEvent:
     sequence: int
 
 
+@dataclass(slots=True)
+class PerformanceCsdArchive:
+    entries: list[ArchiveEntry]
+    cleanup: ExitStack
+
+    def iter_bytes(self) -> Iterator[bytes]:
+        try:
+            yield from iter_zip_archive(self.entries)
+        finally:
+            self.cleanup.close()
+
+
 class OfflineMidiExportBudgetExceededError(ValueError):
     pass
 
 
-class OfflineMidiExportTimeoutError(ValueError):
+class OfflineMidiExportNoNoteEventsError(ValueError):
     pass
 
 
-class OfflineMidiExportNoNoteEventsError(ValueError):
+class OfflineRenderDurationExceededError(ValueError):
     pass
 
 
 class _MidiCaptureService:
-    def __init__(self, *, max_events: int) -> None:
+    def __init__(self, *, max_events: int, clock: OfflineClock) -> None:
         self._max_events = max(1, int(max_events))
+        self._clock = clock
         self.events: list[CapturedMidiEvent] = []
-        self.current_time_seconds = 0.0
-        self.current_sample = 0
         self.event_budget_exceeded = False
         self._sequence = 0
 
+    @property
+    def current_time_seconds(self) -> float:
+        return self._clock.seconds
+
+    @property
+    def current_sample(self) -> int:
+        return int(round(self._clock.seconds * OFFLINE_RENDER_SR))
+
     def _append_event(self, *, time_seconds: float, message: list[int]) -> None:
         if len(self.events) >= self._max_events:
             self.event_budget_exceeded = True
@@ -126,8 +158,9 @@ class _MidiCaptureService:
         source_timestamp_ns: int | None = None,
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> bool:
-        _ = (source, source_timestamp_ns, mapped_backend_monotonic_ns, sync_stale)
+        _ = (source, source_timestamp_ns, mapped_backend_monotonic_ns, sync_stale, received_ns)
         if target_engine_sample is not None:
             event_time = max(0.0, int(target_engine_sample) / float(OFFLINE_RENDER_SR))
         else:
@@ -156,11 +189,20 @@ class PerformanceExportService:
         self,
         compiler_service: CompilerService,
         gen_asset_service: GenAssetService,
+        offline_renderer: OfflineCsoundRenderer | None = None,
+        max_render_duration_seconds: float | None = None,
     ) -> None:
         self._compiler_service = compiler_service
         self._gen_asset_service = gen_asset_service
+        self._offline_renderer = offline_renderer
+        self._max_render_duration_seconds = max_render_duration_seconds
+
+    def prepare_performance_csd_archive(self, request: PerformanceCsdExportRequest) -> PerformanceCsdArchive:
+        """Does all export work up front and returns the archive entries ready to stream.
+
+        Validation, compile and render failures are raised here, before any response bytes are sent.
+        """
 
-    def build_performance_csd_archive(self, request: PerformanceCsdExportRequest) -> bytes:
         base_name = self._sanitize_file_base_name(request.performance_export.performance.name)
         bundle_root = PurePosixPath(base_name)
         midi_file_name = f"{base_name}.mid"
@@ -175,15 +217,19 @@ class PerformanceExportService:
             patch_definitions=patch_definitions,
         )
 
-        compile_artifact = self._compiler_service.compile_patch_bundle(
-            targets=targets,
-            midi_input="0",
-            rtmidi_module="virtual",
-            allow_packaged_asset_paths=True,
-            performance_input_mode="score" if request.event_source == "score" else "midi",
-        )
+        compile_artifact = self._compile_offline_targets(request=request, targets=targets)
 
         playback_duration_seconds = self._playback_duration_seconds(request)
+        render_duration_seconds = playback_duration_seconds + OFFLINE_RENDER_RELEASE_TAIL_SECONDS
+        if (
+            request.render_audio
+            and self._max_render_duration_seconds is not None
+            and render_duration_seconds > self._max_render_duration_seconds
+        ):
+            raise OfflineRenderDurationExceededError(
+                f"Offline audio render would last {render_duration_seconds:.1f} s, over the "
+                f"{self._max_render_duration_seconds:g} s limit. Shorten the playback range or export without audio."
+            )
         captured_events = self._capture_offline_midi_events(
             request=request,
             controller_default_channels=tuple(
@@ -194,57 +240,200 @@ class PerformanceExportService:
         self._raise_if_no_note_on_events(captured_events)
 
         warnings = list(compile_artifact.diagnostics)
+        csd, midi_bytes, event_warnings = self._build_event_document(
+            request=request,
+            orc=self._rewrite_orc_for_offline_render(compile_artifact.orc),
+            targets=targets,
+            events=captured_events,
+            file_base_name=base_name,
+            duration_seconds=render_duration_seconds,
+        )
+        warnings.extend(event_warnings)
+
+        cleanup = ExitStack()
+        try:
+            audio_entries: list[tuple[str, Path]] = []
+            if request.render_audio:
+                work_dir = Path(cleanup.enter_context(TemporaryDirectory(prefix="orchestron-offline-render-")))
+                audio_entries = self._render_offline_audio(
+                    request=request,
+                    base_name=base_name,
+                    targets=targets,
+                    events=captured_events,
+                    mixdown_job=OfflineRenderJob(name=base_name, csd=csd, midi_bytes=midi_bytes),
+                    duration_seconds=render_duration_seconds,
+                    bundled_assets=bundled_assets,
+                    work_dir=work_dir,
+                )
+        except BaseException:
+            cleanup.close()
+            raise
+        rendered_audio_names = [archive_name for archive_name, _path in audio_entries]
+
         if request.event_source == "score":
-            score_lines, score_warnings = self._build_score_lines(
-                events=captured_events,
-                targets=targets,
-                duration_seconds=playback_duration_seconds + OFFLINE_RENDER_RELEASE_TAIL_SECONDS,
-            )
-            warnings.extend(score_warnings)
-            csd = self._build_offline_score_csd(
-                orc=self._rewrite_orc_for_offline_render(compile_artifact.orc),
-                output_wave_name=output_wave_name,
-                score_lines=score_lines,
-                score_controller_initializer_lines=self._score_controller_initializer_lines(captured_events),
-            )
             readme = self._build_score_readme(
                 bundle_directory_name=base_name,
                 csd_file_name=csd_file_name,
                 output_wave_name=output_wave_name,
                 warnings=warnings,
+                rendered_audio_names=rendered_audio_names,
             )
-            midi_bytes = None
         else:
-            csd = self._build_offline_midi_csd(
-                orc=self._rewrite_orc_for_offline_render(compile_artifact.orc),
-                midi_file_name=midi_file_name,
-                output_wave_name=output_wave_name,
-                duration_seconds=playback_duration_seconds + OFFLINE_RENDER_RELEASE_TAIL_SECONDS,
-            )
-            midi_bytes = self._encode_midi_file(
-                tempo_bpm=request.sequencer_config.timing.tempo_bpm,
-                track_name=base_name,
-                events=captured_events,
-            )
             readme = self._build_readme(
                 bundle_directory_name=base_name,
                 csd_file_name=csd_file_name,
                 midi_file_name=midi_file_name,
                 output_wave_name=output_wave_name,
+                rendered_audio_names=rendered_audio_names,
+            )
+
+        entries: list[ArchiveEntry] = [ArchiveBytesEntry(str(bundle_root / csd_file_name), csd.encode("utf-8"))]
+        if midi_bytes is not None:
+            entries.append(ArchiveBytesEntry(str(bundle_root / midi_file_name), midi_bytes))
+        entries.append(ArchiveBytesEntry(str(bundle_root / "README.txt"), readme.encode("utf-8")))
+        if warnings:
+            entries.append(ArchiveBytesEntry(str(bundle_root / "WARNINGS.txt"), "\n".join(warnings).encode("utf-8")))
+        entries.extend(
+            ArchiveFileEntry(str(bundle_root / asset.archive_path), asset.source_path) for asset in bundled_assets
+        )
+        # Float PCM barely deflates, so rendered audio is stored.
+        entries.extend(
+            ArchiveFileEntry(str(bundle_root / archive_name), audio_path, compress_type=zipfile.ZIP_STORED)
+            for archive_name, audio_path in audio_entries
+        )
+        return PerformanceCsdArchive(entries=entries, cleanup=cleanup)
+
+    def _compile_offline_targets(
+        self,
+        *,
+        request: PerformanceCsdExportRequest,
+        targets: list[PatchInstrumentTarget],
+    ) -> CompileArtifact:
+        return self._compiler_service.compile_patch_bundle(
+            targets=targets,
+            midi_input="0",
+            rtmidi_module="virtual",
+            allow_packaged_asset_paths=True,
+            performance_input_mode="score" if request.event_source == "score" else "midi",
+        )
+
+    def _build_event_document(
+        self,
+        *,
+        request: PerformanceCsdExportRequest,
+        orc: str,
+        targets: list[PatchInstrumentTarget],
+        events: list[CapturedMidiEvent],
+        file_base_name: str,
+        duration_seconds: float,
+    ) -> tuple[str, bytes | None, list[str]]:
+        output_wave_name = f"{file_base_name}.wav"
+        if request.event_source == "score":
+            score_lines, score_warnings = self._build_score_lines(
+                events=events,
+                targets=targets,
+                duration_seconds=duration_seconds,
+            )
+            csd = self._build_offline_score_csd(
+                orc=orc,
+                output_wave_name=output_wave_name,
+                score_lines=score_lines,
+                score_controller_initializer_lines=self._score_controller_initializer_lines(events),
             )
+            return csd, None, score_warnings
+
+        midi_file_name = f"{file_base_name}.mid"
+        csd = self._build_offline_midi_csd(
+            orc=orc,
+            midi_file_name=midi_file_name,
+            output_wave_name=output_wave_name,
+            duration_seconds=duration_seconds,
+        )
+        midi_bytes = self._encode_midi_file(
+            tempo_bpm=request.sequencer_config.timing.tempo_bpm,
+            track_name=file_base_name,
+            events=events,
+        )
+        return csd, midi_bytes, []
 
-        archive_buffer = BytesIO()
-        with zipfile.ZipFile(archive_buffer, mode="w", compression=zipfile.ZIP_DEFLATED) as archive:
-            archive.writestr(str(bundle_root / csd_file_name), csd.encode("utf-8"))
-            if midi_bytes is not None:
-                archive.writestr(str(bundle_root / midi_file_name), midi_bytes)
-            archive.writestr(str(bundle_root / "README.txt"), readme.encode("utf-8"))
-            if warnings:
-                archive.writestr(str(bundle_root / "WARNINGS.txt"), "\n".join(warnings).encode("utf-8"))
-            for asset in bundled_assets:
-                archive.writestr(str(bundle_root / asset.archive_path), asset.source_path.read_bytes())
+    def _render_offline_audio(
+        self,
+        *,
+        request: PerformanceCsdExportRequest,
+        base_name: str,
+        targets: list[PatchInstrumentTarget],
+        events: list[CapturedMidiEvent],
+        mixdown_job: OfflineRenderJob,
+        duration_seconds: float,
+        bundled_assets: list[BundledAsset],
+        work_dir: Path,
+    ) -> list[tuple[str, Path]]:
+        if self._offline_renderer is None:
+            raise OfflineRenderUnavailableError("Offline audio render is not configured on this backend.")
+
+        assets = [(asset.source_path, asset.archive_path) for asset in bundled_assets]
+        stem_jobs = self._offline_stem_jobs(
+            request=request,
+            base_name=base_name,
+            targets=targets,
+            events=events,
+            duration_seconds=duration_seconds,
+        )
+        mixdown_archive_name = f"{base_name}.wav"
+        if len(stem_jobs) < 2:
+            mixdown_path = self._offline_renderer.render([mixdown_job], work_dir=work_dir, assets=assets)[0]
+            return [(mixdown_archive_name, mixdown_path)]
+
+        stem_paths = self._offline_renderer.render(stem_jobs, work_dir=work_dir / "stems", assets=assets)
+        mixdown_path = work_dir / mixdown_archive_name
+        mix_float_wav_files(stem_paths, mixdown_path)
+        return [
+            (mixdown_archive_name, mixdown_path),
+            *((f"stems/{path.name}", path) for path in stem_paths),
+        ]
+
+    def _offline_stem_jobs(
+        self,
+        *,
+        request: PerformanceCsdExportRequest,
+        base_name: str,
+        targets: list[PatchInstrumentTarget],
+        events: list[CapturedMidiEvent],
+        duration_seconds: float,
+    ) -> list[OfflineRenderJob]:
+        # Always-on effect instruments read audio routed from other instruments, and channel 0 listens to
+        # every channel, so those performances only render as one document.
+        if any(target.always_on or target.midi_channel < 1 for target in targets):
+            return []
+        targets_by_channel: dict[int, list[PatchInstrumentTarget]] = {}
+        for target in targets:
+            targets_by_channel.setdefault(target.midi_channel, []).append(target)
+        if len(targets_by_channel) < 2:
+            return []
 
-        return archive_buffer.getvalue()
+        jobs: list[OfflineRenderJob] = []
+        for channel, channel_targets in sorted(targets_by_channel.items()):
+            channel_events = [event for event in events if self._message_channel(event.message) == channel]
+            if not self._has_note_on_events(channel_events):
+                continue
+            artifact = self._compile_offline_targets(request=request, targets=channel_targets)
+            stem_name = f"{base_name}_ch{channel:02d}"
+            csd, midi_bytes, _warnings = self._build_event_document(
+                request=request,
+                orc=self._rewrite_orc_for_offline_render(artifact.orc),
+                targets=channel_targets,
+                events=channel_events,
+                file_base_name=stem_name,
+                duration_seconds=duration_seconds,
+            )
+            jobs.append(OfflineRenderJob(name=stem_name, csd=csd, midi_bytes=midi_bytes))
+        return jobs
+
+    @staticmethod
+    def _message_channel(message: bytes) -> int | None:
+        if not message or message[0] < 0x80 or message[0] >= 0xF0:
+            return None
+        return (message[0] & 0x0F) + 1
 
     def _rewrite_patch_definitions_for_export(
         self,
@@ -514,7 +703,8 @@ class PerformanceExportService:
         request: PerformanceCsdExportRequest,
         controller_default_channels: tuple[int, ...],
     ) -> list[CapturedMidiEvent]:
-        capture = _MidiCaptureService(max_events=OFFLINE_CSD_EXPORT_MAX_MIDI_EVENTS)
+        clock = OfflineClock()
+        capture = _MidiCaptureService(max_events=OFFLINE_CSD_EXPORT_MAX_MIDI_EVENTS, clock=clock)
         self._append_initial_midi_controller_events(
             capture=capture,
             request=request,
@@ -531,53 +721,25 @@ class PerformanceExportService:
             midi_input_selector="offline-export",
             controller_default_channels=controller_default_channels,
             publish_event=lambda _event_type, _payload: None,
+            clock_mode="offline",
+            clock=clock,
         )
         runtime.configure(request.sequencer_config)
-        router.configure(
-            request.sequencer_config.arpeggiators,
-            tempo_bpm=request.sequencer_config.timing.tempo_bpm,
-        )
-
-        scheduled_time = 0.0
-        deadline = _monotonic_seconds() + OFFLINE_CSD_EXPORT_MAX_WALL_SECONDS
-        with runtime._lock:
-            runtime._running = True
+        tempo_bpm = request.sequencer_config.timing.tempo_bpm
+        router.configure(request.sequencer_config.arpeggiators, tempo_bpm=tempo_bpm)
+
+        def advance_router(span_start_seconds: float, span_end_seconds: float) -> None:
+            block_start_sample = int(round(span_start_seconds * OFFLINE_RENDER_SR))
+            router.advance_render_block(
+                block_start_sample=block_start_sample,
+                block_end_sample=max(block_start_sample + 1, int(round(span_end_seconds * OFFLINE_RENDER_SR))),
+                sample_rate=OFFLINE_RENDER_SR,
+                tempo_bpm=tempo_bpm,
+            )
+            capture.raise_if_event_budget_exceeded()
 
         try:
-            with patch(
-                "backend.app.services.sequencer_runtime.time.perf_counter",
-                side_effect=lambda: capture.current_time_seconds,
-            ):
-                while True:
-                    if _monotonic_seconds() > deadline:
-                        raise OfflineMidiExportTimeoutError(
-                            "Offline performance CSD export MIDI generation exceeded "
-                            f"{OFFLINE_CSD_EXPORT_MAX_WALL_SECONDS:.1f} seconds."
-                        )
-                    with runtime._lock:
-                        if not runtime._running:
-                            break
-                        config = runtime._config
-                        current_subunit = runtime._absolute_subunit
-                    if config is None:
-                        break
-                    capture.current_time_seconds = scheduled_time
-                    capture.current_sample = int(round(scheduled_time * OFFLINE_RENDER_SR))
-                    block_start_sample = capture.current_sample
-                    scheduled_time += runtime._perform_subunit_event(
-                        config,
-                        current_subunit,
-                        scheduled_time=scheduled_time,
-                    )
-                    capture.current_time_seconds = scheduled_time
-                    capture.current_sample = int(round(scheduled_time * OFFLINE_RENDER_SR))
-                    router.advance_render_block(
-                        block_start_sample=block_start_sample,
-                        block_end_sample=max(block_start_sample + 1, capture.current_sample),
-                        sample_rate=OFFLINE_RENDER_SR,
-                        tempo_bpm=request.sequencer_config.timing.tempo_bpm,
-                    )
-                    capture.raise_if_event_budget_exceeded()
+            end_seconds = runtime.run_offline(advance_router)
         finally:
             router.shutdown()
         capture.raise_if_event_budget_exceeded()
@@ -593,7 +755,7 @@ class PerformanceExportService:
                         continue
                     for note in sorted(active_notes):
                         capture._append_event(
-                            time_seconds=scheduled_time,
+                            time_seconds=end_seconds,
                             message=runtime._note_off_message(track.midi_channel, note),
                         )
                         capture.raise_if_event_budget_exceeded()
@@ -930,6 +1092,7 @@ class PerformanceExportService:
         csd_file_name: str,
         midi_file_name: str,
         output_wave_name: str,
+        rendered_audio_names: list[str] | None = None,
     ) -> str:
         return "\n".join(
             [
@@ -938,6 +1101,7 @@ class PerformanceExportService:
                 "Contents:",
                 f"- {csd_file_name}: compiled offline-render Csound document",
                 f"- {midi_file_name}: multitrack arranger playback from beginning to arrangement end",
+                *PerformanceExportService._rendered_audio_readme_lines(rendered_audio_names or []),
                 "- assets/: referenced sample audio and SoundFont files bundled for the CSD",
                 "",
                 "Render steps:",
@@ -965,12 +1129,14 @@ class PerformanceExportService:
         csd_file_name: str,
         output_wave_name: str,
         warnings: list[str],
+        rendered_audio_names: list[str] | None = None,
     ) -> str:
         lines = [
             "Orchestron offline score render export",
             "",
             "Contents:",
             f"- {csd_file_name}: compiled offline-render Csound document with inline score events",
+            *PerformanceExportService._rendered_audio_readme_lines(rendered_audio_names or []),
             "- assets/: referenced sample audio and SoundFont files bundled for the CSD",
         ]
         if warnings:
@@ -999,6 +1165,15 @@ class PerformanceExportService:
             lines.extend(["Warnings:", *[f"- {warning}" for warning in warnings], ""])
         return "\n".join(lines)
 
+    @staticmethod
+    def _rendered_audio_readme_lines(rendered_audio_names: list[str]) -> list[str]:
+        if not rendered_audio_names:
+            return []
+        lines = [f"- {rendered_audio_names[0]}: server-rendered 32-bit float mixdown of the CSD"]
+        if len(rendered_audio_names) > 1:
+            lines.append("- stems/: server-rendered 32-bit float stems, one per instrument MIDI channel")
+        return lines
+
     @staticmethod
     def _format_duration(value: float) -> str:
         return f"{max(0.01, value):.6f}".rstrip("0").rstrip(".")
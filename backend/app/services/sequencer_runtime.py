@@ -1,12 +1,14 @@
 from __future__ import annotations
 
-from bisect import bisect_right
+from bisect import bisect_left, bisect_right
+from collections import deque
 import logging
 import threading
 import time
 from dataclasses import dataclass, field
 from typing import Any
 from typing import Callable
+from typing import Iterable
 from typing import Literal
 from typing import Protocol
 
@@ -142,44 +144,41 @@ def _controller_curve_control_points(
     )
 
 
-def _catmull_rom_1d(p0: float, p1: float, p2: float, p3: float, t: float) -> float:
-    t2 = t * t
-    t3 = t2 * t
-    return 0.5 * (
+def _bake_controller_curve_table(
+    keypoints: tuple[tuple[float, int], ...],
+    sample_offsets: Any,
+    transport_subunit_count: int,
+) -> bytes:
+    """Samples the Catmull-Rom controller curve at every automation slot of a pad in one vectorized pass."""
+    import numpy as np  # type: ignore
+
+    points = _controller_curve_control_points(keypoints)
+    if len(points) <= 1 or sample_offsets.size == 0:
+        return bytes(int(sample_offsets.size))
+    xs = np.array([point[0] for point in points], dtype=np.float64)
+    ys = np.array([point[1] for point in points], dtype=np.float64)
+    last = len(points) - 1
+
+    t = np.clip(sample_offsets / float(max(1, transport_subunit_count)), 0.0, 1.0)
+    # First segment whose right edge is at or past t, matching the linear scan in the scalar sampler.
+    segment = np.minimum(np.searchsorted(xs[1:], t, side="left"), last - 1)
+    x1 = xs[segment]
+    p0 = ys[np.maximum(0, segment - 1)]
+    p1 = ys[segment]
+    p2 = ys[np.minimum(last, segment + 1)]
+    p3 = ys[np.minimum(last, segment + 2)]
+    span = np.maximum(1e-6, xs[np.minimum(last, segment + 1)] - x1)
+    local_t = np.clip((t - x1) / span, 0.0, 1.0)
+    t2 = local_t * local_t
+    t3 = t2 * local_t
+    values = 0.5 * (
         (2.0 * p1)
-        + (-p0 + p2) * t
+        + (-p0 + p2) * local_t
         + (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3) * t2
         + (-p0 + 3.0 * p1 - 3.0 * p2 + p3) * t3
     )
-
-
-def _sample_controller_curve_value(
-    keypoints: tuple[tuple[float, int], ...],
-    normalized_position: float,
-) -> int:
-    t = _clamp_controller_position(normalized_position)
-    points = _controller_curve_control_points(keypoints)
-    if len(points) <= 1:
-        return 0
-    if t <= 0.0:
-        return _clamp_controller_value(points[0][1])
-    if t >= 1.0:
-        return _clamp_controller_value(points[-1][1])
-
-    segment_index = 0
-    for index in range(len(points) - 1):
-        if t <= points[index + 1][0]:
-            segment_index = index
-            break
-
-    p1 = points[segment_index]
-    p2 = points[min(len(points) - 1, segment_index + 1)]
-    p0 = points[max(0, segment_index - 1)]
-    p3 = points[min(len(points) - 1, segment_index + 2)]
-    span = max(1e-6, p2[0] - p1[0])
-    local_t = max(0.0, min(1.0, (t - p1[0]) / span))
-    value = _catmull_rom_1d(p0[1], p1[1], p2[1], p3[1], local_t)
-    return _clamp_controller_value(value)
+    values = np.where(t <= 0.0, ys[0], np.where(t >= 1.0, ys[last], values))
+    return np.clip(np.rint(values), 0, 127).astype(np.uint8).tobytes()
 
 
 @dataclass(slots=True)
@@ -189,6 +188,21 @@ class SequencerStepRuntime:
     velocity: int = 100
 
 
+@dataclass(slots=True)
+class SequencerPadTimeline:
+    """Struct-of-arrays view of a pad, one entry per step boundary that changes the sounding notes.
+
+    Each event releases the track's held notes and then starts ``notes[note_starts[i]:note_starts[i + 1]]``;
+    hold steps without notes produce no event. ``durations`` run to the next event or to the end of the pad.
+    """
+
+    event_offsets: tuple[int, ...] = ()
+    note_starts: tuple[int, ...] = (0,)
+    notes: tuple[int, ...] = ()
+    velocities: tuple[int, ...] = ()
+    durations: tuple[int, ...] = ()
+
+
 @dataclass(slots=True)
 class SequencerPadRuntime:
     length_beats: int
@@ -197,6 +211,21 @@ class SequencerPadRuntime:
     steps: tuple[SequencerStepRuntime, ...]
     scale_root: str | None = None
     mode: str | None = None
+    timeline: SequencerPadTimeline = field(default_factory=SequencerPadTimeline)
+
+
+@dataclass(slots=True)
+class SequencerPadLoopTimeline:
+    """Token start offsets of a pad-loop sequence plus the pad left active after each token.
+
+    ``first_pass_pads`` applies before the sequence has wrapped and ``repeat_pads`` afterwards; ``-1`` keeps the
+    pad the track was reset to.
+    """
+
+    token_offsets: tuple[int, ...]
+    length: int
+    first_pass_pads: tuple[int, ...]
+    repeat_pads: tuple[int, ...]
 
 
 @dataclass(slots=True)
@@ -212,6 +241,10 @@ class ControllerSequencerPadRuntime:
     transport_subunit_count: int
     events: tuple[ControllerSequencerEventRuntime, ...]
     event_offsets: tuple[int, ...] = ()
+    # Dense value per automation slot (``_CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM`` subunits) and, per slot, the
+    # index of the run in ``events`` that covers it. Both make value and next-change lookups O(1).
+    value_table: bytes = b""
+    slot_event_index: tuple[int, ...] = ()
 
 
 @dataclass(slots=True)
@@ -238,6 +271,7 @@ class SequencerTrackRuntime:
     pad_loop_repeat: bool = True
     pad_loop_sequence: tuple[int, ...] = ()
     pad_loop_position: int | None = None
+    pad_loop_timeline: SequencerPadLoopTimeline | None = None
     phase_offset_subunit: int = 0
     sequence_ended: bool = False
 
@@ -261,6 +295,7 @@ class ControllerSequencerTrackRuntime:
     pad_loop_repeat: bool = True
     pad_loop_sequence: tuple[int, ...] = ()
     pad_loop_position: int | None = None
+    pad_loop_timeline: SequencerPadLoopTimeline | None = None
     phase_offset_subunit: int = 0
     sequence_ended: bool = False
     last_value: int | None = None
@@ -313,6 +348,18 @@ class SequencerRuntimeConfig:
     controller_tracks: dict[str, ControllerSequencerTrackRuntime] = field(default_factory=dict)
 
 
+class OfflineClock:
+    """Virtual seconds clock for ``clock_mode="offline"``; ``run_offline`` moves it from event to event."""
+
+    __slots__ = ("seconds",)
+
+    def __init__(self, seconds: float = 0.0) -> None:
+        self.seconds = float(seconds)
+
+    def __call__(self) -> float:
+        return self.seconds
+
+
 class SessionSequencerRuntime:
     def __init__(
         self,
@@ -322,7 +369,8 @@ class SessionSequencerRuntime:
         controller_default_channels: tuple[int, ...],
         publish_event: PublishEventFn,
         *,
-        clock_mode: Literal["wall_clock", "render_driven"] = "wall_clock",
+        clock_mode: Literal["wall_clock", "render_driven", "offline"] = "wall_clock",
+        clock: Callable[[], float] | None = None,
     ) -> None:
         self._session_id = session_id
         self._midi_service = midi_service
@@ -330,6 +378,21 @@ class SessionSequencerRuntime:
         self._controller_default_channels = controller_default_channels
         self._publish_event = publish_event
         self._clock_mode = clock_mode
+        if clock_mode == "offline" and not isinstance(clock, OfflineClock | None):
+            raise ValueError("Offline sequencer runtimes need an OfflineClock.")
+        self._clock: Callable[[], float] = (
+            clock if clock is not None else OfflineClock() if clock_mode == "offline" else time.perf_counter
+        )
+        # Offline runs publish nothing and only stop at timeline events, not at every visible step.
+        self._publishes_transport_events = clock_mode != "offline"
+        # Resolved once: the render loop sends MIDI every block and should not probe the service each time.
+        contextual_send_one = getattr(midi_service, "send_scheduled_message_with_context", None)
+        contextual_send_many = getattr(midi_service, "send_scheduled_messages_with_context", None)
+        self._contextual_send_one = contextual_send_one if callable(contextual_send_one) else None
+        self._contextual_send_many = contextual_send_many if callable(contextual_send_many) else None
+        # Render-driven step and pad-switch events are queued here by the render thread and published by
+        # ``drain_notifications`` on the caller's side. deque append/popleft are atomic, so no lock is shared.
+        self._notifications: deque[tuple[str, dict[str, Any]]] = deque()
 
         self._lock = threading.RLock()
         self._stop_event = threading.Event()
@@ -449,7 +512,7 @@ class SessionSequencerRuntime:
             self._stop_event.clear()
             self._running = True
             self._render_subunit_remainder = 0.0
-            if self._clock_mode == "render_driven":
+            if self._clock_mode != "wall_clock":
                 return self._status_locked()
             self._thread = threading.Thread(
                 target=self._run,
@@ -493,14 +556,53 @@ class SessionSequencerRuntime:
         with self._lock:
             return self._status_locked()
 
+    @property
+    def tempo_bpm(self) -> int:
+        config = self._config
+        return config.timing.tempo_bpm if config is not None else SessionSequencerTimingConfig().tempo_bpm
+
     def advance_render_block(self, *, sample_rate: int, ksmps: int) -> SessionSequencerStatus:
+        with self._lock:
+            self.tick_render_block(sample_rate=sample_rate, ksmps=ksmps)
+            status = self._status_locked()
+        self.drain_notifications()
+        return status
+
+    def drain_notifications(self) -> int:
+        return self.publish_notifications(self.take_notifications())
+
+    def take_notifications(self) -> list[tuple[str, dict[str, Any]]]:
+        """Removes the queued step and pad-switch events without publishing them.
+
+        Render-ahead takes them after each block and publishes them once that block is delivered.
+        """
+        taken: list[tuple[str, dict[str, Any]]] = []
+        while True:
+            try:
+                taken.append(self._notifications.popleft())
+            except IndexError:
+                return taken
+
+    def publish_notifications(self, notifications: Iterable[tuple[str, dict[str, Any]]]) -> int:
+        published = 0
+        for event_type, payload in notifications:
+            self._publish_event(event_type, payload)
+            published += 1
+        return published
+
+    def tick_render_block(self, *, sample_rate: int, ksmps: int) -> bool:
+        """Advances the transport by one render block without building a status snapshot.
+
+        MIDI goes straight to the MIDI service; step and pad-switch events wait in the notification queue until
+        ``drain_notifications`` runs. Returns whether the sequencer is still running.
+        """
         with self._lock:
             if self._clock_mode != "render_driven":
                 raise RuntimeError("Render-driven advancement is only available in render_driven mode.")
 
             config = self._ensure_config()
             if not self._running:
-                return self._status_locked()
+                return False
 
             if self._render_subunit_remainder <= _RENDER_SUBUNIT_EPSILON:
                 self._render_subunit_remainder = 0.0
@@ -513,6 +615,14 @@ class SessionSequencerRuntime:
                     self._render_subunit_remainder += block_seconds / subunit_duration
 
             while self._running and self._render_subunit_remainder >= (1.0 - _RENDER_SUBUNIT_EPSILON):
+                skipped = self._render_idle_subunits_locked(
+                    config,
+                    int(self._render_subunit_remainder + _RENDER_SUBUNIT_EPSILON),
+                )
+                if skipped > 0:
+                    self._absolute_subunit += skipped
+                    self._render_subunit_remainder = max(0.0, self._render_subunit_remainder - skipped)
+                    continue
                 self._advance_one_render_subunit_locked(config)
                 self._render_subunit_remainder = max(0.0, self._render_subunit_remainder - 1.0)
                 if self._running and self._render_subunit_remainder > _RENDER_SUBUNIT_EPSILON:
@@ -521,14 +631,38 @@ class SessionSequencerRuntime:
             if self._render_subunit_remainder <= _RENDER_SUBUNIT_EPSILON:
                 self._render_subunit_remainder = 0.0
 
-            return self._status_locked()
+            return self._running
+
+    def run_offline(self, on_span: Callable[[float, float], None] | None = None) -> float:
+        """Plays the configured range once on the offline clock and returns its end time in seconds.
+
+        Events are performed back to back with the clock set to their scheduled time, so idle subunits cost nothing.
+        ``on_span`` sees each ``[event, next event)`` span with the clock at its end, letting downstream renderers
+        such as the arpeggiator router catch up. Looping playback never ends and must be rejected by the caller.
+        """
+        clock = self._clock
+        with self._lock:
+            if self._clock_mode != "offline" or not isinstance(clock, OfflineClock):
+                raise RuntimeError("Offline runs are only available in offline mode.")
+            config = self._ensure_config()
+            self.start()
+            while self._running:
+                span_start = clock.seconds
+                clock.seconds = span_start + self._perform_subunit_event(
+                    config,
+                    self._absolute_subunit,
+                    scheduled_time=span_start,
+                )
+                if on_span is not None:
+                    on_span(span_start, clock.seconds)
+            return clock.seconds
 
     def _run(self) -> None:
-        next_event_time = time.perf_counter() + 0.01
+        next_event_time = self._clock() + 0.01
         wait_duration = 0.01
 
         while not self._stop_event.is_set():
-            now = time.perf_counter()
+            now = self._clock()
 
             with self._lock:
                 if not self._running:
@@ -560,7 +694,7 @@ class SessionSequencerRuntime:
             )
             next_event_time += wait_duration
 
-            now = time.perf_counter()
+            now = self._clock()
             if next_event_time < now - (wait_duration * 2.0):
                 next_event_time = now + wait_duration
 
@@ -581,21 +715,18 @@ class SessionSequencerRuntime:
             if not track.enabled or pad_runtime is None or not pad_runtime.steps:
                 self._release_track_notes_locked(track_id, track.midi_channel)
                 continue
-            if not self._local_step_boundary_reached(track, transport_subunit):
+            event_index = self._pad_timeline_event_index(track, pad_runtime.timeline, transport_subunit)
+            if event_index is None:
                 continue
-            local_step = self._local_step_for(track, transport_subunit)
-            step_state = pad_runtime.steps[local_step]
-            notes = step_state.notes
-            if notes:
-                self._release_track_notes_locked(track_id, track.midi_channel)
+            self._release_track_notes_locked(track_id, track.midi_channel)
+            note_on_messages = self._pad_timeline_note_on_messages(track, pad_runtime.timeline, event_index)
+            if note_on_messages:
                 self._send_messages_locked(
-                    [self._note_on_message(track.midi_channel, note, step_state.velocity) for note in notes],
+                    note_on_messages,
                     source_context=self._source_context_for_track(track),
                 )
-                for note in notes:
-                    active_notes.add(note)
-            elif not step_state.hold:
-                self._release_track_notes_locked(track_id, track.midi_channel)
+                for message in note_on_messages:
+                    active_notes.add(message[1])
 
         for track in config.controller_tracks.values():
             value = self._controller_track_value_at_current_subunit_locked(track, transport_subunit)
@@ -668,14 +799,18 @@ class SessionSequencerRuntime:
 
         next_visible_step = self._absolute_subunit // _TRANSPORT_SUBUNITS_PER_STEP
         if next_visible_step != current_visible_step:
-            self._publish_event(
-                "sequencer_step",
-                self._sequencer_step_event_payload_locked(config, previous_step=current_visible_step),
+            self._notifications.append(
+                (
+                    "sequencer_step",
+                    self._sequencer_step_event_payload_locked(config, previous_step=current_visible_step),
+                )
             )
         for payload in switch_payloads:
-            self._publish_event(
-                "sequencer_pad_switched",
-                self._sequencer_pad_switch_event_payload_locked(config, payload),
+            self._notifications.append(
+                (
+                    "sequencer_pad_switched",
+                    self._sequencer_pad_switch_event_payload_locked(config, payload),
+                )
             )
 
     @staticmethod
@@ -858,11 +993,28 @@ class SessionSequencerRuntime:
         )
 
     @staticmethod
-    def _local_step_boundary_reached(track: SequencerTrackRuntime, transport_subunit: int) -> bool:
-        return (
-            SessionSequencerRuntime._local_transport_offset_for(track, transport_subunit)
-            % SessionSequencerRuntime._transport_subunits_per_local_step(track)
-        ) == 0
+    def _pad_timeline_event_index(
+        track: SequencerTrackRuntime,
+        timeline: SequencerPadTimeline,
+        transport_subunit: int,
+    ) -> int | None:
+        local_offset = SessionSequencerRuntime._local_transport_offset_for(track, transport_subunit)
+        index = bisect_left(timeline.event_offsets, local_offset)
+        if index < len(timeline.event_offsets) and timeline.event_offsets[index] == local_offset:
+            return index
+        return None
+
+    @staticmethod
+    def _pad_timeline_note_on_messages(
+        track: SequencerTrackRuntime,
+        timeline: SequencerPadTimeline,
+        event_index: int,
+    ) -> list[list[int]]:
+        start, end = timeline.note_starts[event_index], timeline.note_starts[event_index + 1]
+        return [
+            SessionSequencerRuntime._note_on_message(track.midi_channel, note, velocity)
+            for note, velocity in zip(timeline.notes[start:end], timeline.velocities[start:end])
+        ]
 
     @staticmethod
     def _track_cycle_boundary_reached_for_next_subunit(
@@ -1157,7 +1309,7 @@ class SessionSequencerRuntime:
             return self._absolute_subunit
         if (
             self._scheduled_visible_until_time is not None
-            and time.perf_counter() < self._scheduled_visible_until_time
+            and self._clock() < self._scheduled_visible_until_time
         ):
             return self._scheduled_visible_subunit
         return self._absolute_subunit
@@ -1229,10 +1381,17 @@ class SessionSequencerRuntime:
         cycle_offset = self._local_transport_offset_for(track, current_subunit)
         return current_subunit - cycle_offset + cycle_length
 
-    def _next_local_step_boundary_subunit(self, track: SequencerTrackRuntime, current_subunit: int) -> int:
-        transport_offset = self._local_transport_offset_for(track, current_subunit)
-        step_span = max(1, self._transport_subunits_per_local_step(track))
-        return current_subunit - transport_offset + (((transport_offset // step_span) + 1) * step_span)
+    def _next_pad_timeline_event_subunit(
+        self,
+        track: SequencerTrackRuntime,
+        timeline: SequencerPadTimeline,
+        current_subunit: int,
+    ) -> int | None:
+        local_offset = self._local_transport_offset_for(track, current_subunit)
+        next_index = bisect_right(timeline.event_offsets, local_offset)
+        if next_index >= len(timeline.event_offsets):
+            return None
+        return current_subunit - local_offset + timeline.event_offsets[next_index]
 
     @staticmethod
     def _controller_pause_token_active(track: ControllerSequencerTrackRuntime) -> bool:
@@ -1247,13 +1406,11 @@ class SessionSequencerRuntime:
         if not track.enabled or self._controller_pause_token_active(track):
             return None
         pad_runtime = self._active_pad_runtime(track)
-        if not isinstance(pad_runtime, ControllerSequencerPadRuntime) or not pad_runtime.event_offsets:
+        if not isinstance(pad_runtime, ControllerSequencerPadRuntime) or not pad_runtime.value_table:
             return None
         local_offset = self._local_transport_offset_for(track, transport_subunit)
-        index = bisect_right(pad_runtime.event_offsets, local_offset) - 1
-        if index < 0:
-            return None
-        return pad_runtime.events[index].value
+        slot = min(len(pad_runtime.value_table) - 1, local_offset // _CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM)
+        return pad_runtime.value_table[slot]
 
     def _next_controller_change_subunit_locked(
         self,
@@ -1263,10 +1420,11 @@ class SessionSequencerRuntime:
         if not track.enabled or self._controller_pause_token_active(track):
             return None
         pad_runtime = self._active_pad_runtime(track)
-        if not isinstance(pad_runtime, ControllerSequencerPadRuntime) or not pad_runtime.event_offsets:
+        if not isinstance(pad_runtime, ControllerSequencerPadRuntime) or not pad_runtime.slot_event_index:
             return None
         local_offset = self._local_transport_offset_for(track, current_subunit)
-        next_index = bisect_right(pad_runtime.event_offsets, local_offset)
+        slot = min(len(pad_runtime.slot_event_index) - 1, local_offset // _CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM)
+        next_index = pad_runtime.slot_event_index[slot] + 1
         if next_index >= len(pad_runtime.event_offsets):
             return None
         return current_subunit - local_offset + pad_runtime.event_offsets[next_index]
@@ -1286,13 +1444,21 @@ class SessionSequencerRuntime:
         return next_boundary
 
     def _next_event_subunit_locked(self, config: SequencerRuntimeConfig, current_subunit: int) -> int:
-        candidates = [((current_subunit // _TRANSPORT_SUBUNITS_PER_STEP) + 1) * _TRANSPORT_SUBUNITS_PER_STEP]
+        candidates = [config.playback_end_subunit]
+        if self._publishes_transport_events:
+            candidates.append(((current_subunit // _TRANSPORT_SUBUNITS_PER_STEP) + 1) * _TRANSPORT_SUBUNITS_PER_STEP)
         for track in config.tracks.values():
             if track.enabled:
                 candidates.append(self._next_track_cycle_boundary_subunit(track, current_subunit))
                 pad_runtime = self._active_pad_runtime(track)
-                if pad_runtime is not None and pad_runtime.steps:
-                    candidates.append(self._next_local_step_boundary_subunit(track, current_subunit))
+                if isinstance(pad_runtime, SequencerPadRuntime) and pad_runtime.steps:
+                    next_step_event = self._next_pad_timeline_event_subunit(
+                        track,
+                        pad_runtime.timeline,
+                        current_subunit,
+                    )
+                    if next_step_event is not None:
+                        candidates.append(next_step_event)
         for track in config.controller_tracks.values():
             if not track.enabled:
                 continue
@@ -1300,9 +1466,19 @@ class SessionSequencerRuntime:
             next_controller_change = self._next_controller_change_subunit_locked(track, current_subunit)
             if next_controller_change is not None:
                 candidates.append(next_controller_change)
-        candidates.append(config.playback_end_subunit)
         return min(candidate for candidate in candidates if candidate > current_subunit)
 
+    def _render_idle_subunits_locked(self, config: SequencerRuntimeConfig, max_subunits: int) -> int:
+        """Number of upcoming subunits with no boundary or step event, which render blocks may skip over."""
+        if max_subunits <= 0:
+            return 0
+        for track in config.tracks.values():
+            # Queued starts and pad switches on stopped tracks are not event candidates; single-step instead.
+            if track.queued_enabled is not None or (not track.enabled and track.queued_pad is not None):
+                return 0
+        next_event_subunit = self._next_event_subunit_locked(config, self._absolute_subunit)
+        return max(0, min(max_subunits, next_event_subunit - self._absolute_subunit - 1))
+
     def _apply_absolute_subunit_locked(self, config: SequencerRuntimeConfig, absolute_subunit: int) -> None:
         normalized_absolute = max(0, int(round(absolute_subunit)))
         simulation_target = min(normalized_absolute, config.playback_end_subunit)
@@ -1319,18 +1495,14 @@ class SessionSequencerRuntime:
             track.queued_pad = None
             self._reset_controller_track_runtime_for_absolute_subunit_locked(track)
 
-        simulated_subunit = 0
-        while True:
-            next_boundary = self._next_cycle_event_subunit_locked(config, simulated_subunit)
-            if next_boundary is None or next_boundary > simulation_target:
-                break
-            self._advance_tracks_for_next_subunit_locked(
-                config,
-                next_boundary,
-                release_notes=False,
-            )
-            self._advance_controller_tracks_for_next_subunit_locked(config, next_boundary)
-            simulated_subunit = next_boundary
+        if any(track.sync_to_track_id in config.tracks for track in config.tracks.values()):
+            # Synced tracks are reset by their master's loop boundaries, so replay boundaries in order.
+            self._replay_cycle_boundaries_locked(config, simulation_target)
+        else:
+            for track in config.tracks.values():
+                self._seek_track_on_timeline_locked(track, simulation_target)
+            for track in config.controller_tracks.values():
+                self._seek_track_on_timeline_locked(track, simulation_target)
 
         for track in config.tracks.values():
             pending_pad, pending_enabled = pending_by_track[track.track_id]
@@ -1357,6 +1529,54 @@ class SessionSequencerRuntime:
         self._scheduled_visible_subunit = normalized_absolute
         self._scheduled_visible_until_time = None
 
+    def _replay_cycle_boundaries_locked(self, config: SequencerRuntimeConfig, simulation_target: int) -> None:
+        simulated_subunit = 0
+        while True:
+            next_boundary = self._next_cycle_event_subunit_locked(config, simulated_subunit)
+            if next_boundary is None or next_boundary > simulation_target:
+                break
+            self._advance_tracks_for_next_subunit_locked(
+                config,
+                next_boundary,
+                release_notes=False,
+            )
+            self._advance_controller_tracks_for_next_subunit_locked(config, next_boundary)
+            simulated_subunit = next_boundary
+
+    def _seek_track_on_timeline_locked(
+        self,
+        track: SequencerTrackRuntime | ControllerSequencerTrackRuntime,
+        simulation_target: int,
+    ) -> None:
+        """Closed-form equivalent of replaying every cycle boundary up to ``simulation_target`` for one track."""
+        if not track.enabled:
+            return
+        loop_timeline = track.pad_loop_timeline
+        if not track.pad_loop_enabled or loop_timeline is None:
+            cycle_length = max(1, self._transport_subunit_count_for_pad(track, track.active_pad))
+            track.phase_offset_subunit = (simulation_target // cycle_length) * cycle_length
+            return
+
+        loop_count, loop_offset = divmod(simulation_target, loop_timeline.length)
+        if loop_count > 0 and not track.pad_loop_repeat:
+            last_index = len(loop_timeline.token_offsets) - 1
+            if loop_timeline.first_pass_pads[last_index] >= 0:
+                track.active_pad = loop_timeline.first_pass_pads[last_index]
+            track.phase_offset_subunit = loop_timeline.token_offsets[last_index]
+            track.pad_loop_position = None
+            track.enabled = False
+            track.sequence_ended = True
+            if isinstance(track, ControllerSequencerTrackRuntime):
+                track.last_value = None
+            return
+
+        position = bisect_right(loop_timeline.token_offsets, loop_offset) - 1
+        active_pads = loop_timeline.repeat_pads if loop_count > 0 else loop_timeline.first_pass_pads
+        if active_pads[position] >= 0:
+            track.active_pad = active_pads[position]
+        track.pad_loop_position = position
+        track.phase_offset_subunit = (loop_count * loop_timeline.length) + loop_timeline.token_offsets[position]
+
     def _seek_steps_locked(self, delta_steps: int) -> SessionSequencerStatus:
         config = self._ensure_config()
         target_subunit = self._absolute_subunit + (int(delta_steps) * _TRANSPORT_SUBUNITS_PER_STEP)
@@ -1403,7 +1623,7 @@ class SessionSequencerRuntime:
             event_delivery_delay_seconds = (
                 None
                 if scheduled_time is None
-                else max(0.0, scheduled_time - time.perf_counter())
+                else max(0.0, scheduled_time - self._clock())
             )
             controller_messages: list[list[int]] = []
             for track_id, track in config.tracks.items():
@@ -1416,30 +1636,23 @@ class SessionSequencerRuntime:
                         delivery_delay_seconds=event_delivery_delay_seconds,
                     )
                     continue
-                if not self._local_step_boundary_reached(track, transport_subunit):
+                event_index = self._pad_timeline_event_index(track, pad_runtime.timeline, transport_subunit)
+                if event_index is None:
                     continue
-                local_step = self._local_step_for(track, transport_subunit)
-                step_state = pad_runtime.steps[local_step]
-                notes = step_state.notes
-                if notes:
-                    self._release_track_notes_locked(
-                        track_id,
-                        track.midi_channel,
-                        delivery_delay_seconds=event_delivery_delay_seconds,
-                    )
+                self._release_track_notes_locked(
+                    track_id,
+                    track.midi_channel,
+                    delivery_delay_seconds=event_delivery_delay_seconds,
+                )
+                note_on_messages = self._pad_timeline_note_on_messages(track, pad_runtime.timeline, event_index)
+                if note_on_messages:
                     self._send_messages_locked(
-                        [self._note_on_message(track.midi_channel, note, step_state.velocity) for note in notes],
+                        note_on_messages,
                         delivery_delay_seconds=event_delivery_delay_seconds,
                         source_context=self._source_context_for_track(track),
                     )
-                    for note in notes:
-                        active_notes.add(note)
-                elif not step_state.hold:
-                    self._release_track_notes_locked(
-                        track_id,
-                        track.midi_channel,
-                        delivery_delay_seconds=event_delivery_delay_seconds,
-                    )
+                    for message in note_on_messages:
+                        active_notes.add(message[1])
 
             for track in config.controller_tracks.values():
                 value = self._controller_track_value_at_current_subunit_locked(track, transport_subunit)
@@ -1469,7 +1682,7 @@ class SessionSequencerRuntime:
             boundary_delivery_delay_seconds = (
                 None
                 if boundary_scheduled_time is None
-                else max(0.0, boundary_scheduled_time - time.perf_counter())
+                else max(0.0, boundary_scheduled_time - self._clock())
             )
             current_visible_step = transport_subunit // _TRANSPORT_SUBUNITS_PER_STEP
 
@@ -1523,13 +1736,16 @@ class SessionSequencerRuntime:
                     self._absolute_subunit = next_subunit
 
             next_visible_step = self._absolute_subunit // _TRANSPORT_SUBUNITS_PER_STEP
-            publish_step_event = next_visible_step != current_visible_step
+            publish_step_event = self._publishes_transport_events and next_visible_step != current_visible_step
 
             if publish_step_event:
                 step_payload = self._sequencer_step_event_payload_locked(config, previous_step=current_visible_step)
             else:
                 step_payload: dict[str, Any] = {}
 
+        next_event_seconds = next_wait_subunits * config.timing.transport_subunit_duration_seconds
+        if not self._publishes_transport_events:
+            return next_event_seconds
         if publish_step_event:
             self._publish_event("sequencer_step", step_payload)
         for payload in switch_payloads:
@@ -1537,7 +1753,7 @@ class SessionSequencerRuntime:
                 "sequencer_pad_switched",
                 self._sequencer_pad_switch_event_payload_locked(config, payload),
             )
-        return next_wait_subunits * config.timing.transport_subunit_duration_seconds
+        return next_event_seconds
 
     def _sequencer_step_event_payload_locked(
         self,
@@ -1545,34 +1761,40 @@ class SessionSequencerRuntime:
         *,
         previous_step: int,
     ) -> dict[str, Any]:
-        status = self._status_locked()
-        runtime_payload = self._sequencer_runtime_delta_payload_from_status(status)
+        delta = self._sequencer_runtime_delta_payload_locked(config)
         return {
             "previous_step": previous_step % max(1, config.step_count),
-            **runtime_payload,
+            **delta,
+            # Playback time of this snapshot; event subscribers coalesce step events on it.
+            "transport_time_ms": round(
+                delta["transport_subunit"] * config.timing.transport_subunit_duration_seconds * 1000.0,
+                3,
+            ),
         }
 
-    @staticmethod
-    def _sequencer_runtime_delta_payload_from_status(status: SessionSequencerStatus) -> dict[str, Any]:
+    def _sequencer_runtime_delta_payload_locked(self, config: SequencerRuntimeConfig) -> dict[str, Any]:
+        # Mirrors the matching ``_status_locked`` fields without building the pydantic status models.
+        visible_absolute_subunit = self._visible_absolute_subunit_locked()
+        current_step, cycle = self._transport_position_locked(config, visible_absolute_subunit)
         return {
-            "current_step": status.current_step,
-            "cycle": status.cycle,
-            "running": status.running,
-            "step_count": status.step_count,
-            "transport_subunit": status.transport_subunit,
+            "current_step": current_step,
+            "cycle": cycle,
+            "running": self._running,
+            "step_count": max(1, config.step_count),
+            "transport_subunit": visible_absolute_subunit,
             "tracks": [
                 {
                     "track_id": track.track_id,
-                    "local_step": track.local_step,
+                    "local_step": self._local_step_for(track, visible_absolute_subunit),
                 }
-                for track in status.tracks
+                for track in config.tracks.values()
             ],
             "controller_tracks": [
                 {
                     "track_id": track.track_id,
-                    "runtime_pad_start_subunit": track.runtime_pad_start_subunit,
+                    "runtime_pad_start_subunit": track.phase_offset_subunit if track.enabled else None,
                 }
-                for track in status.controller_tracks
+                for track in config.controller_tracks.values()
             ],
         }
 
@@ -1581,43 +1803,43 @@ class SessionSequencerRuntime:
         config: SequencerRuntimeConfig,
         payload: dict[str, str | int | float | bool | None],
     ) -> dict[str, Any]:
-        status = self._status_locked()
         enriched_payload: dict[str, Any] = {
             **payload,
-            **self._sequencer_runtime_delta_payload_from_status(status),
+            **self._sequencer_runtime_delta_payload_locked(config),
         }
 
         track_id = payload.get("track_id")
         if not isinstance(track_id, str):
             return enriched_payload
 
-        track_status = next((track for track in status.tracks if track.track_id == track_id), None)
-        if track_status is not None:
+        track = config.tracks.get(track_id)
+        if track is not None:
             enriched_payload.update(
                 {
                     "track_kind": "note",
-                    "local_step": track_status.local_step,
-                    "queued_pad": track_status.queued_pad,
-                    "pad_loop_position": track_status.pad_loop_position,
-                    "enabled": track_status.enabled,
-                    "queued_enabled": track_status.queued_enabled,
-                    "runtime_pad_start_subunit": track_status.runtime_pad_start_subunit,
+                    "local_step": self._local_step_for(track, self._visible_absolute_subunit_locked()),
+                    "queued_pad": track.queued_pad,
+                    "pad_loop_position": track.pad_loop_position,
+                    "enabled": track.enabled,
+                    "queued_enabled": track.queued_enabled,
+                    "runtime_pad_start_subunit": track.phase_offset_subunit if track.enabled else None,
                 }
             )
             return enriched_payload
 
-        controller_track_status = next(
-            (track for track in status.controller_tracks if track.track_id == track_id),
-            None,
-        )
-        if controller_track_status is not None:
+        controller_track = config.controller_tracks.get(track_id)
+        if controller_track is not None:
             enriched_payload.update(
                 {
                     "track_kind": "controller",
-                    "queued_pad": controller_track_status.queued_pad,
-                    "pad_loop_position": controller_track_status.pad_loop_position,
-                    "enabled": controller_track_status.enabled,
-                    "runtime_pad_start_subunit": controller_track_status.runtime_pad_start_subunit,
+                    "queued_pad": controller_track.queued_pad,
+                    "pad_loop_position": (
+                        controller_track.pad_loop_position if controller_track.enabled else None
+                    ),
+                    "enabled": controller_track.enabled,
+                    "runtime_pad_start_subunit": (
+                        controller_track.phase_offset_subunit if controller_track.enabled else None
+                    ),
                 }
             )
         return enriched_payload
@@ -1690,8 +1912,8 @@ class SessionSequencerRuntime:
         source_context: MidiSourceContext | None = None,
     ) -> None:
         try:
-            contextual_send = getattr(self._midi_service, "send_scheduled_message_with_context", None)
-            if callable(contextual_send) and source_context is not None:
+            contextual_send = self._contextual_send_one
+            if contextual_send is not None and source_context is not None:
                 contextual_send(
                     self._midi_input_selector,
                     message,
@@ -1717,9 +1939,9 @@ class SessionSequencerRuntime:
         if not messages:
             return
         try:
-            contextual_send_many = getattr(self._midi_service, "send_scheduled_messages_with_context", None)
-            contextual_send_one = getattr(self._midi_service, "send_scheduled_message_with_context", None)
-            if source_context is not None and len(messages) > 1 and callable(contextual_send_many):
+            contextual_send_many = self._contextual_send_many
+            contextual_send_one = self._contextual_send_one
+            if source_context is not None and len(messages) > 1 and contextual_send_many is not None:
                 contextual_send_many(
                     self._midi_input_selector,
                     messages,
@@ -1727,7 +1949,7 @@ class SessionSequencerRuntime:
                     source_context=source_context,
                 )
                 return
-            if source_context is not None and len(messages) == 1 and callable(contextual_send_one):
+            if source_context is not None and len(messages) == 1 and contextual_send_one is not None:
                 contextual_send_one(
                     self._midi_input_selector,
                     messages[0],
@@ -1893,28 +2115,102 @@ class SessionSequencerRuntime:
         length_beats: int,
         timing: SequencerTimingRuntime,
     ) -> ControllerSequencerPadRuntime:
+        import numpy as np  # type: ignore
+
         step_count = SessionSequencerRuntime._step_count_for_length(length_beats, timing)
         transport_subunit_count = SessionSequencerRuntime._transport_subunit_count_for_length(length_beats, timing)
         normalized_keypoints = _normalize_controller_keypoints(keypoints)
-        events: list[ControllerSequencerEventRuntime] = []
-
-        event_offset = 0
-        while event_offset < transport_subunit_count:
-            normalized_position = event_offset / float(max(1, transport_subunit_count))
-            value = _sample_controller_curve_value(normalized_keypoints, normalized_position)
-            if not events or events[-1].value != value:
-                events.append(ControllerSequencerEventRuntime(offset_subunit=event_offset, value=value))
-            event_offset += _CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM
 
-        if not events:
-            events.append(ControllerSequencerEventRuntime(offset_subunit=0, value=0))
+        slot_offsets = np.arange(0, max(1, transport_subunit_count), _CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM)
+        value_table = _bake_controller_curve_table(normalized_keypoints, slot_offsets, transport_subunit_count)
+        values = np.frombuffer(value_table, dtype=np.uint8)
+        # Run-length index: a new run starts at slot 0 and wherever the baked value changes.
+        run_start_mask = np.concatenate(([True], values[1:] != values[:-1]))
+        run_starts = np.flatnonzero(run_start_mask)
+        slot_event_index = np.cumsum(run_start_mask) - 1
+        events = tuple(
+            ControllerSequencerEventRuntime(offset_subunit=int(slot_offsets[slot]), value=int(values[slot]))
+            for slot in run_starts
+        )
 
         return ControllerSequencerPadRuntime(
             length_beats=length_beats,
             step_count=step_count,
             transport_subunit_count=transport_subunit_count,
-            events=tuple(events),
+            events=events,
             event_offsets=tuple(event.offset_subunit for event in events),
+            value_table=value_table,
+            slot_event_index=tuple(int(index) for index in slot_event_index),
+        )
+
+    @staticmethod
+    def _compile_pad_timeline(track: SequencerTrackRuntime, pad_index: int) -> SequencerPadTimeline:
+        pad = track.pads[pad_index]
+        step_count = SessionSequencerRuntime._step_count_for_pad(track, pad_index)
+        transport_subunit_count = SessionSequencerRuntime._transport_subunit_count_for_pad(track, pad_index)
+        step_span = SessionSequencerRuntime._transport_subunits_per_local_step(track)
+        event_offsets: list[int] = []
+        note_starts: list[int] = [0]
+        notes: list[int] = []
+        velocities: list[int] = []
+
+        # Offsets past the last step keep re-triggering it, matching the clamp in ``_local_step_for``.
+        for offset in range(0, transport_subunit_count, step_span):
+            step_index = min(step_count - 1, offset // step_span)
+            if step_index >= len(pad.steps):
+                break
+            step = pad.steps[step_index]
+            if not step.notes and step.hold:
+                continue
+            event_offsets.append(offset)
+            notes.extend(step.notes)
+            velocities.extend(step.velocity for _ in step.notes)
+            note_starts.append(len(notes))
+
+        event_ends = [*event_offsets[1:], transport_subunit_count]
+        durations = [
+            end - start
+            for index, (start, end) in enumerate(zip(event_offsets, event_ends))
+            for _ in range(note_starts[index], note_starts[index + 1])
+        ]
+        return SequencerPadTimeline(
+            event_offsets=tuple(event_offsets),
+            note_starts=tuple(note_starts),
+            notes=tuple(notes),
+            velocities=tuple(velocities),
+            durations=tuple(durations),
+        )
+
+    @staticmethod
+    def _compile_pad_loop_timeline(
+        track: SequencerTrackRuntime | ControllerSequencerTrackRuntime,
+    ) -> SequencerPadLoopTimeline | None:
+        sequence = track.pad_loop_sequence
+        if not sequence:
+            return None
+        token_offsets: list[int] = []
+        first_pass_pads: list[int] = []
+        offset = 0
+        last_pad = -1
+        for token in sequence:
+            token_offsets.append(offset)
+            offset += SessionSequencerRuntime._transport_subunit_count_for_loop_token(track, token)
+            if token in track.pads:
+                last_pad = token
+            first_pass_pads.append(last_pad)
+
+        repeat_pads: list[int] = []
+        last_pad = first_pass_pads[-1]
+        for token in sequence:
+            if token in track.pads:
+                last_pad = token
+            repeat_pads.append(last_pad)
+
+        return SequencerPadLoopTimeline(
+            token_offsets=tuple(token_offsets),
+            length=max(1, offset),
+            first_pass_pads=tuple(first_pass_pads),
+            repeat_pads=tuple(repeat_pads),
         )
 
     @staticmethod
@@ -2088,6 +2384,13 @@ class SessionSequencerRuntime:
                 pad_loop_sequence=self._normalize_pad_loop_sequence(track_request.pad_loop_sequence),
             )
 
+        for track in tracks.values():
+            for pad_index in track.pads:
+                track.pads[pad_index].timeline = self._compile_pad_timeline(track, pad_index)
+            track.pad_loop_timeline = self._compile_pad_loop_timeline(track)
+        for track in controller_tracks.values():
+            track.pad_loop_timeline = self._compile_pad_loop_timeline(track)
+
         playback_end_subunit = request.playback_end_step * _TRANSPORT_SUBUNITS_PER_STEP
         if "playback_end_step" not in request.model_fields_set:
             playback_end_subunit = max(
@@ -1,10 +1,13 @@
 from __future__ import annotations
 
 import asyncio
+from collections.abc import Iterable
 from dataclasses import dataclass, field
+from functools import lru_cache
 import logging
 from datetime import datetime, timezone
 import math
+import re
 import time
 from typing import Any
 from typing import Awaitable, Callable
@@ -13,8 +16,13 @@ from uuid import uuid4
 from fastapi import HTTPException
 
 from backend.app.core.config import Settings
-from backend.app.engine.csound_worker import CsoundWorker
-from backend.app.engine.midi_scheduler import ClockDomainMapping
+from backend.app.engine.csound_pool import CsoundInstancePool
+from backend.app.engine.csound_worker import CsoundWorker, EngineRenderResult
+from backend.app.engine.midi_scheduler import ClockDomainMapping, ScheduledMidiInput
+from backend.app.engine.render_ahead import BrowserClockRenderAhead
+from backend.app.engine.render_budget import RenderBudgetMonitor
+from backend.app.engine.render_executor import RenderExecutor
+from backend.app.engine.render_metrics import format_openmetrics
 from backend.app.engine.session_runtime import RuntimeSession
 from backend.app.models.patch import PatchDocument
 from backend.app.models.session import (
@@ -23,7 +31,11 @@ from backend.app.models.session import (
     BROWSER_CLOCK_MAX_REPORTED_FRAMES,
     BROWSER_CLOCK_MAX_SAMPLE_RATE,
     BrowserClockClaimControllerRequest,
+    BrowserClockClockSyncRequest,
     BrowserClockManualMidiRequest,
+    BrowserClockPcmEncoding,
+    BrowserClockRenderChunkFormat,
+    BrowserClockRenderStatsRequest,
     BrowserClockQueuePadControlRequest,
     BrowserClockReleaseControllerRequest,
     BrowserClockRequestRenderRequest,
@@ -49,19 +61,32 @@ from backend.app.models.session import (
     SessionCreateRequest,
     SessionCreateResponse,
     SessionEvent,
+    SessionHotReloadRequest,
+    SessionHotReloadResponse,
     SessionInfo,
     SessionInstrumentAssignment,
     SessionState,
 )
 from backend.app.services.compiler_service import CompilationError, CompilerService, PatchInstrumentTarget
 from backend.app.services.event_bus import SessionEventBus
+from backend.app.services.host_midi_protocol import (
+    HOST_MIDI_BINARY_PROTOCOL_VERSION,
+    HOST_MIDI_NO_TIMESTAMP,
+    decode_host_midi_frame,
+    negotiate_host_midi_protocol_version,
+)
 from backend.app.services.midi_service import INTERNAL_LOOPBACK_ID, INTERNAL_LOOPBACK_SELECTOR, MidiService
+from backend.app.services.orchestra_hot_swap import OrchestraHotSwapError, plan_orchestra_hot_swap
 from backend.app.services.patch_service import PatchService
 from backend.app.services.arpeggiator_runtime import MidiSourceContext, PerformanceMidiRouter
 from backend.app.services.sequencer_runtime import SessionSequencerRuntime
 
 logger = logging.getLogger(__name__)
 _BROWSER_TIMING_REPORT_INTERVAL_MS = 100
+_BROWSER_CLOCK_RENDER_AHEAD_WAIT_SECONDS = 1.0
+# Sync pairs the fitted clock line needs before it replaces the browser's own offset estimate.
+_BROWSER_CLOCK_MIN_FIT_SAMPLES = 8
+_INSTRUMENT_HEADER_PATTERN = re.compile(r"(?m)^\s*instr\s+([0-9A-Za-z_]+(?:\s*,\s*[0-9A-Za-z_]+)*)\s*$")
 
 BrowserClockSendJson = Callable[[dict[str, object]], Awaitable[None]]
 BrowserClockClose = Callable[[int, str], Awaitable[None]]
@@ -92,6 +117,31 @@ class BrowserClockControllerLease:
     last_note_on_sync_stale: bool = True
     manual_midi_tokens: float = 0.0
     manual_midi_last_refill_ns: int | None = None
+    render_ahead: BrowserClockRenderAhead | None = None
+    render_chunk_format: BrowserClockRenderChunkFormat = "json"
+    pcm_encoding: BrowserClockPcmEncoding = "f32le"
+
+
+@dataclass(slots=True)
+class BrowserClockRenderedChunk:
+    render: EngineRenderResult
+    sequencer_status: SessionSequencerStatus
+    telemetry: dict[str, object]
+
+    def json_metadata(self) -> dict[str, object]:
+        return {
+            "type": "render_chunk",
+            "chunk_id": str(uuid4()),
+            "engine_block_count": self.render.block_count,
+            "engine_sample_start": self.render.engine_sample_start,
+            "engine_sample_end": self.render.engine_sample_end,
+            "engine_sample_rate": self.render.engine_sample_rate,
+            "target_sample_rate": self.render.target_sample_rate,
+            "target_frame_count": self.render.target_frame_count,
+            "channels": self.render.channels,
+            "sequencer_status": self.sequencer_status.model_dump(mode="json"),
+            "telemetry": self.telemetry,
+        }
 
 
 @dataclass(slots=True)
@@ -101,6 +151,16 @@ class HostMidiBridgeLease:
     host_name: str | None = None
     protocol_version: int = 1
     timing_mapping: ClockDomainMapping = field(default_factory=ClockDomainMapping)
+    device_table: list[str] = field(default_factory=list)
+
+
+@dataclass(slots=True)
+class HostMidiSessionBatch:
+    runtime: RuntimeSession
+    controller_lease: BrowserClockControllerLease | None
+    inputs: list[ScheduledMidiInput] = field(default_factory=list)
+    # (request, end offset into ``inputs``, sync_stale) per decoded host event.
+    requests: list[tuple[SessionMidiEventRequest, int, bool]] = field(default_factory=list)
 
 
 @dataclass(slots=True)
@@ -123,12 +183,16 @@ class SessionService:
         compiler_service: CompilerService,
         midi_service: MidiService,
         event_bus: SessionEventBus,
+        render_executor: RenderExecutor,
+        csound_pool: CsoundInstancePool | None = None,
     ) -> None:
         self._settings = settings
+        self._csound_pool = csound_pool
         self._patch_service = patch_service
         self._compiler_service = compiler_service
         self._midi_service = midi_service
         self._event_bus = event_bus
+        self._render_executor = render_executor
         self._sessions: dict[str, RuntimeSession] = {}
         self._frontend_connections: dict[str, set[str]] = {}
         self._frontend_heartbeat_watchdogs: dict[str, dict[str, asyncio.Task[None]]] = {}
@@ -136,6 +200,9 @@ class SessionService:
         self._browser_clock_controllers: dict[str, BrowserClockControllerLease] = {}
         self._browser_clock_auto_stop_tasks: dict[str, asyncio.Task[None]] = {}
         self._host_midi_bridges: dict[str, HostMidiBridgeLease] = {}
+        # Copy-on-write index from bound MIDI input id to sessions. Rebuilt under ``_lock`` whenever a session
+        # is added, removed or rebound, and read without the lock on the host MIDI fan-out path.
+        self._midi_input_routes: dict[str, tuple[RuntimeSession, ...]] = {}
         self._session_clients: dict[str, str] = {}
         self._session_last_activity: dict[str, float] = {}
         self._session_idle_tasks: dict[str, asyncio.Task[None]] = {}
@@ -143,6 +210,8 @@ class SessionService:
         self._session_event_ws_connect_rate_buckets: dict[str, SessionEventWsConnectRateBucket] = {}
         self._pending_session_creates = 0
         self._pending_session_creates_by_client: dict[str, int] = {}
+        # Sessions whose render budget monitor last reported ``overloaded``.
+        self._overloaded_sessions: set[str] = set()
         self._lock = asyncio.Lock()
         self._loop: asyncio.AbstractEventLoop | None = None
 
@@ -170,6 +239,13 @@ class SessionService:
                 midi_input=default_midi,
                 worker=CsoundWorker(
                     gen_audio_assets_dir=str(self._settings.gen_audio_assets_dir),
+                    midi_subblock_frames=self._settings.browser_clock_midi_subblock_frames,
+                    instance_pool=self._csound_pool,
+                    midi_trace_capacity=self._settings.midi_trace_capacity,
+                    render_budget=RenderBudgetMonitor(
+                        warning_load=self._settings.render_budget_warning_load,
+                        overload_load=self._settings.render_budget_overload_load,
+                    ),
                 ),
             )
             runtime.midi_router = self._create_midi_router(runtime)
@@ -188,6 +264,7 @@ class SessionService:
 
             async with self._lock:
                 self._sessions[runtime.session_id] = runtime
+                self._rebuild_midi_input_routes_unlocked()
                 self._session_clients[runtime.session_id] = client_key
                 self._session_last_activity[runtime.session_id] = time.monotonic()
                 self._release_session_create_reservation_unlocked(client_key)
@@ -335,6 +412,90 @@ class SessionService:
             detail=result.detail,
         )
 
+    async def hot_reload_session(
+        self,
+        session_id: str,
+        request: SessionHotReloadRequest,
+    ) -> SessionHotReloadResponse:
+        self._remember_running_loop()
+        runtime = await self._get_session(session_id)
+        targets = [
+            self._compile_target_for_assignment(assignment)
+            for assignment in runtime.instruments
+        ]
+
+        try:
+            artifact = self._compiler_service.compile_patch_bundle(
+                targets=targets,
+                midi_input=self._resolve_runtime_midi_backend_selector(runtime),
+                rtmidi_module=self._settings.default_rtmidi_module,
+            )
+        except CompilationError as error:
+            # A failed edit leaves the running engine on its current orchestra.
+            await self._publish(runtime.session_id, "compile_failed", {"errors": " | ".join(error.diagnostics)})
+            raise HTTPException(status_code=422, detail={"diagnostics": error.diagnostics}) from error
+
+        previous_artifact = runtime.compile_artifact
+        if not runtime.worker.is_running or previous_artifact is None:
+            runtime.compile_artifact = artifact
+            if runtime.state != SessionState.RUNNING:
+                runtime.state = SessionState.COMPILED
+            await self._publish(runtime.session_id, "compiled", {"diagnostics": len(artifact.diagnostics)})
+            return SessionHotReloadResponse(
+                session_id=runtime.session_id,
+                state=runtime.state,
+                detail="compiled; session is not running",
+                diagnostics=artifact.diagnostics,
+            )
+
+        try:
+            plan = plan_orchestra_hot_swap(previous_artifact.orc, artifact.orc, voice_policy=request.voice_policy)
+        except OrchestraHotSwapError as error:
+            raise HTTPException(status_code=409, detail=str(error)) from error
+
+        if plan.is_empty:
+            runtime.compile_artifact = artifact
+            return SessionHotReloadResponse(
+                session_id=runtime.session_id,
+                state=runtime.state,
+                detail="no instrument changes",
+                diagnostics=artifact.diagnostics,
+            )
+
+        if not runtime.worker.supports_hot_swap:
+            # Keep the running artifact so a later hot reload still diffs against what the engine plays.
+            return SessionHotReloadResponse(
+                session_id=runtime.session_id,
+                state=runtime.state,
+                detail="hot swap unsupported by this engine backend; restart the session to apply changes",
+                diagnostics=artifact.diagnostics,
+            )
+
+        try:
+            detail = await self._render_executor.run(
+                runtime.session_id,
+                runtime.worker.hot_swap_orchestra,
+                plan.orc,
+                score_lines=plan.score_lines,
+            )
+        except Exception as exc:
+            await self._publish(runtime.session_id, "hot_reload_failed", {"error": str(exc)})
+            raise HTTPException(status_code=500, detail=f"Failed to hot-swap instruments: {exc}") from exc
+
+        runtime.compile_artifact = artifact
+        await self._publish(
+            runtime.session_id,
+            "hot_reloaded",
+            {"instruments": list(plan.changed_instruments), "voice_policy": request.voice_policy},
+        )
+        return SessionHotReloadResponse(
+            session_id=runtime.session_id,
+            state=runtime.state,
+            detail=detail,
+            swapped_instruments=list(plan.changed_instruments),
+            diagnostics=artifact.diagnostics,
+        )
+
     async def stop_session(self, session_id: str) -> SessionActionResponse:
         self._remember_running_loop()
         runtime = await self._get_session(session_id)
@@ -349,6 +510,7 @@ class SessionService:
         if runtime.midi_router is not None:
             runtime.midi_router.shutdown()
         detail = runtime.worker.stop()
+        self._overloaded_sessions.discard(session_id)
         runtime.state = SessionState.COMPILED if runtime.compile_artifact else SessionState.IDLE
 
         await self._publish(runtime.session_id, "stopped", {"detail": detail})
@@ -391,6 +553,8 @@ class SessionService:
             max_blocks_per_request=request.max_blocks_per_request,
             send_json=send_json,
             close=close,
+            render_chunk_format=request.render_chunk_format,
+            pcm_encoding=request.pcm_encoding,
         )
 
         async with self._lock:
@@ -412,6 +576,9 @@ class SessionService:
                 await previous.close(4002, "controller_revoked")
             except Exception:
                 logger.exception("Failed to close previous browser-clock controller for session '%s'", session_id)
+        if previous is not None:
+            await self._stop_browser_clock_render_ahead(previous)
+        self._start_browser_clock_render_ahead(runtime, lease)
 
         sequencer = self._ensure_sequencer(runtime)
         return {
@@ -427,6 +594,9 @@ class SessionService:
             "server_monotonic_ns": time.perf_counter_ns(),
             "timing_report_interval_ms": _BROWSER_TIMING_REPORT_INTERVAL_MS,
             "engine_ksmps_latency_frames": runtime.worker.runtime_ksmps,
+            "render_ahead_frames": 0 if lease.render_ahead is None else lease.render_ahead.lookahead_frames,
+            "render_chunk_format": lease.render_chunk_format,
+            "pcm_encoding": lease.pcm_encoding,
             "sequencer_status": self._status_with_arpeggiators(runtime, sequencer.status()).model_dump(mode="json"),
         }
 
@@ -446,6 +616,7 @@ class SessionService:
                 delay_seconds=self._settings.frontend_disconnect_grace_seconds,
             )
             should_schedule_auto_stop = True
+        await self._stop_browser_clock_render_ahead(lease)
 
         if should_schedule_auto_stop:
             logger.info(
@@ -487,6 +658,7 @@ class SessionService:
             event_perf_ms=request.event_perf_ms,
             mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
             sync_stale=sync_stale,
+            received_ns=event_server_received_ns,
         )
 
     async def browser_clock_timing_report(
@@ -515,6 +687,28 @@ class SessionService:
         lease.latest_clock_sync_rtt_ms = request.clock_sync_rtt_ms
         lease.last_timing_report_server_ns = server_now_ns
 
+    async def browser_clock_clock_sync(
+        self,
+        session_id: str,
+        connection_id: str,
+        request: BrowserClockClockSyncRequest,
+        *,
+        server_received_ns: int,
+    ) -> dict[str, object]:
+        self._remember_running_loop()
+        _runtime, lease = await self.require_browser_clock_controller(session_id, connection_id)
+        lease.timing_mapping.update(
+            remote_timestamp_ns=int(round(request.client_send_perf_ms * 1_000_000.0)),
+            server_timestamp_ns=server_received_ns,
+        )
+        return {
+            "type": "clock_sync",
+            "request_id": request.request_id,
+            "client_send_perf_ms": request.client_send_perf_ms,
+            "server_received_monotonic_ns": server_received_ns,
+            "server_sent_monotonic_ns": time.perf_counter_ns(),
+        }
+
     async def browser_clock_release_controller(
         self,
         session_id: str,
@@ -679,7 +873,7 @@ class SessionService:
         request: BrowserClockRequestRenderRequest,
         *,
         server_received_ns: int | None = None,
-    ) -> tuple[dict[str, object], bytes]:
+    ) -> BrowserClockRenderedChunk:
         self._remember_running_loop()
         runtime, lease = await self.require_browser_clock_controller(session_id, connection_id)
         if not runtime.worker.browser_clock_ready and runtime.worker.backend != "mock":
@@ -695,13 +889,56 @@ class SessionService:
                 ),
             )
         block_count = request.block_count
+        render_started_ns = time.perf_counter_ns()
+        runtime.worker.render_metrics.render_queue_wait.observe(
+            max(0, render_started_ns - request_received_ns) * 1e-9
+        )
+        if lease.render_ahead is not None:
+            render, latest_status = await self._read_browser_clock_render_ahead(runtime, lease, block_count)
+            render_completed_ns = time.perf_counter_ns()
+        else:
+            before_block, block_status = self._browser_clock_before_block(runtime)
+            try:
+                render = await self._render_executor.run(
+                    runtime.session_id,
+                    runtime.worker.render_blocks,
+                    block_count=block_count,
+                    target_sample_rate=lease.sample_rate,
+                    before_block=before_block,
+                )
+            except ValueError as exc:
+                raise HTTPException(status_code=422, detail=str(exc)) from exc
+            except RuntimeError as exc:
+                raise HTTPException(status_code=409, detail=str(exc)) from exc
+            except Exception as exc:
+                raise HTTPException(status_code=500, detail=f"Failed to render browser-clock audio: {exc}") from exc
+            latest_status = block_status()
+            render_completed_ns = time.perf_counter_ns()
+            self._drain_sequencer_notifications(runtime)
+        await self._apply_render_budget_transition(runtime)
+
+        return BrowserClockRenderedChunk(
+            render=render,
+            sequencer_status=latest_status,
+            telemetry=self._browser_clock_render_telemetry(
+                lease=lease,
+                request=request,
+                server_received_ns=request_received_ns,
+                server_render_start_ns=render_started_ns,
+                server_render_end_ns=render_completed_ns,
+            ),
+        )
+
+    def _browser_clock_before_block(
+        self,
+        runtime: RuntimeSession,
+    ) -> tuple[Callable[..., None], Callable[[], SessionSequencerStatus]]:
         sequencer = self._ensure_sequencer(runtime)
         router = self._ensure_midi_router(runtime)
-        latest_status = sequencer.status()
 
+        # Per block only the transport ticks; the status snapshot is built when a caller asks for it.
         def _before_block(_block_index: int, block_start_sample: int | None = None) -> None:
-            nonlocal latest_status
-            latest_status = sequencer.advance_render_block(
+            sequencer.tick_render_block(
                 sample_rate=runtime.worker.runtime_sample_rate,
                 ksmps=runtime.worker.runtime_ksmps,
             )
@@ -714,48 +951,93 @@ class SessionService:
                 block_start_sample=start_sample,
                 block_end_sample=start_sample + max(1, runtime.worker.runtime_ksmps),
                 sample_rate=max(1, runtime.worker.runtime_sample_rate),
-                tempo_bpm=latest_status.timing.tempo_bpm,
+                tempo_bpm=sequencer.tempo_bpm,
             )
-            latest_status = self._status_with_arpeggiators(runtime, latest_status)
 
-        render_started_ns = time.perf_counter_ns()
-        try:
-            render = await asyncio.to_thread(
-                runtime.worker.render_blocks,
-                block_count=block_count,
+        def _block_status() -> SessionSequencerStatus:
+            return self._status_with_arpeggiators(runtime, sequencer.status())
+
+        return _before_block, _block_status
+
+    @staticmethod
+    def _drain_sequencer_notifications(runtime: RuntimeSession) -> None:
+        if runtime.sequencer is not None:
+            runtime.sequencer.drain_notifications()
+
+    def _start_browser_clock_render_ahead(self, runtime: RuntimeSession, lease: BrowserClockControllerLease) -> None:
+        lookahead_blocks = self._settings.browser_clock_render_ahead_blocks
+        ksmps = max(1, runtime.worker.runtime_ksmps)
+        if lookahead_blocks <= 0 or not runtime.worker.is_running:
+            return
+        # The lookahead never exceeds the browser's own high-water mark, converted to engine frames.
+        high_water_engine_frames = int(
+            math.ceil(lease.queue_high_water_frames * runtime.worker.runtime_sample_rate / max(1, lease.sample_rate))
+        )
+        lookahead_frames = max(ksmps, min(lookahead_blocks * ksmps, high_water_engine_frames))
+        before_block, block_status = self._browser_clock_before_block(runtime)
+        sequencer = self._ensure_sequencer(runtime)
+
+        # Runs on the render worker after each block. Step and pad-switch events stay with the block that
+        # produced them and are published when it is delivered.
+        def _block_snapshot() -> tuple[SessionSequencerStatus, list[tuple[str, dict[str, Any]]]]:
+            return block_status(), sequencer.take_notifications()
+
+        render_ahead = BrowserClockRenderAhead(
+            worker=runtime.worker,
+            render_executor=self._render_executor,
+            session_id=runtime.session_id,
+            lookahead_frames=lookahead_frames,
+            max_request_frames=lease.max_blocks_per_request * ksmps,
+            before_block=before_block,
+            block_snapshot=_block_snapshot,
+            name=f"render-ahead-{runtime.session_id[:8]}",
+        )
+        lease.render_ahead = render_ahead
+        render_ahead.start()
+
+    @staticmethod
+    async def _stop_browser_clock_render_ahead(lease: BrowserClockControllerLease) -> None:
+        render_ahead = lease.render_ahead
+        if render_ahead is None:
+            return
+        lease.render_ahead = None
+        await asyncio.to_thread(render_ahead.stop)
+
+    async def _read_browser_clock_render_ahead(
+        self,
+        runtime: RuntimeSession,
+        lease: BrowserClockControllerLease,
+        block_count: int,
+    ) -> tuple[EngineRenderResult, SessionSequencerStatus]:
+        render_ahead = lease.render_ahead
+        assert render_ahead is not None
+        chunk = render_ahead.read_blocks(block_count)
+        if chunk is None:
+            await render_ahead.wait_for_blocks(block_count, _BROWSER_CLOCK_RENDER_AHEAD_WAIT_SECONDS)
+            chunk = render_ahead.read_blocks(block_count)
+        if chunk is None:
+            error = render_ahead.error
+            detail = str(error) if error is not None else "Browser-clock render-ahead did not produce audio in time."
+            raise HTTPException(status_code=409, detail=detail)
+        rendered, snapshots = chunk
+        worker = runtime.worker
+
+        def _encode() -> EngineRenderResult:
+            encode_started_ns = time.perf_counter_ns()
+            render = CsoundWorker.encode_engine_blocks(
+                rendered,
                 target_sample_rate=lease.sample_rate,
-                before_block=_before_block,
+                resampler=worker.resampler,
             )
-        except ValueError as exc:
-            raise HTTPException(status_code=422, detail=str(exc)) from exc
-        except RuntimeError as exc:
-            raise HTTPException(status_code=409, detail=str(exc)) from exc
-        except Exception as exc:
-            raise HTTPException(status_code=500, detail=f"Failed to render browser-clock audio: {exc}") from exc
-        render_completed_ns = time.perf_counter_ns()
+            worker.render_metrics.encode.observe((time.perf_counter_ns() - encode_started_ns) * 1e-9)
+            return render
 
-        return (
-            {
-                "type": "render_chunk",
-                "chunk_id": str(uuid4()),
-                "engine_block_count": render.block_count,
-                "engine_sample_start": render.engine_sample_start,
-                "engine_sample_end": render.engine_sample_end,
-                "engine_sample_rate": render.engine_sample_rate,
-                "target_sample_rate": render.target_sample_rate,
-                "target_frame_count": render.target_frame_count,
-                "channels": render.channels,
-                "sequencer_status": latest_status.model_dump(mode="json"),
-                "telemetry": self._browser_clock_render_telemetry(
-                    lease=lease,
-                    request=request,
-                    server_received_ns=request_received_ns,
-                    server_render_start_ns=render_started_ns,
-                    server_render_end_ns=render_completed_ns,
-                ),
-            },
-            render.pcm_f32le,
-        )
+        render = await self._render_executor.run(runtime.session_id, _encode)
+        sequencer = self._ensure_sequencer(runtime)
+        for _status, notifications in snapshots:
+            sequencer.publish_notifications(notifications)
+        latest_status = snapshots[-1][0] if snapshots else self._status_with_arpeggiators(runtime, sequencer.status())
+        return render, latest_status
 
     async def register_host_midi_bridge(
         self,
@@ -763,6 +1045,7 @@ class SessionService:
         request: HostMidiRegisterRequest,
     ) -> dict[str, object]:
         self._remember_running_loop()
+        protocol_version = negotiate_host_midi_protocol_version(request.protocol_version)
         replacement_host_ids: set[str] = set()
         async with self._lock:
             existing = self._host_midi_bridges.get(connection_id)
@@ -783,7 +1066,7 @@ class SessionService:
                 connection_id=connection_id,
                 host_id=request.host_id,
                 host_name=request.host_name,
-                protocol_version=request.protocol_version,
+                protocol_version=protocol_version,
             )
 
         for host_id in replacement_host_ids:
@@ -793,7 +1076,8 @@ class SessionService:
             "type": "host_registered",
             "host_id": request.host_id,
             "server_monotonic_ns": time.perf_counter_ns(),
-            "protocol_version": request.protocol_version,
+            "protocol_version": protocol_version,
+            "binary_midi_events": protocol_version >= HOST_MIDI_BINARY_PROTOCOL_VERSION,
         }
 
     async def host_midi_clock_sync(
@@ -849,50 +1133,136 @@ class SessionService:
             return
 
         lease = await self._require_host_midi_bridge(connection_id)
-        async with self._lock:
-            sessions_by_device: dict[str, list[tuple[RuntimeSession, BrowserClockControllerLease | None]]] = {}
-            for runtime in self._sessions.values():
-                if not runtime.worker.is_running or not runtime.midi_input:
-                    continue
-                sessions_by_device.setdefault(runtime.midi_input, []).append(
-                    (runtime, self._browser_clock_controllers.get(runtime.session_id))
+        await self._fan_out_host_midi_events(
+            lease,
+            ((event.device_id, event.timestamp_ns, *event.midi) for event in request.events),
+        )
+
+    async def host_midi_event_frame(self, connection_id: str, payload: bytes) -> None:
+        """Delivers a binary ``midi_events`` frame from a bridge that negotiated protocol version 2."""
+
+        self._remember_running_loop()
+        lease = await self._require_host_midi_bridge(connection_id)
+        if lease.protocol_version < HOST_MIDI_BINARY_PROTOCOL_VERSION:
+            raise HTTPException(
+                status_code=409,
+                detail="Binary host MIDI frames require protocol_version 2 at register_host.",
+            )
+        frame = decode_host_midi_frame(payload, lease.device_table)
+        if frame.record_count == 0:
+            return
+        device_table = lease.device_table
+        device_count = len(device_table)
+        await self._fan_out_host_midi_events(
+            lease,
+            (
+                (
+                    device_table[device_index] if device_index < device_count else None,
+                    None if timestamp_ns == HOST_MIDI_NO_TIMESTAMP else timestamp_ns,
+                    status,
+                    data1,
+                    data2,
                 )
+                for device_index, timestamp_ns, status, data1, data2 in frame.records()
+            ),
+        )
 
-        for event in request.events:
-            targets = sessions_by_device.get(event.device_id)
+    async def _fan_out_host_midi_events(
+        self,
+        lease: HostMidiBridgeLease,
+        events: Iterable[tuple[str | None, int | None, int, int, int]],
+    ) -> None:
+        routes = self._midi_input_routes
+        if not routes:
+            return
+
+        batches: dict[str, HostMidiSessionBatch] = {}
+        for device_id, timestamp_ns, status, data1, data2 in events:
+            targets = routes.get(device_id) if device_id is not None else None
             if not targets:
                 continue
 
+            midi_request = self._session_midi_request_from_bytes(status & 0xFF, data1 & 0x7F, data2 & 0x7F)
+            if midi_request is None:
+                continue
+            messages = self._midi_messages_for_request(midi_request)
+
             now_server_ns = time.perf_counter_ns()
             mapped_backend_monotonic_ns: int | None = None
             sync_stale = False
-            if event.timestamp_ns is not None:
+            if timestamp_ns is not None:
                 mapped_backend_monotonic_ns, sync_stale = lease.timing_mapping.map_to_server_time(
-                    event.timestamp_ns,
+                    timestamp_ns,
                     now_server_ns=now_server_ns,
                 )
                 if mapped_backend_monotonic_ns is None:
                     sync_stale = True
 
-            midi_request = self._session_midi_request_from_bytes(event.midi)
-            if midi_request is None:
-                continue
-
-            for runtime, controller_lease in targets:
+            for runtime in targets:
+                if not runtime.worker.is_running:
+                    continue
+                batch = batches.get(runtime.session_id)
+                if batch is None:
+                    batch = batches[runtime.session_id] = HostMidiSessionBatch(
+                        runtime=runtime,
+                        controller_lease=self._browser_clock_controllers.get(runtime.session_id),
+                    )
                 target_engine_sample = self._target_engine_sample_for_mapped_event(
                     runtime=runtime,
-                    lease=controller_lease,
+                    lease=batch.controller_lease,
                     mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
                     now_server_ns=now_server_ns,
                 )
-                await self._queue_session_midi_event(
-                    runtime,
-                    midi_request,
-                    source=f"host_bridge:{lease.host_id}",
-                    target_engine_sample=target_engine_sample,
-                    mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
-                    sync_stale=sync_stale,
-                )
+                for message in messages:
+                    batch.inputs.append(
+                        ScheduledMidiInput(
+                            message,
+                            target_engine_sample,
+                            mapped_backend_monotonic_ns,
+                            sync_stale,
+                            now_server_ns,
+                        )
+                    )
+                batch.requests.append((midi_request, len(batch.inputs), sync_stale))
+
+        source = f"host_bridge:{lease.host_id}"
+        rejected = False
+        for batch in batches.values():
+            rejected = not await self._queue_session_midi_batch(batch, source=source) or rejected
+        if rejected:
+            raise HTTPException(status_code=409, detail="Engine MIDI input queue rejected new MIDI events.")
+
+    async def _queue_session_midi_batch(self, batch: HostMidiSessionBatch, *, source: str) -> bool:
+        """Routes one session's share of a host MIDI batch with a single router call.
+
+        A request is published once, and only when every message it expanded to was accepted.
+        """
+
+        runtime = batch.runtime
+        accepted = self._ensure_midi_router(runtime).route_messages(batch.inputs, source=source)
+        all_accepted = True
+        start = 0
+        for request, end, sync_stale in batch.requests:
+            if all(accepted[start:end]):
+                payload = self._midi_event_payload(request, sync_stale=sync_stale)
+                await self._publish(runtime.session_id, "midi_event", payload)
+            else:
+                all_accepted = False
+            start = end
+        if not all_accepted:
+            await self._publish(
+                runtime.session_id,
+                "runtime_warning",
+                {"detail": "Engine MIDI input queue rejected new MIDI events."},
+            )
+        return all_accepted
+
+    def _rebuild_midi_input_routes_unlocked(self) -> None:
+        routes: dict[str, list[RuntimeSession]] = {}
+        for runtime in self._sessions.values():
+            if runtime.midi_input:
+                routes.setdefault(runtime.midi_input, []).append(runtime)
+        self._midi_input_routes = {device_id: tuple(targets) for device_id, targets in routes.items()}
 
     async def release_host_midi_bridge(self, connection_id: str) -> None:
         self._remember_running_loop()
@@ -905,11 +1275,17 @@ class SessionService:
 
     async def send_midi_event(self, session_id: str, request: SessionMidiEventRequest) -> SessionActionResponse:
         self._remember_running_loop()
+        received_ns = time.perf_counter_ns()
         runtime = await self._get_session(session_id)
         if not runtime.worker.is_running:
             raise HTTPException(status_code=409, detail="Session must be running to receive MIDI events.")
 
-        detail = await self._queue_session_midi_event(runtime, request, source="internal_api")
+        detail = await self._queue_session_midi_event(
+            runtime,
+            request,
+            source="internal_api",
+            received_ns=received_ns,
+        )
 
         return SessionActionResponse(session_id=runtime.session_id, state=runtime.state, detail=detail)
 
@@ -1065,6 +1441,108 @@ class SessionService:
         )
         return status
 
+    async def _apply_render_budget_transition(self, runtime: RuntimeSession) -> None:
+        """Reports a render budget state change and applies the configured degradations on overload.
+
+        Degradations stay in place for the life of the session, so a patch that only just fits does not
+        flap between tiers. Each one is reported in the ``render_budget`` event's ``actions``.
+        """
+
+        transition = runtime.worker.render_budget.take_transition()
+        if transition is None:
+            return
+
+        actions: list[dict[str, object]] = []
+        if transition.state == "overloaded":
+            self._overloaded_sessions.add(runtime.session_id)
+            for policy in self._settings.render_budget_policies:
+                try:
+                    detail = await self._apply_render_budget_policy(runtime, policy)
+                except RuntimeError as exc:
+                    actions.append({"policy": policy, "applied": False, "detail": str(exc)})
+                    continue
+                actions.append({"policy": policy, "applied": True, "detail": detail})
+        else:
+            self._overloaded_sessions.discard(runtime.session_id)
+
+        await self._publish(
+            runtime.session_id,
+            "render_budget",
+            {
+                "state": transition.state,
+                "previous_state": transition.previous_state,
+                "load": transition.load,
+                "headroom": 1.0 - transition.load,
+                "actions": actions,
+            },
+        )
+
+    async def _apply_render_budget_policy(self, runtime: RuntimeSession, policy: str) -> str:
+        worker = runtime.worker
+        if policy == "ksmps":
+            return f"ksmps scaled {worker.scale_ksmps_on_restart()}x from the next start"
+        if policy == "voice_limit":
+            csd = runtime.compile_artifact.csd if runtime.compile_artifact is not None else ""
+            instrument_refs = [
+                ref.strip()
+                for match in _INSTRUMENT_HEADER_PATTERN.finditer(csd)
+                for ref in match.group(1).split(",")
+            ]
+            return await self._render_executor.run(
+                runtime.session_id,
+                worker.limit_instrument_voices,
+                instrument_refs,
+                self._settings.render_budget_voice_limit,
+            )
+        if policy == "resampler":
+            worker.use_resampler("nearest")
+            return "nearest-frame resampler"
+        return "new sessions rejected while overloaded"
+
+    async def render_metrics_exposition(self) -> str:
+        async with self._lock:
+            runtimes = list(self._sessions.values())
+        return format_openmetrics(
+            (runtime.session_id, runtime.worker.render_metrics, runtime.worker.midi_overflow_count)
+            for runtime in runtimes
+        )
+
+    async def browser_clock_render_stats(
+        self,
+        session_id: str,
+        connection_id: str,
+        request: BrowserClockRenderStatsRequest,
+    ) -> dict[str, object]:
+        self._remember_running_loop()
+        runtime, _lease = await self.require_browser_clock_controller(session_id, connection_id)
+        return {
+            "type": "render_stats",
+            "request_id": request.request_id,
+            "midi_overflow_count": runtime.worker.midi_overflow_count,
+            **runtime.worker.render_metrics.compact_stats(),
+        }
+
+    async def get_session_midi_trace(self, session_id: str) -> dict[str, Any]:
+        self._remember_running_loop()
+        runtime = await self._get_session(session_id)
+        trace = runtime.worker.midi_trace
+        if trace is None:
+            raise HTTPException(
+                status_code=409,
+                detail="MIDI tracing is disabled; set VISUALCSOUND_MIDI_TRACE_CAPACITY to enable it.",
+            )
+        return trace.export_chrome_trace(session_id=session_id)
+
+    def record_browser_clock_chunk_sent(self, session_id: str, render: EngineRenderResult) -> None:
+        runtime = self._sessions.get(session_id)
+        trace = None if runtime is None else runtime.worker.midi_trace
+        if trace is not None:
+            trace.record_chunk_sent(
+                engine_sample_start=render.engine_sample_start,
+                engine_sample_end=render.engine_sample_end,
+                sent_ns=time.perf_counter_ns(),
+            )
+
     async def get_session_sequencer_status(self, session_id: str) -> SessionSequencerStatus:
         self._remember_running_loop()
         runtime = await self._get_session(session_id)
@@ -1080,7 +1558,9 @@ class SessionService:
         except ValueError as exc:
             raise HTTPException(status_code=404, detail=str(exc)) from exc
 
-        runtime.midi_input = resolved
+        async with self._lock:
+            runtime.midi_input = resolved
+            self._rebuild_midi_input_routes_unlocked()
 
         await self._publish(runtime.session_id, "midi_bound", {"midi_input": resolved})
 
@@ -1131,6 +1611,8 @@ class SessionService:
         idle_task_to_cancel: asyncio.Task[None] | None = None
         async with self._lock:
             self._sessions.pop(session_id, None)
+            self._overloaded_sessions.discard(session_id)
+            self._rebuild_midi_input_routes_unlocked()
             self._session_clients.pop(session_id, None)
             self._session_last_activity.pop(session_id, None)
             heartbeat_tasks = self._frontend_heartbeat_watchdogs.pop(session_id, {})
@@ -1139,6 +1621,7 @@ class SessionService:
             auto_stop_task_to_cancel = self._frontend_auto_stop_tasks.pop(session_id, None)
             browser_clock_auto_stop_task = self._browser_clock_auto_stop_tasks.pop(session_id, None)
             idle_task_to_cancel = self._session_idle_tasks.pop(session_id, None)
+        self._render_executor.release_session(session_id)
         for task in heartbeat_tasks_to_cancel:
             task.cancel()
         if auto_stop_task_to_cancel is not None:
@@ -1160,25 +1643,10 @@ class SessionService:
         event_perf_ms: float | None = None,
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> str:
-        channel = request.channel - 1
-        messages: list[list[int]] = []
-        if request.type == "note_on":
-            assert request.note is not None
-            messages.append([0x90 + channel, request.note, request.velocity])
-            detail = "note_on queued via engine:internal"
-        elif request.type == "note_off":
-            assert request.note is not None
-            messages.append([0x80 + channel, request.note, 0])
-            detail = "note_off queued via engine:internal"
-        elif request.type == "control_change":
-            assert request.controller is not None
-            assert request.value is not None
-            messages.append([0xB0 + channel, request.controller, request.value])
-            detail = "control_change queued via engine:internal"
-        else:
-            messages.extend([[0xB0 + channel, 123, 0], [0xB0 + channel, 120, 0]])
-            detail = "all_notes_off queued via engine:internal"
+        messages = self._midi_messages_for_request(request)
+        detail = f"{request.type} queued via engine:internal"
 
         source_timestamp_ns = (
             None
@@ -1193,7 +1661,7 @@ class SessionService:
                 mode=request.source_mode,
             )
             queued = router.route_message(
-                message,
+                list(message),
                 source=source,
                 target_engine_sample=target_engine_sample,
                 delivery_delay_seconds=None,
@@ -1201,6 +1669,7 @@ class SessionService:
                 mapped_backend_monotonic_ns=mapped_backend_monotonic_ns,
                 sync_stale=sync_stale,
                 source_context=source_context,
+                received_ns=received_ns,
             )
             if queued:
                 continue
@@ -1211,6 +1680,31 @@ class SessionService:
             )
             raise HTTPException(status_code=409, detail="Engine MIDI input queue rejected new MIDI events.")
 
+        payload = self._midi_event_payload(request, sync_stale=sync_stale)
+        await self._publish(runtime.session_id, "midi_event", payload)
+        return detail
+
+    @staticmethod
+    def _midi_messages_for_request(request: SessionMidiEventRequest) -> tuple[tuple[int, int, int], ...]:
+        channel = request.channel - 1
+        if request.type == "note_on":
+            assert request.note is not None
+            return ((0x90 + channel, request.note, request.velocity),)
+        if request.type == "note_off":
+            assert request.note is not None
+            return ((0x80 + channel, request.note, 0),)
+        if request.type == "control_change":
+            assert request.controller is not None
+            assert request.value is not None
+            return ((0xB0 + channel, request.controller, request.value),)
+        return ((0xB0 + channel, 123, 0), (0xB0 + channel, 120, 0))
+
+    @staticmethod
+    def _midi_event_payload(
+        request: SessionMidiEventRequest,
+        *,
+        sync_stale: bool,
+    ) -> dict[str, str | int | float | bool | None]:
         payload: dict[str, str | int | float | bool | None] = {
             "type": request.type,
             "channel": request.channel,
@@ -1225,9 +1719,7 @@ class SessionService:
             payload["value"] = request.value
         if sync_stale:
             payload["sync_stale"] = True
-
-        await self._publish(runtime.session_id, "midi_event", payload)
-        return detail
+        return payload
 
     def _target_engine_sample_for_browser_event(
         self,
@@ -1398,6 +1890,21 @@ class SessionService:
     async def _reserve_session_create(self, client_key: str) -> None:
         async with self._lock:
             now = time.monotonic()
+            # One heavy patch should not lock everyone out, so admission closes only once the overloaded share of
+            # running sessions reaches the configured fraction.
+            overloaded_count = len(self._overloaded_sessions)
+            if (
+                overloaded_count > 0
+                and "reject_sessions" in self._settings.render_budget_policies
+                and overloaded_count >= self._settings.render_budget_reject_fraction * len(self._sessions)
+            ):
+                raise HTTPException(
+                    status_code=503,
+                    detail=(
+                        f"Render capacity exhausted: {overloaded_count} of {len(self._sessions)} session(s) are "
+                        "over their real-time budget. Retry once they recover."
+                    ),
+                )
             active_total = len(self._sessions) + self._pending_session_creates
             if active_total >= self._settings.session_max_active:
                 raise HTTPException(
@@ -1579,6 +2086,7 @@ class SessionService:
     def _create_midi_router(self, runtime: RuntimeSession) -> PerformanceMidiRouter:
         return PerformanceMidiRouter(
             enqueue_timestamped_midi=runtime.worker.enqueue_timestamped_midi,
+            enqueue_timestamped_midi_batch=runtime.worker.enqueue_timestamped_midi_batch,
             current_engine_sample=lambda runtime=runtime: runtime.worker.render_sample_cursor,
             output_name="engine:internal",
             max_pending_inputs=self._settings.arpeggiator_pending_input_max_events,
@@ -1632,9 +2140,11 @@ class SessionService:
         if lease is None or perf_ms is None:
             return (None, True)
         remote_timestamp_ns = int(round(max(0.0, perf_ms) * 1_000_000.0))
-        if lease.latest_clock_sync_offset_ns is not None and not self._browser_timing_report_is_stale(
-            lease,
-            now_server_ns=now_server_ns,
+        estimate = lease.timing_mapping.estimate()
+        if (
+            (estimate is None or estimate.sample_count < _BROWSER_CLOCK_MIN_FIT_SAMPLES)
+            and lease.latest_clock_sync_offset_ns is not None
+            and not self._browser_timing_report_is_stale(lease, now_server_ns=now_server_ns)
         ):
             return (remote_timestamp_ns + int(lease.latest_clock_sync_offset_ns), False)
         mapped_server_ns, sync_stale = lease.timing_mapping.map_to_server_time(
@@ -1680,7 +2190,12 @@ class SessionService:
                 * (engine_sample_rate / float(report_sample_rate))
             )
         )
-        audible_sample_estimate = max(0, runtime.worker.render_sample_cursor - queued_engine_frames)
+        delivered_sample_cursor = (
+            runtime.worker.render_sample_cursor
+            if lease.render_ahead is None
+            else lease.render_ahead.delivered_sample_cursor
+        )
+        audible_sample_estimate = max(0, delivered_sample_cursor - queued_engine_frames)
         delta_ns = mapped_backend_monotonic_ns - now_server_ns
         target_sample = audible_sample_estimate + int(round((delta_ns * engine_sample_rate) / 1_000_000_000.0))
         return max(0, target_sample)
@@ -1707,6 +2222,8 @@ class SessionService:
         if lease is not None and lease.last_timing_report_server_ns is not None:
             timing_report_age_ms = max(0.0, (server_received_ns - lease.last_timing_report_server_ns) / 1_000_000.0)
 
+        clock_estimate = None if lease is None else lease.timing_mapping.estimate()
+
         note_on_to_render_request_ms = None
         note_on_to_render_complete_ms = None
         if lease is not None and not lease.last_note_on_sync_stale:
@@ -1724,6 +2241,9 @@ class SessionService:
             "timing_report_age_ms": timing_report_age_ms,
             "timing_sync_stale": timing_sync_stale,
             "clock_sync_rtt_ms": None if lease is None else lease.latest_clock_sync_rtt_ms,
+            "clock_skew_ppm": None if clock_estimate is None else clock_estimate.skew_ppm,
+            "clock_fit_residual_ms": None if clock_estimate is None else clock_estimate.residual_ns / 1_000_000.0,
+            "clock_rejected_samples": 0 if clock_estimate is None else clock_estimate.rejected_count,
             "websocket_message_wait_ms": websocket_message_wait_ms,
             "render_service_time_ms": max(0.0, (server_render_end_ns - server_render_start_ns) / 1_000_000.0),
             "server_received_monotonic_ns": server_received_ns,
@@ -1741,13 +2261,11 @@ class SessionService:
         return lease
 
     @staticmethod
-    def _session_midi_request_from_bytes(message: list[int]) -> SessionMidiEventRequest | None:
-        if len(message) != 3:
-            return None
-        status = int(message[0]) & 0xF0
-        channel = (int(message[0]) & 0x0F) + 1
-        data1 = int(message[1]) & 0x7F
-        data2 = int(message[2]) & 0x7F
+    @lru_cache(maxsize=4096)
+    def _session_midi_request_from_bytes(status_byte: int, data1: int, data2: int) -> SessionMidiEventRequest | None:
+        # Requests are read-only downstream, so one validated instance per distinct message is shared.
+        status = status_byte & 0xF0
+        channel = (status_byte & 0x0F) + 1
 
         if status == 0x90:
             if data2 == 0:
@@ -1803,6 +2321,7 @@ class SessionService:
             self._cancel_browser_clock_auto_stop_task_unlocked(session_id)
         if lease is None:
             return
+        await self._stop_browser_clock_render_ahead(lease)
         try:
             await lease.send_json({"type": "engine_error", "detail": detail})
         except Exception:
@@ -5,13 +5,16 @@ from io import BytesIO
 import json
 import os
 import queue
+import struct
 import time
 import threading
 from pathlib import Path
+from typing import Any
 import zipfile
 
 from fastapi.testclient import TestClient
 import mido
+import numpy as np
 from pydantic import ValidationError
 import pytest
 from starlette.testclient import WebSocketDenialResponse
@@ -27,15 +30,18 @@ from backend.app.models.patch import (
     MAX_GEN_RAW_ARG_TOKEN_LENGTH,
     MAX_GEN_TABLE_SIZE,
 )
+from backend.app.engine.browser_clock_frames import RENDER_CHUNK_HEADER
+from backend.app.engine.csound_worker import CsoundWorker, EngineBlockRender
+from backend.app.engine.offline_render import float_wav_header
 from backend.app.models.session import BROWSER_CLOCK_MAX_SAMPLE_RATE, MidiInputRef
 from backend.app.core.config import get_settings
 from backend.app.main import create_app
 from backend.app.services import performance_export_service
 from backend.app.services.gen_asset_service import GenAssetService
+from backend.app.services.host_midi_protocol import encode_host_midi_frame
 from backend.app.services.persisted_json_limits import PERSISTED_JSON_REQUEST_OVERHEAD_BYTES
 from backend.app.services.performance_export_service import (
     OfflineMidiExportBudgetExceededError,
-    OfflineMidiExportTimeoutError,
     PerformanceExportService,
 )
 
@@ -57,6 +63,13 @@ def _client(
     browser_clock_manual_midi_max_future_ms: float | None = None,
     browser_clock_manual_midi_rate_per_second: float | None = None,
     browser_clock_manual_midi_burst: int | None = None,
+    browser_clock_render_ahead_blocks: int | None = None,
+    midi_trace_capacity: int | None = None,
+    render_budget_warning_load: float | None = None,
+    render_budget_overload_load: float | None = None,
+    render_budget_policies: list[str] | None = None,
+    render_budget_reject_fraction: float | None = None,
+    offline_render_max_duration_seconds: float | None = None,
     session_max_active: int | None = None,
     session_max_active_per_client: int | None = None,
     session_create_rate_per_minute: float | None = None,
@@ -139,6 +152,34 @@ def _client(
         os.environ.pop("VISUALCSOUND_BROWSER_CLOCK_MANUAL_MIDI_BURST", None)
     else:
         os.environ["VISUALCSOUND_BROWSER_CLOCK_MANUAL_MIDI_BURST"] = str(browser_clock_manual_midi_burst)
+    if browser_clock_render_ahead_blocks is None:
+        os.environ.pop("VISUALCSOUND_BROWSER_CLOCK_RENDER_AHEAD_BLOCKS", None)
+    else:
+        os.environ["VISUALCSOUND_BROWSER_CLOCK_RENDER_AHEAD_BLOCKS"] = str(browser_clock_render_ahead_blocks)
+    if midi_trace_capacity is None:
+        os.environ.pop("VISUALCSOUND_MIDI_TRACE_CAPACITY", None)
+    else:
+        os.environ["VISUALCSOUND_MIDI_TRACE_CAPACITY"] = str(midi_trace_capacity)
+    if render_budget_warning_load is None:
+        os.environ.pop("VISUALCSOUND_RENDER_BUDGET_WARNING_LOAD", None)
+    else:
+        os.environ["VISUALCSOUND_RENDER_BUDGET_WARNING_LOAD"] = str(render_budget_warning_load)
+    if render_budget_overload_load is None:
+        os.environ.pop("VISUALCSOUND_RENDER_BUDGET_OVERLOAD_LOAD", None)
+    else:
+        os.environ["VISUALCSOUND_RENDER_BUDGET_OVERLOAD_LOAD"] = str(render_budget_overload_load)
+    if render_budget_policies is None:
+        os.environ.pop("VISUALCSOUND_RENDER_BUDGET_POLICIES", None)
+    else:
+        os.environ["VISUALCSOUND_RENDER_BUDGET_POLICIES"] = json.dumps(render_budget_policies)
+    if render_budget_reject_fraction is None:
+        os.environ.pop("VISUALCSOUND_RENDER_BUDGET_REJECT_FRACTION", None)
+    else:
+        os.environ["VISUALCSOUND_RENDER_BUDGET_REJECT_FRACTION"] = str(render_budget_reject_fraction)
+    if offline_render_max_duration_seconds is None:
+        os.environ.pop("VISUALCSOUND_OFFLINE_RENDER_MAX_DURATION_SECONDS", None)
+    else:
+        os.environ["VISUALCSOUND_OFFLINE_RENDER_MAX_DURATION_SECONDS"] = str(offline_render_max_duration_seconds)
     if session_max_active is None:
         os.environ.pop("VISUALCSOUND_SESSION_MAX_ACTIVE", None)
     else:
@@ -770,6 +811,44 @@ def test_runtime_config_maps_streaming_alias_to_browser_clock(tmp_path: Path) ->
         assert response.json()["browser_clock_enabled"] is True
 
 
+def test_runtime_config_reports_render_executor_workers(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client)
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                }
+            )
+            assert websocket.receive_json()["type"] == "stream_config"
+            websocket.send_json({"type": "request_render", "block_count": 2, "request_id": "executor-1"})
+            assert websocket.receive_json()["type"] == "render_chunk"
+            websocket.receive_bytes()
+
+        response = client.get("/api/runtime-config/render-executor")
+        assert response.status_code == 200
+        payload = response.json()
+        assert payload["worker_count"] == len(payload["workers"]) >= 1
+        assert sum(worker["pinned_sessions"] for worker in payload["workers"]) == 1
+        assert sum(worker["completed_tasks"] for worker in payload["workers"]) == 1
+        assert all(worker["queue_depth"] == 0 for worker in payload["workers"])
+
+
+def test_runtime_csound_pool_status_reports_empty_pool_for_mock_engine(tmp_path: Path) -> None:
+    with _client(tmp_path) as client:
+        response = client.get("/api/runtime-config/csound-pool")
+
+    assert response.status_code == 200
+    payload = response.json()
+    assert payload["target_size"] == 0
+    assert payload["idle_instances"] == 0
+    assert payload["start_latency_p99_ms"] is None
+
+
 def test_runtime_config_rejects_local_audio_output_mode(tmp_path: Path) -> None:
     with pytest.raises(ValidationError, match="VISUALCSOUND_AUDIO_OUTPUT_MODE=local is no longer supported"):
         _client(tmp_path, audio_output_mode="local")
@@ -780,6 +859,199 @@ def test_runtime_config_rejects_webrtc_audio_output_mode(tmp_path: Path) -> None
         _client(tmp_path, audio_output_mode="webrtc")
 
 
+def test_render_loop_metrics_reach_openmetrics_and_websocket_stats(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client)
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                }
+            )
+            assert websocket.receive_json()["type"] == "stream_config"
+            websocket.send_json({"type": "request_render", "block_count": 2, "request_id": "render-1"})
+            assert websocket.receive_json()["type"] == "render_chunk"
+            websocket.receive_bytes()
+
+            websocket.send_json({"type": "render_stats", "request_id": "stats-1"})
+            stats = websocket.receive_json()
+            assert stats["type"] == "render_stats"
+            assert stats["request_id"] == "stats-1"
+            assert stats["midi_overflow_count"] == 0
+            assert stats["render_queue_wait_ms"]["count"] == 1
+            assert stats["encode_ms"]["count"] == 1
+            assert stats["before_block_ms"]["count"] == 2
+
+        response = client.get("/api/runtime-config/metrics")
+        assert response.status_code == 200
+        assert response.headers["content-type"].startswith("application/openmetrics-text")
+        lines = response.text.splitlines()
+        assert f'visualcsound_render_before_block_seconds_count{{session_id="{session_id}"}} 2' in lines
+        assert f'visualcsound_midi_scheduler_overflow_total{{session_id="{session_id}"}} 0' in lines
+        assert lines[-1] == "# EOF"
+
+
+def test_render_budget_overload_publishes_event_and_applies_policies(tmp_path: Path) -> None:
+    with _client(
+        tmp_path,
+        audio_output_mode="browser_clock",
+        render_budget_warning_load=1e-9,
+        render_budget_overload_load=1e-9,
+        render_budget_policies=["ksmps", "voice_limit", "resampler", "reject_sessions"],
+    ) as client:
+        session_id = _create_running_session(client)
+        worker = client.app.state.container.session_service._sessions[session_id].worker
+        limit_instrument_voices = worker.limit_instrument_voices
+        voice_limit_threads: list[str] = []
+
+        def record_voice_limit_thread(*args: object) -> str:
+            voice_limit_threads.append(threading.current_thread().name)
+            return limit_instrument_voices(*args)
+
+        worker.limit_instrument_voices = record_voice_limit_thread
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}") as events:
+            with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+                websocket.send_json(
+                    {
+                        "type": "claim_controller",
+                        "audio_context_sample_rate": 48_000,
+                        "queue_low_water_frames": 1024,
+                        "queue_high_water_frames": 2048,
+                        "max_blocks_per_request": 8,
+                    }
+                )
+                assert websocket.receive_json()["type"] == "stream_config"
+                websocket.send_json({"type": "request_render", "block_count": 2, "request_id": "render-1"})
+                assert websocket.receive_json()["type"] == "render_chunk"
+                websocket.receive_bytes()
+
+            event = events.receive_json()
+            while event["type"] != "render_budget":
+                event = events.receive_json()
+
+        payload = event["payload"]
+        assert payload["state"] == "overloaded"
+        assert payload["previous_state"] == "ok"
+        assert payload["load"] > 0
+        assert [action["policy"] for action in payload["actions"]] == [
+            "ksmps",
+            "voice_limit",
+            "resampler",
+            "reject_sessions",
+        ]
+        assert all(action["applied"] for action in payload["actions"])
+        assert [name.startswith("render-worker-") for name in voice_limit_threads] == [True]
+
+        assert worker.ksmps_scale == 2
+        assert worker.resampler == "nearest"
+
+        patch_id = _create_basic_patch(client, name="Rejected While Overloaded")
+        rejected = client.post("/api/sessions", json={"patch_id": patch_id})
+        assert rejected.status_code == 503
+        assert "Render capacity exhausted" in rejected.json()["detail"]
+
+
+def test_render_budget_reject_sessions_waits_for_overloaded_share(tmp_path: Path) -> None:
+    with _client(
+        tmp_path,
+        audio_output_mode="browser_clock",
+        render_budget_warning_load=1e-9,
+        render_budget_overload_load=1e-9,
+        render_budget_policies=["reject_sessions"],
+        render_budget_reject_fraction=1.0,
+    ) as client:
+        overloaded_session_id = _create_running_session(client, patch_name="Overloaded Session")
+        _create_running_session(client, patch_name="Idle Session")
+
+        with client.websocket_connect(f"/ws/sessions/{overloaded_session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                }
+            )
+            assert websocket.receive_json()["type"] == "stream_config"
+            websocket.send_json({"type": "request_render", "block_count": 2, "request_id": "render-1"})
+            assert websocket.receive_json()["type"] == "render_chunk"
+            websocket.receive_bytes()
+
+        session_service = client.app.state.container.session_service
+        assert session_service._overloaded_sessions == {overloaded_session_id}
+
+        patch_id = _create_basic_patch(client, name="Admitted Beside Overload")
+        admitted = client.post("/api/sessions", json={"patch_id": patch_id})
+        assert admitted.status_code == 201
+
+
+def test_browser_clock_render_ahead_uses_degraded_resampler(tmp_path: Path, monkeypatch) -> None:
+    def signal(rendered: EngineBlockRender) -> EngineBlockRender:
+        sample_index = np.arange(rendered.engine_sample_start, rendered.engine_sample_end, dtype=np.float64)
+        wave = np.sin(sample_index * 0.37).astype(np.float32)
+        rendered.frames = np.stack((wave, wave), axis=1)
+        return rendered
+
+    with _client(
+        tmp_path,
+        audio_output_mode="browser_clock",
+        browser_clock_render_ahead_blocks=16,
+        render_budget_warning_load=1e-9,
+        render_budget_overload_load=1e-9,
+        render_budget_policies=["resampler"],
+    ) as client:
+        session_id = _create_running_session(client)
+        worker = client.app.state.container.session_service._sessions[session_id].worker
+        render_mock_blocks = worker._render_mock_blocks
+        monkeypatch.setattr(worker, "_render_mock_blocks", lambda **kwargs: signal(render_mock_blocks(**kwargs)))
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 44_100,
+                    "queue_low_water_frames": 256,
+                    "queue_high_water_frames": 512,
+                    "max_blocks_per_request": 16,
+                }
+            )
+            assert websocket.receive_json()["type"] == "stream_config"
+
+            chunks: list[tuple[dict[str, Any], bytes]] = []
+            for index in range(2):
+                websocket.send_json({"type": "request_render", "block_count": 4, "request_id": f"render-{index}"})
+                metadata = websocket.receive_json()
+                assert metadata["type"] == "render_chunk"
+                chunks.append((metadata, websocket.receive_bytes()))
+                if index == 0:
+                    assert worker.resampler == "nearest"
+
+        def expected_pcm(metadata: dict[str, Any], resampler: str) -> bytes:
+            rendered = signal(
+                EngineBlockRender(
+                    engine_sample_start=metadata["engine_sample_start"],
+                    engine_sample_end=metadata["engine_sample_end"],
+                    engine_sample_rate=48_000,
+                    block_count=metadata["engine_block_count"],
+                    frames=None,
+                )
+            )
+            return CsoundWorker.encode_engine_blocks(rendered, target_sample_rate=44_100, resampler=resampler).pcm_f32le
+
+        first_metadata, first_pcm = chunks[0]
+        second_metadata, second_pcm = chunks[1]
+        assert first_pcm == expected_pcm(first_metadata, "linear")
+        assert second_pcm == expected_pcm(second_metadata, "nearest")
+        assert second_pcm != expected_pcm(second_metadata, "linear")
+
+
 def test_browser_clock_client_assets_include_shared_array_buffer_headers(tmp_path: Path) -> None:
     with _client(tmp_path, audio_output_mode="browser_clock") as client:
         response = client.get("/client")
@@ -878,6 +1150,159 @@ def test_browser_clock_controller_websocket_streams_pcm_chunks(tmp_path: Path) -
             assert len(pcm) == metadata["target_frame_count"] * metadata["channels"] * 4
 
 
+def test_browser_clock_sync_pairs_replace_client_offset_once_fitted(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client)
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                }
+            )
+            assert websocket.receive_json()["type"] == "stream_config"
+
+            def render_wait_ms(request_id: str) -> float:
+                # The client reports an offset 10 s off; only the fitted line keeps the wait realistic.
+                websocket.send_json(
+                    {
+                        "type": "timing_report",
+                        "client_perf_ms": time.perf_counter() * 1000.0,
+                        "audio_context_time_s": 0.25,
+                        "queued_frames": 512,
+                        "sample_rate": 48_000,
+                        "clock_sync_offset_ns": -10_000_000_000,
+                    }
+                )
+                websocket.send_json(
+                    {
+                        "type": "request_render",
+                        "block_count": 1,
+                        "request_id": request_id,
+                        "client_perf_ms": time.perf_counter() * 1000.0,
+                        "priority": "steady",
+                    }
+                )
+                metadata = websocket.receive_json()
+                websocket.receive_bytes()
+                return metadata["telemetry"]["websocket_message_wait_ms"]
+
+            assert render_wait_ms("before-sync") > 9_000.0
+            for index in range(8):
+                websocket.send_json(
+                    {
+                        "type": "clock_sync",
+                        "request_id": f"clock-sync-{index}",
+                        "client_send_perf_ms": time.perf_counter() * 1000.0,
+                    }
+                )
+                assert websocket.receive_json()["request_id"] == f"clock-sync-{index}"
+            assert render_wait_ms("after-sync") < 1_000.0
+
+
+def test_browser_clock_render_ahead_serves_contiguous_chunks_from_ring(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock", browser_clock_render_ahead_blocks=16) as client:
+        session_id = _create_running_session(client)
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 256,
+                    "queue_high_water_frames": 512,
+                    "max_blocks_per_request": 16,
+                }
+            )
+            stream_config = websocket.receive_json()
+            assert stream_config["type"] == "stream_config"
+            # 16 blocks of 64 frames are capped by the 512-frame high-water mark.
+            assert stream_config["render_ahead_frames"] == 512
+
+            expected_start = 0
+            for index, block_count in enumerate((2, 12, 3)):
+                websocket.send_json(
+                    {
+                        "type": "request_render",
+                        "block_count": block_count,
+                        "request_id": f"render-ahead-{index}",
+                        "priority": "steady",
+                    }
+                )
+                metadata = websocket.receive_json()
+                assert metadata["type"] == "render_chunk"
+                assert metadata["engine_block_count"] == block_count
+                assert metadata["engine_sample_start"] == expected_start
+                assert metadata["engine_sample_end"] == expected_start + (block_count * 64)
+                assert metadata["sequencer_status"]["session_id"] == session_id
+                pcm = websocket.receive_bytes()
+                assert len(pcm) == block_count * 64 * 2 * 4
+                expected_start = metadata["engine_sample_end"]
+
+
+def test_browser_clock_binary_render_chunks_carry_header_and_int16_pcm(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client)
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                    "render_chunk_format": "binary",
+                    "pcm_encoding": "s16le",
+                }
+            )
+            stream_config = websocket.receive_json()
+            assert stream_config["render_chunk_format"] == "binary"
+            assert stream_config["pcm_encoding"] == "s16le"
+
+            for index in range(2):
+                websocket.send_json({"type": "request_render", "block_count": 2, "request_id": f"bin-{index}"})
+                frame = websocket.receive_bytes()
+                header = RENDER_CHUNK_HEADER.unpack_from(frame)
+                magic, version, pcm_encoding, channels, flags = header[:5]
+                assert (magic, version, pcm_encoding, channels) == (b"OCRC", 1, 1, 2)
+                assert header[5] == index
+                assert header[6:9] == (2, index * 128, (index + 1) * 128)
+                assert header[9:12] == (48_000, 48_000, 128)
+                json_length = header[-1]
+                if index == 0:
+                    assert flags & 0x01
+                    status = json.loads(frame[RENDER_CHUNK_HEADER.size : RENDER_CHUNK_HEADER.size + json_length])
+                    assert status["sequencer_status"]["session_id"] == session_id
+                else:
+                    assert flags == 0
+                    assert json_length == 0
+                assert len(frame) == RENDER_CHUNK_HEADER.size + json_length + 128 * 2 * 2
+
+
+def test_browser_clock_rejects_int16_pcm_without_binary_frames(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client)
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}/browser-clock") as websocket:
+            websocket.send_json(
+                {
+                    "type": "claim_controller",
+                    "audio_context_sample_rate": 48_000,
+                    "queue_low_water_frames": 1024,
+                    "queue_high_water_frames": 2048,
+                    "max_blocks_per_request": 8,
+                    "pcm_encoding": "s16le",
+                }
+            )
+            error = websocket.receive_json()
+            assert error["type"] == "engine_error"
+            assert "requires render_chunk_format" in error["detail"]
+
+
 def test_browser_clock_interactive_render_reports_note_on_latency(tmp_path: Path) -> None:
     with _client(tmp_path, audio_output_mode="browser_clock") as client:
         session_id = _create_running_session(client, patch_name="Browser Clock Telemetry")
@@ -1323,6 +1748,7 @@ def test_host_midi_bridge_inventory_and_external_event_delivery(tmp_path: Path)
                 registered = host_ws.receive_json()
                 assert registered["type"] == "host_registered"
                 assert registered["host_id"] == "host-a"
+                assert registered["binary_midi_events"] is False
 
                 host_ws.send_json(
                     {
@@ -1396,6 +1822,137 @@ def test_host_midi_bridge_inventory_and_external_event_delivery(tmp_path: Path)
             assert "sync_stale" not in internal_event_payload["payload"]
 
 
+def test_host_midi_bridge_negotiates_binary_event_frames(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock", host_midi_token="test-token") as client:
+        session_id = _create_running_session(client, patch_name="Host MIDI Binary Bridge")
+
+        with client.websocket_connect(f"/ws/sessions/{session_id}") as session_ws:
+            with client.websocket_connect("/ws/host-midi", headers={"authorization": "Bearer test-token"}) as host_ws:
+                host_ws.send_json(
+                    {"type": "register_host", "host_id": "host-b", "protocol_version": 5}
+                )
+                registered = host_ws.receive_json()
+                assert registered["protocol_version"] == 2
+                assert registered["binary_midi_events"] is True
+
+                host_ws.send_json(
+                    {
+                        "type": "device_inventory",
+                        "devices": [
+                            {
+                                "id": "host:pads:b",
+                                "name": "Host Pads",
+                                "backend": "host_bridge",
+                                "selector": "pads-b",
+                                "host_id": "host-b",
+                            }
+                        ],
+                    }
+                )
+                assert host_ws.receive_json()["type"] == "device_inventory_ack"
+
+                bound = client.put(f"/api/sessions/{session_id}/midi-input", json={"midi_input": "host:pads:b"})
+                assert bound.status_code == 200
+                assert session_ws.receive_json()["type"] == "midi_bound"
+
+                sender_table: dict[str, int] = {}
+                host_ws.send_bytes(
+                    encode_host_midi_frame(
+                        [
+                            ("host:other", None, [0x90, 10, 10]),
+                            ("host:pads:b", None, [0x90, 64, 99]),
+                        ],
+                        sender_table,
+                    )
+                )
+                note_on = session_ws.receive_json()
+                assert note_on["payload"]["type"] == "note_on"
+                assert note_on["payload"]["note"] == 64
+                assert note_on["payload"]["velocity"] == 99
+
+                host_ws.send_bytes(encode_host_midi_frame([("host:pads:b", 42, [0xB0, 7, 80])], sender_table))
+                control_change = session_ws.receive_json()
+                assert control_change["payload"]["type"] == "control_change"
+                assert control_change["payload"]["value"] == 80
+                assert control_change["payload"]["sync_stale"] is True
+
+                host_ws.send_bytes(b"VM\x02")
+                assert host_ws.receive_json()["type"] == "engine_error"
+
+
+def test_host_midi_bridge_fans_out_to_every_session_bound_to_the_device(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock", host_midi_token="test-token") as client:
+        first_session_id = _create_running_session(client, patch_name="Host Fan-out A")
+        second_session_id = _create_running_session(client, patch_name="Host Fan-out B")
+        session_service = client.app.state.container.session_service
+
+        with (
+            client.websocket_connect(f"/ws/sessions/{first_session_id}") as first_ws,
+            client.websocket_connect(f"/ws/sessions/{second_session_id}") as second_ws,
+            client.websocket_connect("/ws/host-midi", headers={"authorization": "Bearer test-token"}) as host_ws,
+        ):
+            host_ws.send_json({"type": "register_host", "host_id": "host-d", "protocol_version": 2})
+            assert host_ws.receive_json()["type"] == "host_registered"
+            host_ws.send_json(
+                {
+                    "type": "device_inventory",
+                    "devices": [
+                        {
+                            "id": "host:keys:d",
+                            "name": "Keys",
+                            "backend": "host_bridge",
+                            "selector": "keys-d",
+                            "host_id": "host-d",
+                        }
+                    ],
+                }
+            )
+            assert host_ws.receive_json()["type"] == "device_inventory_ack"
+
+            for session_id, session_ws in ((first_session_id, first_ws), (second_session_id, second_ws)):
+                bound = client.put(f"/api/sessions/{session_id}/midi-input", json={"midi_input": "host:keys:d"})
+                assert bound.status_code == 200
+                assert session_ws.receive_json()["type"] == "midi_bound"
+            assert [runtime.session_id for runtime in session_service._midi_input_routes["host:keys:d"]] == [
+                first_session_id,
+                second_session_id,
+            ]
+
+            host_ws.send_bytes(
+                encode_host_midi_frame(
+                    [("host:keys:d", None, [0x90, 60, 90]), ("host:keys:d", None, [0xB0, 123, 0])],
+                    {},
+                )
+            )
+            for session_ws in (first_ws, second_ws):
+                assert session_ws.receive_json()["payload"]["type"] == "note_on"
+                assert session_ws.receive_json()["payload"]["type"] == "all_notes_off"
+
+            rebound = client.put(
+                f"/api/sessions/{second_session_id}/midi-input",
+                json={"midi_input": "internal:loopback"},
+            )
+            assert rebound.status_code == 200
+            assert [runtime.session_id for runtime in session_service._midi_input_routes["host:keys:d"]] == [
+                first_session_id
+            ]
+
+        assert client.delete(f"/api/sessions/{first_session_id}").status_code in {200, 204}
+        assert "host:keys:d" not in session_service._midi_input_routes
+
+
+def test_host_midi_bridge_rejects_binary_frames_without_negotiation(tmp_path: Path) -> None:
+    with _client(tmp_path, host_midi_token="test-token") as client:
+        with client.websocket_connect("/ws/host-midi", headers={"authorization": "Bearer test-token"}) as host_ws:
+            host_ws.send_json({"type": "register_host", "host_id": "host-c", "protocol_version": 1})
+            assert host_ws.receive_json()["protocol_version"] == 1
+
+            host_ws.send_bytes(encode_host_midi_frame([("host:c", None, [0x90, 60, 1])], {}))
+            error = host_ws.receive_json()
+            assert error["type"] == "engine_error"
+            assert "protocol_version 2" in error["detail"]
+
+
 def test_bind_midi_input_normalizes_legacy_selector_to_stable_id(tmp_path: Path) -> None:
     with _client(tmp_path) as client:
         container = client.app.state.container
@@ -2008,6 +2565,34 @@ def test_add_opcodes_guide_exists_and_contains_key_references() -> None:
     assert "frontend/src/lib/documentation.ts" in text
 
 
+def test_session_hot_reload_reports_no_swap_on_mock_backend(tmp_path: Path) -> None:
+    with _client(tmp_path, audio_output_mode="browser_clock") as client:
+        session_id = _create_running_session(client, patch_name="Hot Reload Patch")
+        patch_id = client.get(f"/api/sessions/{session_id}").json()["patch_id"]
+        graph = client.get(f"/api/patches/{patch_id}").json()["graph"]
+
+        unchanged = client.post(f"/api/sessions/{session_id}/hot-reload")
+        assert unchanged.status_code == 200
+        assert unchanged.json()["detail"] == "no instrument changes"
+
+        runtime = client.app.state.container.session_service._sessions[session_id]
+        running_artifact = runtime.compile_artifact
+        graph["nodes"][0]["params"]["value"] = 0.4
+        assert client.put(f"/api/patches/{patch_id}", json={"graph": graph}).status_code == 200
+        unsupported = client.post(f"/api/sessions/{session_id}/hot-reload", json={"voice_policy": "cut"})
+        assert unsupported.status_code == 200
+        assert unsupported.json()["state"] == "running"
+        assert unsupported.json()["swapped_instruments"] == []
+        assert "restart the session" in unsupported.json()["detail"]
+        assert runtime.compile_artifact is running_artifact
+
+        graph["engine_config"]["sr"] = 44100
+        assert client.put(f"/api/patches/{patch_id}", json={"graph": graph}).status_code == 200
+        restart_required = client.post(f"/api/sessions/{session_id}/hot-reload")
+        assert restart_required.status_code == 409
+        assert client.get(f"/api/sessions/{session_id}").json()["state"] == "running"
+
+
 def test_patch_compile_and_runtime_flow(tmp_path: Path) -> None:
     with _client(tmp_path) as client:
         patch_payload = {
@@ -2685,6 +3270,31 @@ def test_session_midi_event_endpoint(tmp_path: Path) -> None:
         assert all_notes_off.status_code == 200
 
 
+def test_session_midi_trace_exports_enqueued_events_as_chrome_trace(tmp_path: Path) -> None:
+    with _client(tmp_path) as client:
+        session_id = _create_running_session(client)
+        disabled = client.get(f"/api/sessions/{session_id}/midi-trace")
+        assert disabled.status_code == 409
+        assert "MIDI_TRACE_CAPACITY" in disabled.json()["detail"]
+
+    with _client(tmp_path, midi_trace_capacity=64) as client:
+        session_id = _create_running_session(client)
+        note_on = client.post(
+            f"/api/sessions/{session_id}/midi-event",
+            json={"type": "note_on", "channel": 1, "note": 60, "velocity": 100},
+        )
+        assert note_on.status_code == 200
+
+        response = client.get(f"/api/sessions/{session_id}/midi-trace")
+        assert response.status_code == 200
+        trace_events = response.json()["traceEvents"]
+        spans = [event for event in trace_events if event["ph"] == "b" and event["name"] == "midi 903c64"]
+        assert len(spans) == 1
+        assert spans[0]["args"]["source"] == "internal_api"
+        stages = [event["name"] for event in trace_events if event["ph"] == "b" and event["id"] == spans[0]["id"]]
+        assert stages == ["midi 903c64", "receipt_to_enqueue"]
+
+
 def test_session_backend_sequencer_flow_with_pad_queue(tmp_path: Path) -> None:
     with _client(tmp_path) as client:
         patch_payload = {
@@ -3708,8 +4318,10 @@ def test_session_backend_sequencer_uses_step_velocity_for_note_on(tmp_path: Path
             source_timestamp_ns: int | None = None,
             mapped_backend_monotonic_ns: int | None = None,
             sync_stale: bool = False,
+            received_ns: int | None = None,
         ) -> bool:
             _ = (
+                received_ns,
                 source,
                 target_engine_sample,
                 delivery_delay_seconds,
@@ -3818,8 +4430,10 @@ def test_session_backend_sequencer_schedules_pad_switch_note_events_with_positiv
             source_timestamp_ns: int | None = None,
             mapped_backend_monotonic_ns: int | None = None,
             sync_stale: bool = False,
+            received_ns: int | None = None,
         ) -> bool:
             _ = (
+                received_ns,
                 source,
                 target_engine_sample,
                 source_timestamp_ns,
@@ -4088,8 +4702,10 @@ def test_session_backend_controller_sequencer_sends_control_changes_on_session_c
             source_timestamp_ns: int | None = None,
             mapped_backend_monotonic_ns: int | None = None,
             sync_stale: bool = False,
+            received_ns: int | None = None,
         ) -> bool:
             _ = (
+                received_ns,
                 source,
                 target_engine_sample,
                 delivery_delay_seconds,
@@ -5733,6 +6349,118 @@ def test_performance_csd_score_export_calls_routed_instruments_by_number(tmp_pat
             assert "f 0 2.5" in csd
 
 
+class _FakeOfflineCsound:
+    def __init__(self) -> None:
+        self.options: list[str] = []
+        self.csd = ""
+
+    def setOption(self, option: str) -> None:  # noqa: N802
+        self.options.append(option)
+
+    def compileCsdText(self, csd: str) -> int:  # noqa: N802
+        self.csd = csd
+        return 0
+
+    def start(self) -> int:
+        return 0
+
+    def perform(self) -> int:
+        output = Path(next(option[2:] for option in self.options if option.startswith("-o")))
+        level = 0.25 if "massign 2" in self.csd else 0.5
+        frames = struct.pack("<ff", level, -level) * 4
+        output.write_bytes(
+            float_wav_header(sample_rate=48_000, channels=2, frame_count=4) + frames
+        )
+        return 1
+
+    def cleanup(self) -> None:
+        return None
+
+
+class _FakeOfflineCtcsound:
+    def __init__(self) -> None:
+        self.instances: list[_FakeOfflineCsound] = []
+
+    def Csound(self) -> _FakeOfflineCsound:  # noqa: N802
+        instance = _FakeOfflineCsound()
+        self.instances.append(instance)
+        return instance
+
+
+def test_performance_csd_export_renders_per_channel_stems_and_mixdown(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+) -> None:
+    fake_ctcsound = _FakeOfflineCtcsound()
+    monkeypatch.setattr("backend.app.engine.offline_render.load_ctcsound_module", lambda: fake_ctcsound)
+    payload = _performance_csd_export_payload()
+    payload["renderAudio"] = True
+    performance_config = payload["performanceExport"]["performance"]["config"]  # type: ignore[index]
+    performance_config["instruments"].append({"patchId": "patch-1", "midiChannel": 2})  # type: ignore[index]
+    tracks = payload["sequencerConfig"]["tracks"]  # type: ignore[index]
+    tracks.append({**tracks[0], "track_id": "voice-2", "midi_channel": 2})
+
+    with _client(tmp_path) as client:
+        monkeypatch.delenv("VISUALCSOUND_FORCE_MOCK_ENGINE")
+        response = client.post("/api/bundles/export/performance-csd", json=payload)
+        assert response.status_code == 200
+
+    assert len(fake_ctcsound.instances) == 2
+    assert all("-n" not in instance.options for instance in fake_ctcsound.instances)
+    assert all("<CsOptions>" not in instance.csd for instance in fake_ctcsound.instances)
+    render_dirs = {
+        Path(next(option[2:] for option in instance.options if option.startswith("-o"))).parent
+        for instance in fake_ctcsound.instances
+    }
+    assert not any(render_dir.exists() for render_dir in render_dirs)
+
+    with zipfile.ZipFile(BytesIO(response.content), "r") as archive:
+        bundle_root = "Offline_Export"
+        stem_names = [f"{bundle_root}/stems/Offline_Export_ch01.wav", f"{bundle_root}/stems/Offline_Export_ch02.wav"]
+        for name in [f"{bundle_root}/Offline_Export.wav", *stem_names]:
+            assert archive.getinfo(name).compress_type == zipfile.ZIP_STORED
+        mixdown = archive.read(f"{bundle_root}/Offline_Export.wav")
+        assert struct.unpack("<ff", mixdown[44:52]) == (0.75, -0.75)
+        readme = archive.read(f"{bundle_root}/README.txt").decode("utf-8")
+        assert "- Offline_Export.wav: server-rendered 32-bit float mixdown" in readme
+        assert "- stems/:" in readme
+
+
+def test_performance_csd_export_render_audio_requires_ctcsound(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+) -> None:
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "1")
+    payload = _performance_csd_export_payload()
+    payload["renderAudio"] = True
+
+    with _client(tmp_path) as client:
+        response = client.post("/api/bundles/export/performance-csd", json=payload)
+        assert response.status_code == 503
+        assert "mock engine" in response.json()["detail"]
+
+
+def test_performance_csd_export_rejects_render_longer_than_limit(
+    tmp_path: Path,
+    monkeypatch: pytest.MonkeyPatch,
+) -> None:
+    fake_ctcsound = _FakeOfflineCtcsound()
+    monkeypatch.setattr("backend.app.engine.offline_render.load_ctcsound_module", lambda: fake_ctcsound)
+    payload = _performance_csd_export_payload()
+    payload["renderAudio"] = True
+
+    with _client(tmp_path, offline_render_max_duration_seconds=1.0) as client:
+        monkeypatch.delenv("VISUALCSOUND_FORCE_MOCK_ENGINE")
+        response = client.post("/api/bundles/export/performance-csd", json=payload)
+        assert response.status_code == 413
+        assert "1 s limit" in response.json()["detail"]
+
+        payload["renderAudio"] = False
+        assert client.post("/api/bundles/export/performance-csd", json=payload).status_code == 200
+
+    assert fake_ctcsound.instances == []
+
+
 def test_performance_csd_export_rejects_always_on_effect_route_loop(tmp_path: Path) -> None:
     effect_a_payload = _always_on_effect_with_outlets_patch_payload(name="Export Effect A")
     effect_b_payload = _always_on_effect_with_outlets_patch_payload(name="Export Effect B")
@@ -5848,7 +6576,7 @@ def test_performance_csd_export_rejects_huge_playback_range_before_export_work(
     def fail_if_export_starts(*_args: object, **_kwargs: object) -> bytes:
         raise AssertionError("performance CSD export work should not start for oversized playback range")
 
-    monkeypatch.setattr(PerformanceExportService, "build_performance_csd_archive", fail_if_export_starts)
+    monkeypatch.setattr(PerformanceExportService, "prepare_performance_csd_archive", fail_if_export_starts)
     payload = _performance_csd_export_payload()
     payload["sequencerConfig"]["playback_end_step"] = OFFLINE_CSD_EXPORT_MAX_PLAYBACK_STEPS + 1
 
@@ -5866,7 +6594,7 @@ def test_performance_csd_export_rejects_event_count_before_export_work(
     def fail_if_export_starts(*_args: object, **_kwargs: object) -> bytes:
         raise AssertionError("performance CSD export work should not start for oversized MIDI event count")
 
-    monkeypatch.setattr(PerformanceExportService, "build_performance_csd_archive", fail_if_export_starts)
+    monkeypatch.setattr(PerformanceExportService, "prepare_performance_csd_archive", fail_if_export_starts)
     payload = _performance_csd_export_payload()
     note_burst = list(range(16))
     base_track = payload["sequencerConfig"]["tracks"][0]
@@ -6099,7 +6827,7 @@ def test_performance_csd_export_rejects_oversized_step_note_list_before_export_w
     def fail_if_export_starts(*_args: object, **_kwargs: object) -> bytes:
         raise AssertionError("performance CSD export work should not start for oversized step note list")
 
-    monkeypatch.setattr(PerformanceExportService, "build_performance_csd_archive", fail_if_export_starts)
+    monkeypatch.setattr(PerformanceExportService, "prepare_performance_csd_archive", fail_if_export_starts)
     payload = _performance_csd_export_payload()
     payload["sequencerConfig"]["tracks"][0]["pads"][0]["steps"] = [
         {"note": list(range(17)), "hold": False, "velocity": 100}
@@ -6119,7 +6847,7 @@ def test_performance_csd_export_rejects_looping_playback_before_export_work(
     def fail_if_export_starts(*_args: object, **_kwargs: object) -> bytes:
         raise AssertionError("performance CSD export work should not start for looping playback")
 
-    monkeypatch.setattr(PerformanceExportService, "build_performance_csd_archive", fail_if_export_starts)
+    monkeypatch.setattr(PerformanceExportService, "prepare_performance_csd_archive", fail_if_export_starts)
     payload = _performance_csd_export_payload()
     payload["sequencerConfig"]["playback_loop"] = True
 
@@ -6246,20 +6974,19 @@ def test_performance_csd_export_midi_generation_includes_arpeggiator_output_note
     assert not any(channel == 5 and note == 64 for _tick, channel, note, _velocity in note_on_events)
 
 
-def test_performance_csd_export_midi_generation_enforces_wall_clock_timeout(
-    monkeypatch: pytest.MonkeyPatch,
-) -> None:
-    request = PerformanceCsdExportRequest.model_validate(_performance_csd_export_payload())
+def test_performance_csd_export_midi_generation_covers_full_length_arrangements() -> None:
+    payload = _performance_csd_export_payload()
+    payload["sequencerConfig"]["timing"] = _sequencer_timing(tempo_bpm=60, steps_per_beat=8)
+    payload["sequencerConfig"]["playback_end_step"] = OFFLINE_CSD_EXPORT_MAX_PLAYBACK_STEPS
+    request = PerformanceCsdExportRequest.model_validate(payload)
     exporter = PerformanceExportService(compiler_service=None, gen_asset_service=None)  # type: ignore[arg-type]
-    timer_values = iter([0.0, 10.0])
-    monkeypatch.setattr(performance_export_service, "_monotonic_seconds", lambda: next(timer_values))
 
-    with pytest.raises(OfflineMidiExportTimeoutError, match="exceeded"):
-        exporter._build_midi_file(
-            request=request,
-            controller_default_channels=(1,),
-            track_name="timeout",
-        )
+    events = exporter._capture_offline_midi_events(request=request, controller_default_channels=(1,))
+
+    note_on_times = [event.time_seconds for event in events if event.message[0] == 0x90 and event.message[2] > 0]
+    # 65,536 steps at 60 BPM is a bit over two hours of playback, one note per beat.
+    assert len(note_on_times) == OFFLINE_CSD_EXPORT_MAX_PLAYBACK_STEPS // 8
+    assert note_on_times[-1] == pytest.approx(OFFLINE_CSD_EXPORT_MAX_PLAYBACK_STEPS / 8 - 1)
 
 
 @pytest.mark.parametrize(
@@ -0,0 +1,59 @@
+from __future__ import annotations
+
+from io import BytesIO
+import os
+from pathlib import Path
+import zipfile
+
+from backend.app.services import archive_stream
+from backend.app.services.archive_stream import ArchiveBytesEntry, ArchiveFileEntry, iter_zip_archive
+
+
+def test_iter_zip_archive_streams_a_valid_archive_with_bytes_and_file_entries(tmp_path: Path) -> None:
+    sample = tmp_path / "sample.wav"
+    sample_bytes = os.urandom(300_000)
+    sample.write_bytes(sample_bytes)
+    empty = tmp_path / "empty.sf2"
+    empty.write_bytes(b"")
+
+    archive_bytes = b"".join(
+        iter_zip_archive(
+            [
+                ArchiveBytesEntry("bundle/README.txt", b"hello"),
+                ArchiveFileEntry("bundle/assets/sample.wav", sample),
+                ArchiveFileEntry("bundle/render/sample.wav", sample, compress_type=zipfile.ZIP_STORED),
+                ArchiveFileEntry("bundle/assets/empty.sf2", empty),
+            ]
+        )
+    )
+
+    with zipfile.ZipFile(BytesIO(archive_bytes)) as archive:
+        assert archive.testzip() is None
+        assert archive.read("bundle/README.txt") == b"hello"
+        assert archive.read("bundle/assets/sample.wav") == sample_bytes
+        assert archive.read("bundle/render/sample.wav") == sample_bytes
+        assert archive.read("bundle/assets/empty.sf2") == b""
+        assert archive.getinfo("bundle/assets/sample.wav").compress_type == zipfile.ZIP_DEFLATED
+        assert archive.getinfo("bundle/render/sample.wav").compress_type == zipfile.ZIP_STORED
+
+
+def test_iter_zip_archive_yields_file_entries_in_bounded_chunks(monkeypatch, tmp_path: Path) -> None:
+    monkeypatch.setattr(archive_stream, "ARCHIVE_STREAM_CHUNK_BYTES", 4096)
+    sample = tmp_path / "sample.wav"
+    sample.write_bytes(os.urandom(64 * 4096))
+
+    pieces = list(iter_zip_archive([ArchiveFileEntry("sample.wav", sample, compress_type=zipfile.ZIP_STORED)]))
+
+    assert len(pieces) >= 64
+    assert max(len(piece) for piece in pieces) <= 4096
+    with zipfile.ZipFile(BytesIO(b"".join(pieces))) as archive:
+        assert archive.read("sample.wav") == sample.read_bytes()
+
+
+def test_iter_zip_archive_is_lazy_until_iterated(tmp_path: Path) -> None:
+    missing = tmp_path / "later.wav"
+    stream = iter_zip_archive([ArchiveFileEntry("later.wav", missing)])
+    missing.write_bytes(b"written after the stream was created")
+
+    with zipfile.ZipFile(BytesIO(b"".join(stream))) as archive:
+        assert archive.read("later.wav") == b"written after the stream was created"
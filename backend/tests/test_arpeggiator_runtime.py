@@ -1,13 +1,17 @@
 from __future__ import annotations
 
+import random
+
 import pytest
 from pydantic import ValidationError
 
+from backend.app.engine.midi_scheduler import ScheduledMidiInput
 from backend.app.models.session import (
     SessionArpeggiatorConfig,
     SessionSequencerConfigRequest,
 )
-from backend.app.services.arpeggiator_runtime import PerformanceMidiRouter
+from backend.app.services import arpeggiator_runtime
+from backend.app.services.arpeggiator_runtime import HeldNoteSet, PerformanceMidiRouter
 from backend.app.services.sequencer_runtime import SessionSequencerRuntime
 
 
@@ -26,6 +30,7 @@ class _CaptureMidi:
         source_timestamp_ns: int | None = None,
         mapped_backend_monotonic_ns: int | None = None,
         sync_stale: bool = False,
+        received_ns: int | None = None,
     ) -> bool:
         _ = (
             source,
@@ -33,6 +38,7 @@ class _CaptureMidi:
             source_timestamp_ns,
             mapped_backend_monotonic_ns,
             sync_stale,
+            received_ns,
         )
         self.messages.append((list(message), target_engine_sample))
         return True
@@ -76,6 +82,40 @@ def _advance_router(router: PerformanceMidiRouter, *, start: int = 0, end: int =
     )
 
 
+def test_route_messages_captures_arpeggiator_inputs_and_batches_the_rest() -> None:
+    capture = _CaptureMidi()
+    batches: list[tuple[list[ScheduledMidiInput], str]] = []
+
+    def enqueue_batch(inputs: list[ScheduledMidiInput], *, source: str) -> int:
+        batches.append((list(inputs), source))
+        return 1
+
+    router = PerformanceMidiRouter(
+        enqueue_timestamped_midi=capture.enqueue_timestamped_midi,
+        enqueue_timestamped_midi_batch=enqueue_batch,
+        current_engine_sample=lambda: capture.current_sample,
+    )
+    router.configure([_arp_config()], tempo_bpm=120)
+
+    accepted = router.route_messages(
+        [
+            ScheduledMidiInput((0x90, 60, 100), 10),
+            ScheduledMidiInput((0x91, 64, 100), 10),
+            ScheduledMidiInput((0xB0, 7, 90), 12),
+        ],
+        source="host_bridge:a",
+    )
+
+    assert accepted == [True, True, False]
+    assert capture.messages == []
+    assert len(batches) == 1
+    assert [item.message for item in batches[0][0]] == [(0x90, 60, 100), (0xB0, 7, 90)]
+    assert batches[0][1] == "host_bridge:a"
+    assert router.status()[0].held_notes == []
+    _advance_router(router, start=64, end=128)
+    assert router.status()[0].held_notes == [64]
+
+
 def test_arpeggiator_consumes_input_and_emits_target_channel_note() -> None:
     capture = _CaptureMidi()
     router = _router(capture)
@@ -195,3 +235,48 @@ def test_sequencer_notes_can_drive_arpeggiator_target_instrument() -> None:
     _advance_router(router)
 
     assert [message for message, _sample in capture.messages if message[0] & 0xF0 == 0x90] == [[0x90, 60, 100]]
+
+
+def test_held_note_set_maintains_pattern_orders_incrementally() -> None:
+    held = HeldNoteSet()
+    for note in (64, 60, 67):
+        held.add(note, 100)
+    rng = random.Random(0)
+
+    def notes(pattern: str, octaves: int = 1) -> list[int]:
+        return [entry.note for entry in held.ordered(pattern, octaves, rng)]
+
+    assert notes("up") == [60, 64, 67]
+    assert notes("down") == [67, 64, 60]
+    assert notes("up_down") == [60, 64, 67, 64]
+    assert notes("inside_out") == [64, 60, 67]
+    assert notes("as_played") == [64, 60, 67]
+    assert notes("up", octaves=2) == [60, 64, 67, 72, 76, 79]
+
+    held.add(64, 90)
+    held.discard(60)
+    assert list(held) == [64, 67]
+    assert notes("as_played") == [67, 64]
+    assert held.ordered("as_played", 1, rng)[1].velocity == 90
+    assert 60 not in held and len(held) == 2
+
+
+def test_random_pattern_plays_every_held_note_once_per_cycle() -> None:
+    held = HeldNoteSet()
+    for note in (60, 62, 64, 65, 67):
+        held.add(note, 100)
+    rng = random.Random(7)
+
+    for _ in range(4):
+        cycle = [entry.note for entry in held.ordered("random", 1, rng, reshuffle=True)]
+        assert sorted(cycle) == [60, 62, 64, 65, 67]
+
+
+def test_scale_quantize_tables_match_nearest_allowed_note() -> None:
+    for root, root_pc in arpeggiator_runtime._ROOT_PITCH_CLASS.items():
+        for mode, intervals in arpeggiator_runtime._MODE_INTERVALS.items():
+            allowed = {(root_pc + interval) % 12 for interval in intervals}
+            for note in range(128):
+                candidates = [c for c in range(max(0, note - 6), min(127, note + 6) + 1) if c % 12 in allowed]
+                expected = min(candidates, key=lambda c: (abs(c - note), c)) if candidates else note
+                assert PerformanceMidiRouter._quantize_note_to_scale(note, root, mode) == expected
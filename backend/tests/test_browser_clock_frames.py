@@ -0,0 +1,156 @@
+from __future__ import annotations
+
+import json
+import math
+
+import numpy as np
+
+from backend.app.engine.browser_clock_frames import (
+    RENDER_CHUNK_FLAG_STATUS_DELTA,
+    RENDER_CHUNK_HEADER,
+    BrowserClockRenderChunkEncoder,
+    encode_pcm_s16le_dithered,
+)
+from backend.app.engine.lossless_pcm import RICE24_FULL_SCALE, decode_pcm_rice24
+from backend.app.models.session import (
+    SessionSequencerStatus,
+    SessionSequencerTimingConfig,
+    SessionSequencerTrackStatus,
+)
+
+
+def _status(
+    *,
+    transport_subunit: int,
+    running: bool,
+    current_step: int = 0,
+    tracks: list[SessionSequencerTrackStatus] | None = None,
+) -> SessionSequencerStatus:
+    return SessionSequencerStatus(
+        session_id="session-1",
+        running=running,
+        timing=SessionSequencerTimingConfig(tempo_bpm=120),
+        step_count=16,
+        current_step=current_step,
+        cycle=0,
+        transport_subunit=transport_subunit,
+        tracks=tracks or [],
+    )
+
+
+def _track(track_id: str, *, local_step: int) -> SessionSequencerTrackStatus:
+    return SessionSequencerTrackStatus(
+        track_id=track_id,
+        midi_channel=1,
+        timing=SessionSequencerTimingConfig(tempo_bpm=120),
+        length_beats=4,
+        step_count=16,
+        local_step=local_step,
+        active_pad=0,
+    )
+
+
+def _encode(encoder: BrowserClockRenderChunkEncoder, status: SessionSequencerStatus, pcm: bytes) -> bytes:
+    return encoder.encode(
+        engine_sample_start=128,
+        engine_sample_end=256,
+        engine_sample_rate=48_000,
+        target_sample_rate=44_100,
+        target_frame_count=len(pcm) // 8,
+        block_count=2,
+        channels=2,
+        pcm_f32le=pcm,
+        sequencer_status=status,
+        telemetry={"render_service_time_ms": 1.5, "websocket_message_wait_ms": None},
+    )
+
+
+def _decode(frame: bytes) -> tuple[tuple, dict | None, bytes]:
+    header = RENDER_CHUNK_HEADER.unpack_from(frame)
+    json_length = header[-1]
+    body = frame[RENDER_CHUNK_HEADER.size : RENDER_CHUNK_HEADER.size + json_length]
+    payload = json.loads(body) if json_length else None
+    return header, payload, frame[RENDER_CHUNK_HEADER.size + json_length :]
+
+
+def test_binary_render_chunk_sends_status_only_when_it_changes() -> None:
+    encoder = BrowserClockRenderChunkEncoder()
+    pcm = np.linspace(-1.0, 1.0, num=8, dtype=np.float32).tobytes()
+
+    header, payload, body = _decode(_encode(encoder, _status(transport_subunit=10, running=True), pcm))
+    assert header[0] == b"OCRC"
+    assert header[1:9] == (1, 0, 2, RENDER_CHUNK_FLAG_STATUS_DELTA, 0, 2, 128, 256)
+    assert header[9:13] == (48_000, 44_100, 4, 10)
+    assert header[13] == 1.5
+    assert math.isnan(header[14])
+    assert payload is not None and payload["sequencer_status"]["running"] is True
+    assert "transport_subunit" not in payload["sequencer_status"]
+    assert (RENDER_CHUNK_HEADER.size + header[-1]) % 4 == 0
+    assert body == pcm
+
+    header, payload, _body = _decode(_encode(encoder, _status(transport_subunit=20, running=True), pcm))
+    assert header[4] == 0
+    assert header[5] == 1
+    assert header[12] == 20
+    assert payload is None
+
+    _header, payload, _body = _decode(
+        _encode(encoder, _status(transport_subunit=30, running=True, current_step=1), pcm)
+    )
+    assert payload == {"sequencer_status": {"current_step": 1}}
+
+
+def test_binary_render_chunk_resends_only_changed_track_entries() -> None:
+    encoder = BrowserClockRenderChunkEncoder()
+    pcm = np.zeros(8, dtype=np.float32).tobytes()
+    tracks = [_track("a", local_step=0), _track("b", local_step=0)]
+    _encode(encoder, _status(transport_subunit=0, running=True, tracks=tracks), pcm)
+
+    _header, payload, _body = _decode(
+        _encode(
+            encoder,
+            _status(transport_subunit=1, running=True, tracks=[_track("a", local_step=1), _track("b", local_step=0)]),
+            pcm,
+        )
+    )
+    assert payload is not None
+    assert payload["sequencer_status"] == {}
+    assert [track["track_id"] for track in payload["sequencer_status_entries"]["tracks"]] == ["a"]
+    assert payload["sequencer_status_entries"]["tracks"][0]["local_step"] == 1
+
+    _header, payload, _body = _decode(
+        _encode(encoder, _status(transport_subunit=2, running=True, tracks=[_track("b", local_step=0)]), pcm)
+    )
+    assert payload is not None
+    assert [track["track_id"] for track in payload["sequencer_status"]["tracks"]] == ["b"]
+    assert "sequencer_status_entries" not in payload
+
+
+def test_s16_encoding_dithers_within_one_lsb() -> None:
+    source = np.array([0.0, 0.5, -0.5, 1.0, -1.0, 2.0], dtype=np.float32)
+    encoded = np.frombuffer(encode_pcm_s16le_dithered(source.tobytes()), dtype="<i2")
+
+    expected = np.clip(source * 32767.0, -32768, 32767)
+    assert encoded.dtype == np.dtype("<i2")
+    assert np.all(np.abs(encoded.astype(np.float64) - expected) <= 1.0)
+    assert encoded[-1] == 32767
+
+
+def test_rice24_encoding_round_trips_int24_samples_and_compresses() -> None:
+    frame_count = 1024
+    t = np.arange(frame_count) / 48_000
+    rng = np.random.default_rng(7)
+    left = 0.5 * np.sin(2 * np.pi * 440 * t) + 0.001 * rng.standard_normal(frame_count)
+    right = 0.25 * np.sin(2 * np.pi * 110 * t)
+    stereo = np.stack((left, right), axis=1).astype(np.float32)
+    pcm = stereo.tobytes()
+
+    encoder = BrowserClockRenderChunkEncoder(pcm_encoding="rice24")
+    header, _payload, body = _decode(_encode(encoder, _status(transport_subunit=0, running=False), pcm))
+
+    assert header[2] == 2
+    assert len(body) * 2 < len(pcm)
+    decoded = decode_pcm_rice24(body, channels=2, frame_count=frame_count)
+    scaled = np.rint(stereo.reshape(-1).astype(np.float64) * RICE24_FULL_SCALE)
+    expected = np.clip(scaled, -RICE24_FULL_SCALE - 1, RICE24_FULL_SCALE).astype(np.int64)
+    assert np.array_equal(decoded, expected)
@@ -471,3 +471,81 @@ def test_stereo_reverbs_compile_with_manual_argument_order(opcode_name: str, exp
         reverb_line
         == f"a_rvb_aout_l_3, a_rvb_aout_r_4 {opcode_name} a_left_aout_1, a_right_aout_2, {expected_tail}"
     )
+
+
+def _cacheable_patch(patch_id: str = "cached-patch", value: float = 0.1) -> PatchDocument:
+    return PatchDocument(
+        id=patch_id,
+        name="cache test",
+        graph=PatchGraph(
+            nodes=[
+                NodeInstance(id="sig", opcode="const_a", params={"value": value}),
+                NodeInstance(id="out", opcode="outs"),
+            ],
+            connections=[
+                Connection(from_node_id="sig", from_port_id="aout", to_node_id="out", to_port_id="left"),
+                Connection(from_node_id="sig", from_port_id="aout", to_node_id="out", to_port_id="right"),
+            ],
+        ),
+    )
+
+
+def _count_graph_compiles(monkeypatch) -> list[str]:
+    import backend.app.services.compiler_service as compiler_service_module
+
+    calls: list[str] = []
+    original = compiler_service_module.compile_graph_context
+
+    def counting_compile_graph_context(graph, opcode_service):
+        calls.append(",".join(node.id for node in graph.nodes))
+        return original(graph, opcode_service)
+
+    monkeypatch.setattr(compiler_service_module, "compile_graph_context", counting_compile_graph_context)
+    return calls
+
+
+def test_compile_cache_reuses_unchanged_instruments_and_recompiles_edited_ones(monkeypatch) -> None:
+    calls = _count_graph_compiles(monkeypatch)
+    compiler = CompilerService(OpcodeService(icon_prefix="/static/icons"))
+
+    first = compiler.compile_patch(_cacheable_patch(), midi_input="0", rtmidi_module="alsaseq")
+    second = compiler.compile_patch(_cacheable_patch(), midi_input="0", rtmidi_module="alsaseq")
+    edited = compiler.compile_patch(_cacheable_patch(value=0.2), midi_input="0", rtmidi_module="alsaseq")
+
+    assert second.orc == first.orc
+    assert edited.orc != first.orc
+    assert len(calls) == 2
+    assert (compiler.compile_cache.hits, compiler.compile_cache.misses) == (1, 2)
+
+
+def test_compile_cache_disk_tier_warms_a_fresh_cache(monkeypatch, tmp_path) -> None:
+    from backend.app.services.compile_cache import CompiledInstrumentCache
+
+    first = CompilerService(
+        OpcodeService(icon_prefix="/static/icons"),
+        compile_cache=CompiledInstrumentCache(cache_dir=tmp_path),
+    ).compile_patch(_cacheable_patch(), midi_input="0", rtmidi_module="alsaseq")
+    calls = _count_graph_compiles(monkeypatch)
+    restarted = CompilerService(
+        OpcodeService(icon_prefix="/static/icons"),
+        compile_cache=CompiledInstrumentCache(cache_dir=tmp_path),
+    )
+
+    second = restarted.compile_patch(_cacheable_patch(), midi_input="0", rtmidi_module="alsaseq")
+
+    assert second.orc == first.orc
+    assert calls == []
+    assert len(list(tmp_path.rglob("*.json"))) == 1
+
+
+def test_compile_cache_skips_graphs_that_resolve_uploaded_assets(monkeypatch) -> None:
+    calls = _count_graph_compiles(monkeypatch)
+    compiler = CompilerService(OpcodeService(icon_prefix="/static/icons"))
+    patch = _cacheable_patch()
+    patch.graph.ui_layout["gen_nodes"] = {"unused": {"sampleAsset": {"stored_name": "kick.wav"}}}
+
+    compiler.compile_patch(patch, midi_input="0", rtmidi_module="alsaseq")
+    compiler.compile_patch(patch, midi_input="0", rtmidi_module="alsaseq")
+
+    assert len(calls) == 2
+    assert len(compiler.compile_cache) == 0
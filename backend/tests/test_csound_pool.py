@@ -0,0 +1,111 @@
+from __future__ import annotations
+
+import time
+
+from backend.app.engine.csound_pool import CsoundInstancePool
+from backend.app.engine.csound_worker import CsoundWorker
+
+
+class FakeCsound:
+    def __init__(self) -> None:
+        self.options: list[str] = []
+        self.cleaned_up = False
+
+    def setOption(self, option: str) -> None:  # noqa: N802
+        self.options.append(option)
+
+    def cleanup(self) -> None:
+        self.cleaned_up = True
+
+
+class FakeCtcsound:
+    def __init__(self) -> None:
+        self.created: list[FakeCsound] = []
+
+    def Csound(self) -> FakeCsound:  # noqa: N802
+        instance = FakeCsound()
+        self.created.append(instance)
+        return instance
+
+
+def _wait_for_idle(pool: CsoundInstancePool, count: int) -> None:
+    deadline = time.monotonic() + 5.0
+    while pool.stats().idle_instances < count:
+        assert time.monotonic() < deadline, "pool did not refill"
+        time.sleep(0.005)
+
+
+def test_pool_prewarms_instances_with_session_independent_options_and_refills(tmp_path) -> None:
+    ctcsound = FakeCtcsound()
+    pool = CsoundInstancePool(size=2, gen_audio_assets_dir=str(tmp_path), ctcsound_module=ctcsound)
+    pool.start()
+    try:
+        _wait_for_idle(pool, 2)
+        instance = pool.acquire()
+
+        assert instance is ctcsound.created[0]
+        assert instance.options == ["-d", "-n", f"--env:SSDIR={tmp_path}"]
+        _wait_for_idle(pool, 2)
+        assert len(ctcsound.created) == 3
+        assert (pool.stats().warm_acquires, pool.stats().cold_acquires) == (1, 0)
+    finally:
+        pool.close()
+
+    assert all(created.cleaned_up for created in ctcsound.created[1:])
+
+
+def test_disabled_pool_hands_out_nothing_but_still_tracks_starts() -> None:
+    pool = CsoundInstancePool(size=0, ctcsound_module=FakeCtcsound())
+    pool.start()
+
+    assert pool.acquire() is None
+    for elapsed_ms in range(1, 101):
+        pool.record_start(requested_module="alsaseq", module="portmidi", elapsed_ns=elapsed_ms * 1_000_000)
+
+    stats = pool.stats()
+    assert stats.cold_acquires == 1
+    assert stats.rtmidi_modules == {"alsaseq": "portmidi"}
+    assert (stats.start_count, stats.start_latency_p50_ms, stats.start_latency_p99_ms) == (100, 50.0, 99.0)
+    assert pool.ordered_rtmidi_candidates("alsaseq", ["alsaseq", "portmidi", "virtual"]) == [
+        "portmidi",
+        "alsaseq",
+        "virtual",
+    ]
+
+
+def test_worker_start_uses_pooled_instance_and_remembered_rtmidi_module(monkeypatch) -> None:
+    monkeypatch.setattr("backend.app.engine.csound_worker.sys.platform", "linux")
+
+    class StartableCsound(FakeCsound):
+        def compileCsdText(self, _csd: str) -> int:  # noqa: N802
+            return 0 if "-+rtmidi=virtual" in self.options else 1
+
+        def start(self) -> int:
+            return 0
+
+    class StartableCtcsound(FakeCtcsound):
+        def Csound(self) -> StartableCsound:  # noqa: N802
+            instance = StartableCsound()
+            self.created.append(instance)
+            return instance
+
+    ctcsound = StartableCtcsound()
+    pool = CsoundInstancePool(size=0, ctcsound_module=ctcsound)
+    monkeypatch.setattr(CsoundWorker, "_configure_host_midi_callbacks", lambda self, csound: None)
+    csd = "<CsoundSynthesizer><CsInstruments>\nsr = 48000\nksmps = 32\nnchnls = 2\n</CsInstruments></CsoundSynthesizer>"
+
+    def start_worker() -> int:
+        worker = CsoundWorker(instance_pool=pool)
+        worker._backend = "ctcsound"
+        worker._ctcsound = ctcsound
+        before = len(ctcsound.created)
+        worker.start(csd, midi_input="0", rtmidi_module="alsaseq")
+        return len(ctcsound.created) - before
+
+    first_attempts = start_worker()
+    second_attempts = start_worker()
+
+    assert first_attempts > 1
+    assert second_attempts == 1
+    assert pool.stats().rtmidi_modules == {"alsaseq": "virtual"}
+    assert pool.stats().start_count == 2
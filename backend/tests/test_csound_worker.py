@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+import logging
 import os
 import sys
 
@@ -423,3 +424,181 @@ def test_browser_clock_ctcsound_runtime_resamples_merged_blocks_once_per_request
     assert render.target_frame_count == 139
     assert pcm.shape == (139, 2)
     assert np.isfinite(pcm).all()
+
+
+def test_browser_clock_midi_subblocks_deliver_events_within_render_block(monkeypatch, caplog) -> None:
+    monkeypatch.setenv("VISUALCSOUND_AUDIO_OUTPUT_MODE", "browser_clock")
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "true")
+
+    assert CsoundWorker._resolve_midi_subblock_ksmps(64, 0) == 64
+    assert CsoundWorker._resolve_midi_subblock_ksmps(64, 20) == 16
+    assert CsoundWorker._resolve_midi_subblock_ksmps(63, 8) == 7
+    assert CsoundWorker._resolve_midi_subblock_ksmps(61, 1) == 1
+    with caplog.at_level(logging.WARNING, logger="backend.app.engine.csound_worker"):
+        assert CsoundWorker._resolve_midi_subblock_ksmps(61, 8) == 61
+    assert "no divisor between 2 and 8" in caplog.text
+    assert CsoundWorker._rewrite_orchestra_ksmps("sr = 48000\nksmps = 64\nnchnls = 2", 16) == (
+        "sr = 48000\nksmps = 16\nnchnls = 2"
+    )
+
+    worker = CsoundWorker(midi_subblock_frames=16)
+
+    class FakeCsound:
+        def __init__(self) -> None:
+            self.midi_at_perform: list[bytes] = []
+
+        def performKsmps(self) -> int:  # noqa: N802
+            with worker._host_midi_lock:
+                self.midi_at_perform.append(bytes(worker._host_midi_buffer))
+            return 0
+
+        def spout(self) -> np.ndarray:
+            return np.zeros((16, 2), dtype=np.float32)
+
+    worker._backend = "ctcsound"
+    worker._audio_output_mode = "browser_clock"
+    worker._csound = FakeCsound()
+    worker._running = True
+    worker._host_midi_enabled = True
+    worker._runtime_sr = 48_000
+    worker._runtime_nchnls = 2
+    worker._runtime_ksmps = 64
+    worker._engine_ksmps = 16
+    worker._midi_scheduler.set_engine_sample_rate(48_000)
+
+    assert worker.enqueue_timestamped_midi([0x90, 60, 100], source="test", target_engine_sample=40) is True
+
+    render = worker.render_blocks(block_count=1, target_sample_rate=48_000)
+
+    assert worker._csound.midi_at_perform == [b"", b"", bytes([0x90, 60, 100]), b""]
+    assert render.engine_sample_end == 64
+    assert render.target_frame_count == 64
+
+    metrics = worker.render_metrics
+    assert metrics.perform_ksmps.snapshot().count == 4
+    assert metrics.midi_events_per_block.snapshot().counts[:3] == (0, 1, 0)
+    assert metrics.encode.snapshot().count == 1
+
+
+def test_midi_trace_records_drain_and_block_completion_for_rendered_events(monkeypatch) -> None:
+    monkeypatch.setenv("VISUALCSOUND_AUDIO_OUTPUT_MODE", "browser_clock")
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "true")
+
+    class FakeCsound:
+        def performKsmps(self) -> int:  # noqa: N802
+            return 0
+
+        def spout(self) -> np.ndarray:
+            return np.zeros((32, 2), dtype=np.float32)
+
+    worker = CsoundWorker(midi_trace_capacity=32)
+    worker._backend = "ctcsound"
+    worker._audio_output_mode = "browser_clock"
+    worker._csound = FakeCsound()
+    worker._running = True
+    worker._host_midi_enabled = True
+    worker._runtime_sr = 48_000
+    worker._runtime_nchnls = 2
+    worker._runtime_ksmps = 32
+    worker._engine_ksmps = 32
+
+    assert worker.enqueue_timestamped_midi(
+        [0x90, 60, 100],
+        source="test",
+        target_engine_sample=40,
+        received_ns=1,
+    ) is True
+    worker.render_blocks(block_count=2, target_sample_rate=48_000)
+
+    assert worker.midi_trace is not None
+    trace_events = worker.midi_trace.export_chrome_trace(session_id="s1")["traceEvents"]
+    span = next(event for event in trace_events if event["ph"] == "b" and event["name"] == "midi 903c64")
+    assert span["args"]["block_start_sample"] == 32
+    stages = [event["name"] for event in trace_events if event["ph"] == "e" and event["id"] == span["id"]]
+    assert stages == ["receipt_to_enqueue", "queued", "render", "midi 903c64"]
+    blocks = [event["args"] for event in trace_events if event["ph"] == "X"]
+    assert blocks == [
+        {"engine_sample_start": 0, "engine_sample_end": 32},
+        {"engine_sample_start": 32, "engine_sample_end": 64},
+    ]
+
+
+def test_hot_swap_orchestra_compiles_into_running_engine_without_resetting_cursor(monkeypatch) -> None:
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "true")
+
+    class FakeCsound:
+        def __init__(self) -> None:
+            self.orchestras: list[str] = []
+            self.messages: list[str] = []
+
+        def compileOrc(self, orc: str) -> int:  # noqa: N802
+            self.orchestras.append(orc)
+            return 1 if "broken" in orc else 0
+
+        def inputMessage(self, message: str) -> None:  # noqa: N802
+            self.messages.append(message)
+
+    worker = CsoundWorker()
+    worker._backend = "ctcsound"
+    worker._csound = FakeCsound()
+    worker._running = True
+    worker._render_sample_cursor = 4096
+
+    detail = worker.hot_swap_orchestra("instr 1\nendin", score_lines=('i "vcs_hot_swap" 0 1',))
+
+    assert detail == "instruments hot-swapped"
+    assert worker._csound.orchestras == ["instr 1\nendin"]
+    assert worker._csound.messages == ['i "vcs_hot_swap" 0 1']
+    assert worker.render_sample_cursor == 4096
+    with pytest.raises(RuntimeError, match="hot-swap failed"):
+        worker.hot_swap_orchestra("broken")
+    assert worker._csound.messages == ['i "vcs_hot_swap" 0 1']
+
+
+def test_render_budget_degradations_scale_ksmps_and_limit_voices(monkeypatch) -> None:
+    monkeypatch.setenv("VISUALCSOUND_AUDIO_OUTPUT_MODE", "browser_clock")
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "true")
+
+    worker = CsoundWorker()
+    csd = "\n".join(
+        [
+            "<CsoundSynthesizer>",
+            "<CsInstruments>",
+            "sr = 48000",
+            "ksmps = 64",
+            "nchnls = 2",
+            "instr 1",
+            "endin",
+            "</CsInstruments>",
+            "</CsoundSynthesizer>",
+        ]
+    )
+    assert [worker.scale_ksmps_on_restart() for _ in range(3)] == [2, 4, 4]
+    worker.start(csd=csd, midi_input="unused", rtmidi_module="null")
+    render = worker.render_blocks(block_count=1, target_sample_rate=48_000)
+    assert render.engine_sample_end - render.engine_sample_start == 256
+    worker.stop()
+
+    subblock_worker = CsoundWorker(midi_subblock_frames=16)
+    runtime_csd, block_ksmps = subblock_worker._apply_runtime_ksmps(csd)
+    assert ("ksmps = 16\n" in runtime_csd, block_ksmps) == (True, 64)
+    subblock_worker.scale_ksmps_on_restart()
+    runtime_csd, block_ksmps = subblock_worker._apply_runtime_ksmps(csd)
+    assert ("ksmps = 32\n" in runtime_csd, block_ksmps) == (True, 128)
+
+    class FakeCsound:
+        def __init__(self) -> None:
+            self.orchestras: list[str] = []
+
+        def compileOrc(self, orc: str) -> int:  # noqa: N802
+            self.orchestras.append(orc)
+            return 0
+
+    worker._backend = "ctcsound"
+    worker._csound = FakeCsound()
+    worker._running = True
+
+    detail = worker.limit_instrument_voices(["2", "vcs_voice", "2"], 8)
+
+    assert detail == "instruments limited to 8 voices"
+    assert worker._csound.orchestras == ['maxalloc 2, 8\nmaxalloc "vcs_voice", 8']
@@ -0,0 +1,145 @@
+from __future__ import annotations
+
+import asyncio
+import json
+
+import pytest
+
+from backend.app.models.session import SessionEvent
+from backend.app.services.event_bus import SessionEventBus, SessionEventSubscriptionLimitExceededError
+
+
+def _bus(*, ring_capacity: int = 8) -> SessionEventBus:
+    return SessionEventBus(max_subscriptions_total=4, max_subscriptions_per_session=2, ring_capacity=ring_capacity)
+
+
+def test_publish_serializes_each_event_once_for_all_subscribers() -> None:
+    async def scenario() -> None:
+        bus = _bus()
+        first = await bus.subscribe("s1")
+        second = await bus.subscribe("s1")
+        other = await bus.subscribe("s2")
+
+        await bus.publish(SessionEvent(session_id="s1", type="midi_event", payload={"note": 60}))
+
+        first_text = await first.next_serialized()
+        second_text = await second.next_serialized()
+        assert first_text is second_text
+        assert json.loads(first_text)["payload"] == {"note": 60}
+        assert other.next_serialized_nowait() is None
+
+    asyncio.run(scenario())
+
+
+def test_slow_subscriber_skips_to_the_oldest_retained_event_and_counts_the_lag() -> None:
+    async def scenario() -> None:
+        bus = _bus(ring_capacity=4)
+        slow = await bus.subscribe("s1")
+        for index in range(10):
+            await bus.publish(SessionEvent(session_id="s1", type="step", payload={"index": index}))
+
+        assert slow.pending_count == 4
+        notice = json.loads(await slow.next_serialized())
+        assert notice["type"] == "events_dropped"
+        assert notice["payload"] == {"first_seq": 0, "next_seq": 6, "count": 6}
+        received = [json.loads(await slow.next_serialized()) for _ in range(4)]
+        assert [event["payload"]["index"] for event in received] == [6, 7, 8, 9]
+        assert [event["seq"] for event in received] == [6, 7, 8, 9]
+        assert slow.lagged_events == 6
+        assert (await bus.stats()).lagged_events_total == 6
+
+    asyncio.run(scenario())
+
+
+def _step_event(transport_time_ms: float, *, running: bool = True) -> SessionEvent:
+    return SessionEvent(
+        session_id="s1",
+        type="sequencer_step",
+        payload={"running": running, "transport_time_ms": transport_time_ms},
+    )
+
+
+def test_step_snapshots_coalesce_per_subscriber_display_frame() -> None:
+    async def scenario() -> None:
+        bus = _bus(ring_capacity=32)
+        coalescing = await bus.subscribe("s1", sequencer_frame_ms=16.0)
+        raw = await bus.subscribe("s1")
+
+        for time_ms in (0.0, 5.0, 10.0, 15.0, 20.0, 25.0):
+            await bus.publish(_step_event(time_ms))
+        await bus.publish(SessionEvent(session_id="s1", type="sequencer_pad_switched", payload={"running": True}))
+        await bus.publish(_step_event(30.0))
+        await bus.publish(_step_event(2.0))
+        await bus.publish(_step_event(4.0, running=False))
+
+        received: list[dict] = []
+        while (text := coalescing.next_serialized_nowait()) is not None:
+            received.append(json.loads(text))
+        assert [(event["type"], event["payload"].get("transport_time_ms")) for event in received] == [
+            ("sequencer_step", 0.0),
+            ("sequencer_step", 20.0),
+            ("sequencer_step", 25.0),
+            ("sequencer_pad_switched", None),
+            ("sequencer_step", 2.0),
+            ("sequencer_step", 4.0),
+        ]
+        assert [event["seq"] for event in received] == [0, 4, 5, 6, 8, 9]
+        assert coalescing.coalesced_events == 4
+
+        assert raw.pending_count == 10
+        assert (await bus.stats()).coalesced_events_total == 4
+
+    asyncio.run(scenario())
+
+
+def test_held_step_snapshot_is_flushed_after_one_frame_without_newer_events() -> None:
+    async def scenario() -> None:
+        bus = _bus()
+        coalescing = await bus.subscribe("s1", sequencer_frame_ms=20.0)
+        for time_ms in (0.0, 5.0, 10.0):
+            await bus.publish(_step_event(time_ms))
+
+        assert json.loads(await coalescing.next_serialized())["payload"]["transport_time_ms"] == 0.0
+        assert coalescing.next_serialized_nowait() is None
+        trailing = json.loads(await asyncio.wait_for(coalescing.next_serialized(), timeout=1.0))
+        assert trailing["payload"]["transport_time_ms"] == 10.0
+        assert trailing["seq"] == 2
+        assert coalescing.coalesced_events == 1
+
+    asyncio.run(scenario())
+
+
+def test_cancelling_one_waiter_does_not_cancel_the_shared_wakeup() -> None:
+    async def scenario() -> None:
+        bus = _bus()
+        cancelled = await bus.subscribe("s1")
+        waiting = await bus.subscribe("s1")
+        cancelled_task = asyncio.create_task(cancelled.next_serialized())
+        waiting_task = asyncio.create_task(waiting.next_serialized())
+        await asyncio.sleep(0)
+
+        cancelled_task.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await cancelled_task
+        await bus.publish(SessionEvent(session_id="s1", type="transport"))
+
+        assert json.loads(await asyncio.wait_for(waiting_task, timeout=1.0))["type"] == "transport"
+
+    asyncio.run(scenario())
+
+
+def test_subscription_limits_and_release() -> None:
+    async def scenario() -> None:
+        bus = _bus()
+        first = await bus.subscribe("s1")
+        await bus.subscribe("s1")
+        with pytest.raises(SessionEventSubscriptionLimitExceededError):
+            await bus.subscribe("s1")
+
+        await bus.unsubscribe("s1", first)
+        await bus.unsubscribe("s1", first)
+        stats = await bus.stats()
+        assert stats.subscription_count == 1
+        assert stats.subscriptions_by_session == {"s1": 1}
+
+    asyncio.run(scenario())
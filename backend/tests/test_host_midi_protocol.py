@@ -0,0 +1,66 @@
+from __future__ import annotations
+
+import pytest
+
+from backend.app.services.host_midi_protocol import (
+    HOST_MIDI_EVENT_RECORD_SIZE,
+    HOST_MIDI_NO_TIMESTAMP,
+    HostMidiProtocolError,
+    decode_host_midi_frame,
+    encode_host_midi_frame,
+    negotiate_host_midi_protocol_version,
+)
+
+
+def test_binary_frames_intern_device_ids_across_frames() -> None:
+    sender_table: dict[str, int] = {}
+    receiver_table: list[str] = []
+
+    first = encode_host_midi_frame(
+        [("host:a", 10, [0x90, 60, 100]), ("host:b", None, [0xB0, 1, 64]), ("host:a", 12, [0x80, 60, 0])],
+        sender_table,
+    )
+    decoded = decode_host_midi_frame(first, receiver_table)
+    assert receiver_table == ["host:a", "host:b"]
+    assert decoded.record_count == 3
+    assert list(decoded.records()) == [
+        (0, 10, 0x90, 60, 100),
+        (1, HOST_MIDI_NO_TIMESTAMP, 0xB0, 1, 64),
+        (0, 12, 0x80, 60, 0),
+    ]
+
+    second = encode_host_midi_frame([("host:b", 20, [0x90, 62, 90])], sender_table)
+    assert len(second) == 8 + HOST_MIDI_EVENT_RECORD_SIZE
+    assert list(decode_host_midi_frame(second, receiver_table).records()) == [(1, 20, 0x90, 62, 90)]
+    assert receiver_table == ["host:a", "host:b"]
+
+
+@pytest.mark.parametrize(
+    ("mutate", "message"),
+    [
+        (lambda frame: b"XX" + frame[2:], "magic"),
+        (lambda frame: frame[:2] + b"\x07" + frame[3:], "version"),
+        (lambda frame: frame[:-1], "record bytes"),
+        (lambda frame: frame[:10], "device"),
+    ],
+)
+def test_malformed_frames_are_rejected_without_touching_the_device_table(mutate, message: str) -> None:
+    frame = encode_host_midi_frame([("host:a", 1, [0x90, 60, 100])], {})
+    receiver_table = ["existing"]
+
+    with pytest.raises(HostMidiProtocolError, match=message):
+        decode_host_midi_frame(mutate(frame), receiver_table)
+    assert receiver_table == ["existing"]
+
+
+def test_device_definitions_must_extend_the_table_in_order() -> None:
+    frame = encode_host_midi_frame([("host:a", 1, [0x90, 60, 100])], {"skipped": 0, "other": 1})
+
+    with pytest.raises(HostMidiProtocolError, match="skips ahead"):
+        decode_host_midi_frame(frame, [])
+
+
+def test_protocol_version_negotiation_clamps_to_supported_range() -> None:
+    assert negotiate_host_midi_protocol_version(1) == 1
+    assert negotiate_host_midi_protocol_version(2) == 2
+    assert negotiate_host_midi_protocol_version(9) == 2
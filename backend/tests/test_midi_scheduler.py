@@ -1,6 +1,6 @@
 from __future__ import annotations
 
-from backend.app.engine.midi_scheduler import ClockDomainMapping, EngineMidiScheduler
+from backend.app.engine.midi_scheduler import ClockDomainMapping, EngineMidiScheduler, ScheduledMidiInput
 
 
 def test_engine_midi_scheduler_drains_events_in_block_order() -> None:
@@ -19,6 +19,32 @@ def test_engine_midi_scheduler_drains_events_in_block_order() -> None:
     ]
 
 
+def test_engine_midi_scheduler_enqueues_batches_as_an_accepted_prefix() -> None:
+    scheduler = EngineMidiScheduler(max_events=3)
+    assert scheduler.enqueue([0x90, 10, 1], source="test", target_engine_sample=500)[0] is True
+
+    accepted = scheduler.enqueue_many(
+        [
+            ScheduledMidiInput((0x90, 60, 100), 64, 1_000, False),
+            ScheduledMidiInput((0xB0, 1, 64), 200),
+            ScheduledMidiInput((0x80, 60, 0), 300),
+        ],
+        source="host",
+        current_engine_sample=128,
+    )
+
+    assert accepted == 2
+    assert scheduler.overflow_count == 1
+    drained = scheduler.drain_block(block_start_sample=128, block_end_sample=512)
+    assert [(list(event.message), event.target_engine_sample, event.late) for event in drained] == [
+        ([0x90, 60, 100], 128, True),
+        ([0xB0, 1, 64], 200, False),
+        ([0x90, 10, 1], 500, False),
+    ]
+    assert drained[0].mapped_backend_monotonic_ns == 1_000
+    assert drained[0].source == "host"
+
+
 def test_engine_midi_scheduler_marks_late_events_when_block_has_advanced() -> None:
     scheduler = EngineMidiScheduler()
 
@@ -50,3 +76,51 @@ def test_clock_domain_mapping_detects_stale_sync_samples() -> None:
     mapped, stale = mapping.map_to_server_time(1_500, now_server_ns=2_000_000_500)
     assert mapped == 2_500
     assert stale is True
+
+
+def _sync_pairs(*, count: int, offset_ns: int, skew_ppm: float, delays_ns: list[int], period_ns: int = 100_000_000):
+    for index in range(count):
+        remote_ns = 5_000_000_000 + index * period_ns
+        true_server_ns = remote_ns + offset_ns + int(remote_ns * skew_ppm * 1e-6)
+        yield remote_ns, true_server_ns + delays_ns[index % len(delays_ns)]
+
+
+def test_clock_domain_mapping_tracks_skew_between_syncs() -> None:
+    mapping = ClockDomainMapping()
+    delays_ns = [300_000, 1_200_000, 150_000, 900_000, 2_000_000, 400_000]
+    for remote_ns, server_ns in _sync_pairs(count=60, offset_ns=7_000_000, skew_ppm=80.0, delays_ns=delays_ns):
+        assert mapping.update(remote_timestamp_ns=remote_ns, server_timestamp_ns=server_ns) is True
+
+    estimate = mapping.estimate()
+    assert estimate is not None
+    assert abs(estimate.skew_ppm - 80.0) < 5.0
+    assert estimate.sample_count == 60
+
+    future_remote_ns = remote_ns + 10_000_000_000
+    expected_server_ns = future_remote_ns + 7_000_000 + int(future_remote_ns * 80e-6)
+    mapped, _stale = mapping.map_to_server_time(future_remote_ns, now_server_ns=server_ns)
+    # Within the minimum one-way delay, where an offset-only mapping would be ~800us off after 10s of drift.
+    assert mapped is not None and abs(mapped - expected_server_ns) < 200_000
+
+
+def test_clock_domain_mapping_rejects_delayed_samples_and_recovers_from_clock_steps() -> None:
+    mapping = ClockDomainMapping()
+    pairs = list(_sync_pairs(count=20, offset_ns=1_000_000, skew_ppm=0.0, delays_ns=[100_000, 200_000]))
+    for remote_ns, server_ns in pairs:
+        mapping.update(remote_timestamp_ns=remote_ns, server_timestamp_ns=server_ns)
+    offset_before = mapping.estimate().offset_ns
+
+    last_remote_ns = pairs[-1][0]
+    assert mapping.update(
+        remote_timestamp_ns=last_remote_ns + 100_000_000,
+        server_timestamp_ns=last_remote_ns + 100_000_000 + 1_000_000 + 50_000_000,
+    ) is False
+    assert mapping.estimate().offset_ns == offset_before
+    assert mapping.estimate().rejected_count == 1
+
+    stepped_offset_ns = 1_000_000 + 40_000_000
+    for index in range(2, 10):
+        remote_ns = last_remote_ns + index * 100_000_000
+        mapping.update(remote_timestamp_ns=remote_ns, server_timestamp_ns=remote_ns + stepped_offset_ns)
+
+    assert abs(mapping.estimate().offset_ns - stepped_offset_ns) < 1_000
@@ -0,0 +1,76 @@
+from __future__ import annotations
+
+from backend.app.engine.midi_scheduler import EngineMidiScheduler, ScheduledMidiInput
+from backend.app.engine.midi_trace import MidiTraceBuffer
+
+
+def _stage_spans(trace: dict, span_id: str) -> dict[str, tuple[float, float]]:
+    begins: dict[str, float] = {}
+    spans: dict[str, tuple[float, float]] = {}
+    for event in trace["traceEvents"]:
+        if event.get("id") != span_id:
+            continue
+        if event["ph"] == "b":
+            begins[event["name"]] = event["ts"]
+        elif event["ph"] == "e":
+            spans[event["name"]] = (begins[event["name"]], event["ts"])
+    return spans
+
+
+def test_trace_stitches_every_stage_of_an_event_into_one_async_span() -> None:
+    trace = MidiTraceBuffer(16)
+    scheduler = EngineMidiScheduler(trace=trace)
+    accepted = scheduler.enqueue_many(
+        [ScheduledMidiInput((0x90, 60, 100), 80, 1_000, False, 3_000)],
+        source="host_bridge:h1",
+        current_engine_sample=0,
+    )
+    assert accepted == 1
+
+    drained = scheduler.drain_block(block_start_sample=64, block_end_sample=128)
+    assert len(drained) == 1
+    trace.record_block(engine_sample_start=64, engine_sample_end=128, started_ns=0, finished_ns=10**18)
+    trace.record_chunk_sent(engine_sample_start=0, engine_sample_end=256, sent_ns=2 * 10**18)
+
+    exported = trace.export_chrome_trace(session_id="s1")
+    span = next(event for event in exported["traceEvents"] if event["ph"] == "b" and event["name"] == "midi 903c64")
+    assert span["args"]["source"] == "host_bridge:h1"
+    assert span["args"]["block_start_sample"] == 64
+    assert span["args"]["engine_sample_start"] == 0
+
+    stages = _stage_spans(exported, span["id"])
+    assert list(stages) == ["source_to_receipt", "receipt_to_enqueue", "queued", "render", "delivery", "midi 903c64"]
+    assert stages["source_to_receipt"] == (1.0, 3.0)
+    assert stages["midi 903c64"] == (1.0, 2 * 10**15)
+    assert stages["render"][1] == stages["delivery"][0] == 10**15
+
+    blocks = [event for event in exported["traceEvents"] if event["ph"] == "X"]
+    assert [event["args"] for event in blocks] == [{"engine_sample_start": 64, "engine_sample_end": 128}]
+    chunks = [event for event in exported["traceEvents"] if event["ph"] == "i"]
+    assert [event["args"]["engine_sample_end"] for event in chunks] == [256]
+
+
+def test_trace_keeps_only_stages_the_event_has_reached() -> None:
+    trace = MidiTraceBuffer(16)
+    scheduler = EngineMidiScheduler(trace=trace)
+    scheduler.enqueue([0x80, 60, 0], source="test", target_engine_sample=4_096)
+
+    exported = trace.export_chrome_trace(session_id="s1")
+    span = next(event for event in exported["traceEvents"] if event["ph"] == "b" and event["name"] == "midi 803c00")
+
+    assert list(_stage_spans(exported, span["id"])) == ["midi 803c00"]
+    assert "block_start_sample" not in span["args"]
+
+
+def test_trace_is_bounded_and_cleared_when_the_scheduler_resets() -> None:
+    trace = MidiTraceBuffer(2)
+    scheduler = EngineMidiScheduler(trace=trace)
+    for note in (60, 61, 62):
+        scheduler.enqueue([0x90, note, 100], source="test", target_engine_sample=0)
+
+    exported = trace.export_chrome_trace(session_id="s1")
+    names = [event["name"] for event in exported["traceEvents"] if event["ph"] == "b"]
+    assert names == ["midi 903d64", "midi 903e64"]
+
+    scheduler.reset()
+    assert [event for event in trace.export_chrome_trace(session_id="s1")["traceEvents"] if event["ph"] != "M"] == []
@@ -0,0 +1,228 @@
+from __future__ import annotations
+
+from pathlib import Path
+import threading
+
+import numpy as np
+import pytest
+
+from backend.app.engine.offline_render import (
+    OfflineCsoundRenderer,
+    OfflineRenderError,
+    OfflineRenderJob,
+    OfflineRenderTimeoutError,
+    OfflineRenderUnavailableError,
+    float_wav_header,
+    mix_float_wav_files,
+    read_float_wav_info,
+)
+
+
+def _write_float_wav(path: Path, frames: np.ndarray, *, sample_rate: int = 48_000) -> None:
+    frames = np.ascontiguousarray(frames, dtype="<f4")
+    channels = 1 if frames.ndim == 1 else int(frames.shape[1])
+    frame_count = int(frames.shape[0])
+    path.write_bytes(float_wav_header(sample_rate=sample_rate, channels=channels, frame_count=frame_count) + frames.tobytes())
+
+
+def _read_float_wav(path: Path) -> np.ndarray:
+    info = read_float_wav_info(path)
+    data = path.read_bytes()[info.data_offset : info.data_offset + info.frame_count * info.channels * 4]
+    return np.frombuffer(data, dtype="<f4").reshape(info.frame_count, info.channels)
+
+
+class FakeCsound:
+    def __init__(self, registry: "FakeCtcsound") -> None:
+        self._registry = registry
+        self.options: list[str] = []
+        self.csd = ""
+        self.torn_down = False
+        self.stopped = threading.Event()
+
+    def setOption(self, option: str) -> None:  # noqa: N802
+        self.options.append(option)
+
+    def compileCsdText(self, csd: str) -> int:  # noqa: N802
+        self.csd = csd
+        return 1 if "fail-compile" in csd else 0
+
+    def start(self) -> int:
+        return 0
+
+    def perform(self) -> int:
+        self._registry.enter()
+        try:
+            output = next(option[2:] for option in self.options if option.startswith("-o"))
+            level = float(self.csd.split("level=", 1)[1].split()[0]) if "level=" in self.csd else 0.25
+            _write_float_wav(Path(output), np.full((8, 2), level, dtype=np.float32))
+            if "hang" in self.csd:
+                self.stopped.wait(timeout=5)
+        finally:
+            self._registry.leave()
+        return 1
+
+    def stop(self) -> None:
+        self.stopped.set()
+
+    def cleanup(self) -> None:
+        self.torn_down = True
+
+    def reset(self) -> None:
+        return None
+
+
+class FakeCtcsound:
+    def __init__(self, *, barrier: threading.Barrier | None = None) -> None:
+        self.instances: list[FakeCsound] = []
+        self._barrier = barrier
+        self._lock = threading.Lock()
+        self._active = 0
+        self.max_active = 0
+
+    def enter(self) -> None:
+        with self._lock:
+            self._active += 1
+            self.max_active = max(self.max_active, self._active)
+        if self._barrier is not None:
+            self._barrier.wait(timeout=5)
+
+    def leave(self) -> None:
+        with self._lock:
+            self._active -= 1
+
+    def Csound(self) -> FakeCsound:  # noqa: N802
+        instance = FakeCsound(self)
+        with self._lock:
+            self.instances.append(instance)
+        return instance
+
+
+def test_float_wav_header_round_trips_through_reader(tmp_path: Path) -> None:
+    path = tmp_path / "tone.wav"
+    _write_float_wav(path, np.arange(12, dtype=np.float32).reshape(6, 2), sample_rate=44_100)
+
+    info = read_float_wav_info(path)
+
+    assert (info.sample_rate, info.channels, info.frame_count, info.data_offset) == (44_100, 2, 6, 44)
+    assert _read_float_wav(path)[5].tolist() == [10.0, 11.0]
+
+
+def test_read_float_wav_info_rejects_integer_pcm(tmp_path: Path) -> None:
+    path = tmp_path / "int16.wav"
+    header = bytearray(float_wav_header(sample_rate=48_000, channels=2, frame_count=0))
+    header[20:22] = (1).to_bytes(2, "little")
+    path.write_bytes(bytes(header))
+
+    with pytest.raises(OfflineRenderError, match="32-bit float"):
+        read_float_wav_info(path)
+
+
+def test_mix_float_wav_files_sums_stems_pads_short_stems_and_upmixes_mono(tmp_path: Path) -> None:
+    stereo = tmp_path / "stereo.wav"
+    mono = tmp_path / "mono.wav"
+    _write_float_wav(stereo, np.array([[0.5, -0.5], [0.25, -0.25], [0.125, -0.125]], dtype=np.float32))
+    _write_float_wav(mono, np.array([0.25, 0.5], dtype=np.float32))
+
+    info = mix_float_wav_files([stereo, mono], tmp_path / "mix.wav")
+
+    assert (info.channels, info.frame_count) == (2, 3)
+    assert _read_float_wav(tmp_path / "mix.wav").tolist() == [[0.75, -0.25], [0.75, 0.25], [0.125, -0.125]]
+
+
+def test_mix_float_wav_files_rejects_mismatched_sample_rates(tmp_path: Path) -> None:
+    _write_float_wav(tmp_path / "a.wav", np.zeros((2, 2), dtype=np.float32), sample_rate=48_000)
+    _write_float_wav(tmp_path / "b.wav", np.zeros((2, 2), dtype=np.float32), sample_rate=44_100)
+
+    with pytest.raises(OfflineRenderError, match="different sample rates"):
+        mix_float_wav_files([tmp_path / "a.wav", tmp_path / "b.wav"], tmp_path / "mix.wav")
+
+
+def test_renderer_writes_file_output_and_midi_file_options(tmp_path: Path) -> None:
+    ctcsound = FakeCtcsound()
+    renderer = OfflineCsoundRenderer(max_workers=1, ctcsound_module=ctcsound)
+    csd = "<CsoundSynthesizer>\n<CsOptions>\n-d -W -f -o song.wav -F song.mid\n</CsOptions>\n<CsInstruments>\n</CsInstruments>\n</CsoundSynthesizer>"
+
+    paths = renderer.render([OfflineRenderJob(name="song", csd=csd, midi_bytes=b"MThd")], work_dir=tmp_path)
+
+    instance = ctcsound.instances[0]
+    assert paths == [tmp_path / "song.wav"]
+    assert "-n" not in instance.options
+    assert f"-o{tmp_path / 'song.wav'}" in instance.options
+    assert f"-F{tmp_path / 'song.mid'}" in instance.options
+    assert f"--env:SSDIR={tmp_path}" in instance.options
+    assert "<CsOptions>" not in instance.csd
+    assert (tmp_path / "song.mid").read_bytes() == b"MThd"
+    assert instance.torn_down
+
+
+def test_renderer_runs_independent_jobs_in_parallel_and_stages_assets(tmp_path: Path) -> None:
+    ctcsound = FakeCtcsound(barrier=threading.Barrier(3))
+    renderer = OfflineCsoundRenderer(max_workers=4, ctcsound_module=ctcsound)
+    source = tmp_path / "store" / "kick.wav"
+    source.parent.mkdir()
+    source.write_bytes(b"RIFFkick")
+
+    jobs = [OfflineRenderJob(name=f"stem{index}", csd=f"level={index / 10}") for index in range(3)]
+    paths = renderer.render(jobs, work_dir=tmp_path / "work", assets=[(source, "assets/kick.wav")])
+
+    assert ctcsound.max_active == 3
+    assert [path.name for path in paths] == ["stem0.wav", "stem1.wav", "stem2.wav"]
+    assert (tmp_path / "work" / "assets" / "kick.wav").read_bytes() == b"RIFFkick"
+    assert _read_float_wav(paths[2])[0].tolist() == pytest.approx([0.2, 0.2])
+
+
+def test_renderer_reports_compile_failures(tmp_path: Path) -> None:
+    renderer = OfflineCsoundRenderer(ctcsound_module=FakeCtcsound())
+
+    with pytest.raises(OfflineRenderError, match="failed to compile"):
+        renderer.render([OfflineRenderJob(name="broken", csd="fail-compile")], work_dir=tmp_path)
+
+
+def test_renderer_is_unavailable_with_forced_mock_engine(monkeypatch, tmp_path: Path) -> None:
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "1")
+
+    with pytest.raises(OfflineRenderUnavailableError):
+        OfflineCsoundRenderer().render([OfflineRenderJob(name="song", csd="")], work_dir=tmp_path)
+
+
+def test_renderer_pool_bounds_instances_across_concurrent_calls(tmp_path: Path) -> None:
+    ctcsound = FakeCtcsound()
+    renderer = OfflineCsoundRenderer(max_workers=2, ctcsound_module=ctcsound)
+    errors: list[BaseException] = []
+
+    def export(index: int) -> None:
+        jobs = [OfflineRenderJob(name=f"stem{job}", csd="level=0.1") for job in range(2)]
+        try:
+            renderer.render(jobs, work_dir=tmp_path / f"export{index}")
+        except BaseException as exc:
+            errors.append(exc)
+
+    threads = [threading.Thread(target=export, args=(index,)) for index in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join(timeout=5)
+    renderer.close()
+
+    assert errors == []
+    assert len(ctcsound.instances) == 8
+    assert ctcsound.max_active <= 2
+
+
+def test_renderer_stops_jobs_over_wall_time_budget_and_removes_outputs(tmp_path: Path) -> None:
+    ctcsound = FakeCtcsound()
+    renderer = OfflineCsoundRenderer(max_workers=1, max_render_seconds=0.2, ctcsound_module=ctcsound)
+    jobs = [
+        OfflineRenderJob(name="slow", csd="hang", midi_bytes=b"MThd"),
+        OfflineRenderJob(name="queued", csd="level=0.1"),
+    ]
+
+    with pytest.raises(OfflineRenderTimeoutError, match="wall-time budget"):
+        renderer.render(jobs, work_dir=tmp_path)
+    renderer.close()
+
+    assert len(ctcsound.instances) == 1
+    assert ctcsound.instances[0].stopped.is_set()
+    assert ctcsound.instances[0].torn_down
+    assert not (tmp_path / "slow.wav").exists()
+    assert not (tmp_path / "slow.mid").exists()
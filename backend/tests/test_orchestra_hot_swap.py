@@ -0,0 +1,98 @@
+from __future__ import annotations
+
+import pytest
+
+from backend.app.models.patch import Connection, NodeInstance, PatchDocument, PatchGraph
+from backend.app.services.compiler_common import PatchInstrumentTarget
+from backend.app.services.compiler_service import CompilerService
+from backend.app.services.opcode_service import OpcodeService
+from backend.app.services.orchestra_hot_swap import (
+    OrchestraHotSwapError,
+    plan_orchestra_hot_swap,
+    split_orchestra,
+)
+
+
+def _patch(patch_id: str, value: float, *, always_on: bool = False, ksmps: int = 32) -> PatchDocument:
+    return PatchDocument(
+        id=patch_id,
+        name=patch_id,
+        always_on=always_on,
+        graph=PatchGraph(
+            nodes=[
+                NodeInstance(id="sig", opcode="const_a", params={"value": value}),
+                NodeInstance(id="out", opcode="outs"),
+            ],
+            connections=[
+                Connection(from_node_id="sig", from_port_id="aout", to_node_id="out", to_port_id="left"),
+                Connection(from_node_id="sig", from_port_id="aout", to_node_id="out", to_port_id="right"),
+            ],
+            engine_config={"ksmps": ksmps},
+        ),
+    )
+
+
+def _orc(*patches: PatchDocument) -> str:
+    compiler = CompilerService(OpcodeService(icon_prefix="/static/icons"))
+    targets = [
+        PatchInstrumentTarget(patch=patch, midi_channel=0 if patch.always_on else index, always_on=patch.always_on)
+        for index, patch in enumerate(patches, start=1)
+    ]
+    return compiler.compile_patch_bundle(targets, midi_input="0", rtmidi_module="alsaseq").orc
+
+
+def test_split_orchestra_separates_header_from_instrument_blocks() -> None:
+    layout = split_orchestra(_orc(_patch("lead", 0.1), _patch("pad", 0.2, always_on=True)))
+
+    assert list(layout.instruments) == ["vcs_instr_1", "vcs_instr_2"]
+    assert layout.always_on_refs == frozenset({"vcs_instr_2"})
+    assert all(not line.startswith(";") for line in layout.header_lines)
+    assert layout.instruments["vcs_instr_1"].startswith("instr vcs_instr_1\n")
+    assert layout.instruments["vcs_instr_1"].endswith("\nendin")
+
+
+def test_plan_recompiles_only_changed_midi_instruments() -> None:
+    previous = _orc(_patch("lead", 0.1), _patch("bass", 0.2))
+    upcoming = _orc(_patch("lead", 0.1), _patch("bass", 0.3))
+
+    plan = plan_orchestra_hot_swap(previous, upcoming)
+
+    assert plan.changed_instruments == ("2",)
+    assert plan.orc.startswith("instr 2\n")
+    assert "instr 1\n" not in plan.orc
+    assert plan.score_lines == ()
+
+
+def test_plan_cut_policy_releases_active_voices_of_changed_instruments() -> None:
+    plan = plan_orchestra_hot_swap(
+        _orc(_patch("lead", 0.1)),
+        _orc(_patch("lead", 0.5)),
+        voice_policy="cut",
+    )
+
+    assert "turnoff2 1, 0, 1" in plan.orc
+    assert plan.score_lines == ('i "vcs_hot_swap" 0 1',)
+
+
+def test_plan_restarts_changed_always_on_instruments_with_overlapping_release() -> None:
+    plan = plan_orchestra_hot_swap(
+        _orc(_patch("lead", 0.1), _patch("fx", 0.2, always_on=True)),
+        _orc(_patch("lead", 0.1), _patch("fx", 0.4, always_on=True)),
+    )
+
+    assert plan.changed_instruments == ("vcs_instr_2",)
+    assert 'turnoff2 "vcs_instr_2", 8, 1' in plan.orc
+    assert 'event "i", "vcs_instr_2", 0, -1' in plan.orc
+    assert plan.score_lines == ('i "vcs_hot_swap" 0 1',)
+
+
+def test_plan_is_empty_for_renames_and_rejects_header_changes() -> None:
+    previous = _orc(_patch("lead", 0.1))
+    renamed = _patch("lead", 0.1)
+    renamed.name = "Lead (renamed)"
+
+    assert plan_orchestra_hot_swap(previous, _orc(renamed)).is_empty
+    with pytest.raises(OrchestraHotSwapError):
+        plan_orchestra_hot_swap(previous, _orc(_patch("lead", 0.1, ksmps=64)))
+    with pytest.raises(OrchestraHotSwapError):
+        plan_orchestra_hot_swap(previous, _orc(_patch("lead", 0.1), _patch("bass", 0.2)))
@@ -0,0 +1,96 @@
+from __future__ import annotations
+
+import asyncio
+import threading
+
+import numpy as np
+
+from backend.app.engine.csound_worker import CsoundWorker
+from backend.app.engine.render_ahead import BrowserClockRenderAhead, StereoPcmRing
+from backend.app.engine.render_executor import RenderExecutor
+
+
+def test_stereo_pcm_ring_wraps_without_losing_frames() -> None:
+    ring = StereoPcmRing(5)
+    first = np.arange(8, dtype=np.float32).reshape(4, 2)
+    second = np.arange(100, 106, dtype=np.float32).reshape(3, 2)
+
+    assert ring.write(first) == 4
+    assert np.array_equal(ring.read(3), first[:3])
+    assert ring.write(second) == 3
+    assert ring.writable_frames == 1
+    assert ring.write(second) == 1
+
+    out = ring.read(10)
+    assert np.array_equal(out, np.concatenate((first[3:], second, second[:1]), axis=0))
+    assert ring.readable_frames == 0
+    assert ring.read_index == 8
+
+
+def test_render_ahead_stays_bounded_and_reports_block_ranges(monkeypatch) -> None:
+    monkeypatch.setenv("VISUALCSOUND_AUDIO_OUTPUT_MODE", "browser_clock")
+    monkeypatch.setenv("VISUALCSOUND_FORCE_MOCK_ENGINE", "true")
+
+    worker = CsoundWorker()
+    worker.start(
+        "<CsoundSynthesizer>\n<CsInstruments>\nsr = 48000\nksmps = 32\nnchnls = 2\n</CsInstruments>\n</CsoundSynthesizer>",
+        midi_input="unused",
+        rtmidi_module="null",
+    )
+    rendered_blocks: list[int] = []
+    render_threads: set[str] = set()
+    submitted_calls: list[str] = []
+
+    def before_block(_index: int, start: int) -> None:
+        rendered_blocks.append(start)
+        render_threads.add(threading.current_thread().name)
+
+    def block_snapshot() -> tuple[int, str]:
+        return len(rendered_blocks), threading.current_thread().name
+
+    executor = RenderExecutor(worker_count=1)
+    submit = executor.submit
+
+    def counting_submit(session_id, fn, *args, **kwargs):
+        submitted_calls.append(session_id)
+        return submit(session_id, fn, *args, **kwargs)
+
+    executor.submit = counting_submit
+    render_ahead = BrowserClockRenderAhead(
+        worker=worker,
+        render_executor=executor,
+        session_id="session-a",
+        lookahead_frames=128,
+        max_request_frames=256,
+        before_block=before_block,
+        block_snapshot=block_snapshot,
+    )
+    render_ahead.start()
+    try:
+        assert asyncio.run(render_ahead.wait_for_blocks(4, timeout=2.0)) is True
+        assert render_ahead.ready_blocks <= 4
+        # The whole lookahead deficit renders in one executor call, not one round trip per block.
+        assert len(submitted_calls) == 1
+        # Budget samples cover whole delivered chunks, not the single blocks rendered ahead.
+        assert worker.render_budget.load is None
+
+        chunk = render_ahead.read_blocks(2)
+        assert chunk is not None
+        rendered, snapshots = chunk
+        assert (rendered.engine_sample_start, rendered.engine_sample_end) == (0, 64)
+        assert rendered.frames.shape == (64, 2)
+        assert snapshots == [(1, "render-worker-0"), (2, "render-worker-0")]
+        assert worker.render_budget.load is not None
+
+        assert asyncio.run(render_ahead.wait_for_blocks(8, timeout=2.0)) is True
+        chunk = render_ahead.read_blocks(8)
+        assert chunk is not None
+        assert (chunk[0].engine_sample_start, chunk[0].engine_sample_end) == (64, 320)
+        assert [block for block, _thread in chunk[1]] == list(range(3, 11))
+        assert render_ahead.delivered_sample_cursor == 320
+        assert rendered_blocks[:10] == [index * 32 for index in range(10)]
+        assert render_threads == {"render-worker-0"}
+    finally:
+        render_ahead.stop()
+        executor.shutdown()
+        worker.stop()
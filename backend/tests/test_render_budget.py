@@ -0,0 +1,55 @@
+from __future__ import annotations
+
+from backend.app.engine.render_budget import RenderBudgetMonitor
+
+_FRAMES = 480
+_SAMPLE_RATE = 48_000
+_BLOCK_NS = 10_000_000
+
+
+def _observe(monitor: RenderBudgetMonitor, load: float, *, times: int = 1) -> None:
+    for _ in range(times):
+        monitor.observe(wall_ns=int(load * _BLOCK_NS), frames=_FRAMES, sample_rate=_SAMPLE_RATE)
+
+
+def test_first_observation_sets_load_and_reports_one_transition() -> None:
+    monitor = RenderBudgetMonitor(warning_load=0.5, overload_load=0.9)
+    assert monitor.load is None
+    assert monitor.take_transition() is None
+
+    _observe(monitor, 0.95)
+
+    assert monitor.load == 0.95
+    assert monitor.state == "overloaded"
+    transition = monitor.take_transition()
+    assert transition is not None
+    assert (transition.previous_state, transition.state) == ("ok", "overloaded")
+    assert monitor.take_transition() is None
+
+
+def test_state_recovers_only_below_the_hysteresis_band() -> None:
+    monitor = RenderBudgetMonitor(warning_load=0.5, overload_load=0.9)
+    _observe(monitor, 1.0)
+    monitor.take_transition()
+
+    _observe(monitor, 0.8, times=30)
+    assert monitor.state == "overloaded"
+    assert monitor.take_transition() is None
+
+    _observe(monitor, 0.6, times=30)
+    assert monitor.state == "warning"
+    _observe(monitor, 0.45, times=30)
+    assert monitor.state == "warning"
+    _observe(monitor, 0.1, times=30)
+    assert monitor.state == "ok"
+
+    transition = monitor.take_transition()
+    assert transition is not None
+    assert (transition.previous_state, transition.state) == ("overloaded", "ok")
+
+
+def test_empty_blocks_are_ignored() -> None:
+    monitor = RenderBudgetMonitor()
+    monitor.observe(wall_ns=1_000_000, frames=0, sample_rate=_SAMPLE_RATE)
+    assert monitor.load is None
+    assert monitor.state == "ok"
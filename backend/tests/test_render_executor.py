@@ -0,0 +1,55 @@
+from __future__ import annotations
+
+import asyncio
+import threading
+
+import pytest
+
+from backend.app.engine.render_executor import RenderExecutor, physical_core_count
+
+
+def test_render_executor_pins_sessions_to_least_loaded_workers() -> None:
+    executor = RenderExecutor(worker_count=2)
+    try:
+        first = executor.submit("session-a", threading.current_thread).result(timeout=2)
+        again = executor.submit("session-a", threading.current_thread).result(timeout=2)
+        second = executor.submit("session-b", threading.current_thread).result(timeout=2)
+
+        assert first is again
+        assert first is not second
+        assert first.name.startswith("render-worker-")
+
+        stats = executor.stats()
+        assert [item.pinned_sessions for item in stats] == [1, 1]
+        assert [item.completed_tasks for item in stats] == [2, 1]
+        assert all(item.queue_depth == 0 for item in stats)
+        assert all(item.busy_ns >= 0 for item in stats)
+
+        executor.release_session("session-a")
+        assert [item.pinned_sessions for item in executor.stats()] == [0, 1]
+    finally:
+        executor.shutdown()
+
+
+def test_render_executor_propagates_errors_to_awaiting_caller() -> None:
+    executor = RenderExecutor(worker_count=1)
+
+    def _fail() -> None:
+        raise RuntimeError("render failed")
+
+    async def _run() -> None:
+        assert await executor.run("session-a", lambda value: value * 2, 21) == 42
+        with pytest.raises(RuntimeError, match="render failed"):
+            await executor.run("session-a", _fail)
+
+    try:
+        asyncio.run(_run())
+    finally:
+        executor.shutdown()
+
+    with pytest.raises(RuntimeError, match="shut down"):
+        executor.submit("session-a", lambda: None)
+
+
+def test_physical_core_count_is_positive() -> None:
+    assert physical_core_count() >= 1
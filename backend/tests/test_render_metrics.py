@@ -0,0 +1,68 @@
+from __future__ import annotations
+
+import threading
+
+from backend.app.engine.render_metrics import RenderHistogram, RenderLoopMetrics, format_openmetrics
+
+
+def test_histogram_quantiles_report_bucket_upper_bounds() -> None:
+    histogram = RenderHistogram((1.0, 2.0, 4.0))
+    for value in (0.5, 1.5, 1.5, 3.0, 9.0):
+        histogram.observe(value)
+
+    snapshot = histogram.snapshot()
+    assert snapshot.counts == (1, 2, 1, 1)
+    assert snapshot.count == 5
+    assert snapshot.mean == 3.1
+    assert snapshot.quantile(0.5) == 2.0
+    assert snapshot.quantile(0.8) == 4.0
+    assert snapshot.quantile(0.99) is None
+    assert RenderHistogram((1.0,)).snapshot().quantile(0.5) is None
+
+
+def test_histogram_counts_every_observation_from_concurrent_writers() -> None:
+    histogram = RenderHistogram((1.0, 2.0))
+
+    def write() -> None:
+        for _ in range(20_000):
+            histogram.observe(1.5)
+
+    writers = [threading.Thread(target=write) for _ in range(4)]
+    for writer in writers:
+        writer.start()
+    for writer in writers:
+        writer.join()
+
+    snapshot = histogram.snapshot()
+    assert snapshot.count == 80_000
+    assert snapshot.counts == (0, 80_000, 0)
+    assert snapshot.total == 120_000.0
+
+
+def test_compact_stats_scale_durations_to_milliseconds() -> None:
+    metrics = RenderLoopMetrics()
+    metrics.perform_ksmps.observe(0.0008)
+    metrics.midi_events_per_block.observe(3)
+
+    stats = metrics.compact_stats()
+    assert stats["perform_ksmps_ms"] == {"count": 1, "mean": 0.8, "p50": 1.0, "p99": 1.0}
+    assert stats["midi_events_per_block"] == {"count": 1, "mean": 3.0, "p50": 4.0, "p99": 4.0}
+    assert stats["encode_ms"] == {"count": 0, "mean": None, "p50": None, "p99": None}
+
+
+def test_openmetrics_exposition_has_cumulative_buckets_per_session() -> None:
+    metrics = RenderLoopMetrics()
+    metrics.render_queue_wait.observe(0.0004)
+    metrics.render_queue_wait.observe(0.003)
+
+    lines = format_openmetrics([('s"1', metrics, 5)]).splitlines()
+
+    name = "visualcsound_render_queue_wait_seconds"
+    label = 'session_id="s\\"1"'
+    assert f"# TYPE {name} histogram" in lines
+    assert f'{name}_bucket{{{label},le="0.0005"}} 1' in lines
+    assert f'{name}_bucket{{{label},le="0.005"}} 2' in lines
+    assert f'{name}_bucket{{{label},le="+Inf"}} 2' in lines
+    assert f"{name}_count{{{label}}} 2" in lines
+    assert f"visualcsound_midi_scheduler_overflow_total{{{label}}} 5" in lines
+    assert lines[-1] == "# EOF"
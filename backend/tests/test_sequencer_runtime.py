@@ -2,7 +2,7 @@ from __future__ import annotations
 
 from backend.app.models.session import SessionSequencerConfigRequest
 from backend.app.services import sequencer_runtime
-from backend.app.services.sequencer_runtime import SessionSequencerRuntime
+from backend.app.services.sequencer_runtime import OfflineClock, SessionSequencerRuntime
 
 
 class _FakeMidiService:
@@ -198,6 +198,7 @@ def test_sequencer_step_event_carries_lightweight_runtime_delta() -> None:
     assert payload["running"] is True
     assert payload["step_count"] == 8
     assert payload["transport_subunit"] == 420
+    assert payload["transport_time_ms"] > 0
     assert "sequencer_status" not in payload
 
     tracks = payload["tracks"]
@@ -207,3 +208,253 @@ def test_sequencer_step_event_carries_lightweight_runtime_delta() -> None:
     controller_tracks = payload["controller_tracks"]
     assert isinstance(controller_tracks, list)
     assert controller_tracks == []
+
+
+def _pad_loop_config(*, sync_to_track_id: str | None = None) -> SessionSequencerConfigRequest:
+    return SessionSequencerConfigRequest.model_validate(
+        {
+            "timing": {"tempo_bpm": 120},
+            "step_count": 8,
+            "playback_end_step": 512,
+            "tracks": [
+                {
+                    "track_id": "lead",
+                    "midi_channel": 1,
+                    "length_beats": 1,
+                    "active_pad": 0,
+                    "enabled": True,
+                    "pad_loop_enabled": True,
+                    "pad_loop_repeat": True,
+                    "pad_loop_sequence": [-1, 1, 0, -2, 1],
+                    "pads": [
+                        {
+                            "pad_index": 0,
+                            "length_beats": 1,
+                            "steps": [{"note": 60, "velocity": 90}, {"hold": True}, None, 62],
+                        },
+                        {"pad_index": 1, "length_beats": 2, "steps": [64, 65]},
+                    ],
+                },
+                {
+                    "track_id": "bass",
+                    "midi_channel": 2,
+                    "length_beats": 3,
+                    "active_pad": 2,
+                    "enabled": True,
+                    "sync_to_track_id": sync_to_track_id,
+                    "pads": [{"pad_index": 2, "length_beats": 3, "steps": [36, None, 38]}],
+                },
+                {
+                    "track_id": "once",
+                    "midi_channel": 3,
+                    "length_beats": 1,
+                    "active_pad": 0,
+                    "enabled": True,
+                    "pad_loop_enabled": True,
+                    "pad_loop_repeat": False,
+                    "pad_loop_sequence": [1, -1, 0],
+                    "pads": [{"pad_index": 1, "length_beats": 2, "steps": [70]}],
+                },
+            ],
+            "controller_tracks": [
+                {
+                    "track_id": "cutoff",
+                    "controller_number": 74,
+                    "length_beats": 2,
+                    "active_pad": 0,
+                    "enabled": True,
+                    "pad_loop_enabled": True,
+                    "pad_loop_sequence": [0, -4, 3],
+                    "pads": [
+                        {"pad_index": 0, "keypoints": [{"position": 0.0, "value": 0}, {"position": 1.0, "value": 127}]}
+                    ],
+                }
+            ],
+        }
+    )
+
+
+def _track_seek_state(runtime: SessionSequencerRuntime) -> list[tuple[object, ...]]:
+    config = runtime._ensure_config()
+    return [
+        (track.enabled, track.active_pad, track.phase_offset_subunit, track.pad_loop_position, track.sequence_ended)
+        for track in [*config.tracks.values(), *config.controller_tracks.values()]
+    ]
+
+
+def test_timeline_seek_matches_boundary_replay() -> None:
+    runtime = SessionSequencerRuntime(
+        session_id="session-seek",
+        midi_service=_FakeMidiService(),  # type: ignore[arg-type]
+        midi_input_selector="mido:test",
+        controller_default_channels=(1,),
+        clock_mode="render_driven",
+        publish_event=lambda _event_type, _payload: None,
+    )
+    runtime.configure(_pad_loop_config())
+    config = runtime._ensure_config()
+    lead_timeline = config.tracks["lead"].pads[0].timeline
+    assert lead_timeline.event_offsets == (0, 1680, 2520)
+    assert lead_timeline.notes == (60, 62)
+    assert lead_timeline.velocities == (90, 100)
+    assert lead_timeline.durations == (1680, 840)
+
+    for target in range(0, 512 * 420, 997):
+        runtime._apply_absolute_subunit_locked(config, target)
+        seeked = _track_seek_state(runtime)
+
+        for track in config.tracks.values():
+            runtime._reset_track_runtime_for_absolute_subunit_locked(track)
+        for track in config.controller_tracks.values():
+            runtime._reset_controller_track_runtime_for_absolute_subunit_locked(track)
+        runtime._replay_cycle_boundaries_locked(config, target)
+        assert _track_seek_state(runtime) == seeked, target
+
+
+def test_render_driven_idle_skipping_emits_the_same_midi(monkeypatch) -> None:
+    def run(*, skip_idle: bool) -> tuple[list[tuple[str, list[list[int]], float | None]], list[str], int]:
+        midi_service = _FakeMidiService()
+        published: list[str] = []
+        runtime = SessionSequencerRuntime(
+            session_id="session-skip",
+            midi_service=midi_service,  # type: ignore[arg-type]
+            midi_input_selector="mido:test",
+            controller_default_channels=(1,),
+            clock_mode="render_driven",
+            publish_event=lambda event_type, _payload: published.append(event_type),
+        )
+        if not skip_idle:
+            monkeypatch.setattr(runtime, "_render_idle_subunits_locked", lambda _config, _max_subunits: 0)
+        runtime.configure(_pad_loop_config(sync_to_track_id="lead"))
+        runtime.start(position_step=0)
+        status = runtime.status()
+        for _ in range(2_000):
+            status = runtime.advance_render_block(sample_rate=48_000, ksmps=64)
+        return midi_service.calls, published, status.transport_subunit
+
+    assert run(skip_idle=True) == run(skip_idle=False)
+
+
+def test_offline_run_matches_event_by_event_wall_clock_stepping() -> None:
+    def run(*, offline: bool) -> tuple[list[tuple[float, list[int]]], float]:
+        clock = OfflineClock()
+        midi_service = _FakeMidiService()
+        runtime = SessionSequencerRuntime(
+            session_id="session-offline",
+            midi_service=midi_service,  # type: ignore[arg-type]
+            midi_input_selector="mido:test",
+            controller_default_channels=(1,),
+            clock_mode="offline" if offline else "wall_clock",
+            clock=clock,
+            publish_event=lambda _event_type, _payload: None,
+        )
+        runtime.configure(_pad_loop_config(sync_to_track_id="lead"))
+        timed: list[tuple[float, list[int]]] = []
+        recorded = 0
+
+        def collect(_span_start: float, _span_end: float) -> None:
+            nonlocal recorded
+            for _selector, messages, delay in midi_service.calls[recorded:]:
+                timed.extend((round(_span_start + (delay or 0.0), 9), message) for message in messages)
+            recorded = len(midi_service.calls)
+
+        if offline:
+            end_seconds = runtime.run_offline(collect)
+        else:
+            # The previous export path: one wall-clock scheduler iteration per visible step or event.
+            with runtime._lock:
+                runtime._running = True
+            config = runtime._ensure_config()
+            while runtime._running:
+                span_start = clock.seconds
+                clock.seconds += runtime._perform_subunit_event(
+                    config,
+                    runtime._absolute_subunit,
+                    scheduled_time=span_start,
+                )
+                collect(span_start, clock.seconds)
+            end_seconds = clock.seconds
+        return timed, round(end_seconds, 9)
+
+    offline_events, offline_end = run(offline=True)
+    stepped_events, stepped_end = run(offline=False)
+
+    assert offline_events
+    assert offline_end == stepped_end
+    assert offline_events == stepped_events
+
+
+def test_tick_render_block_queues_step_events_until_drained() -> None:
+    midi_service = _FakeMidiService()
+    published_events: list[tuple[str, dict[str, object]]] = []
+    runtime = SessionSequencerRuntime(
+        session_id="session-tick",
+        midi_service=midi_service,  # type: ignore[arg-type]
+        midi_input_selector="mido:test",
+        controller_default_channels=(1,),
+        clock_mode="render_driven",
+        publish_event=lambda event_type, payload: published_events.append((event_type, payload)),
+    )
+    runtime.configure(
+        SessionSequencerConfigRequest.model_validate(
+            {
+                "timing": {"tempo_bpm": 120},
+                "step_count": 8,
+                "playback_end_step": 8,
+                "tracks": [
+                    {
+                        "track_id": "lead",
+                        "midi_channel": 1,
+                        "length_beats": 1,
+                        "enabled": True,
+                        "pads": [{"pad_index": 0, "length_beats": 1, "steps": [60, 61, 62, 63]}],
+                    }
+                ],
+            }
+        )
+    )
+    runtime.start(position_step=0)
+
+    assert runtime.tick_render_block(sample_rate=1_000, ksmps=100) is True
+    assert _note_on_messages(midi_service) == [[0x90, 60, 100]]
+    assert published_events == []
+
+    assert runtime.drain_notifications() == 1
+    assert [event_type for event_type, _payload in published_events] == ["sequencer_step"]
+    assert published_events[0][1]["transport_subunit"] == 420
+    assert runtime.drain_notifications() == 0
+
+
+def test_controller_pad_tables_match_scalar_curve_sampling() -> None:
+    from backend.app.models import export
+    from backend.app.models.session import SessionControllerSequencerKeypointConfig
+
+    timing = sequencer_runtime.SequencerTimingRuntime(
+        tempo_bpm=120,
+        meter_numerator=4,
+        meter_denominator=4,
+        steps_per_beat=4,
+    )
+    keypoints = [
+        SessionControllerSequencerKeypointConfig(position=0.0, value=10),
+        SessionControllerSequencerKeypointConfig(position=0.3, value=127),
+        SessionControllerSequencerKeypointConfig(position=0.55, value=64),
+        SessionControllerSequencerKeypointConfig(position=0.8, value=0),
+    ]
+    pad = SessionSequencerRuntime._compile_controller_pad_runtime(keypoints, length_beats=3, timing=timing)
+
+    quantum = sequencer_runtime._CONTROLLER_AUTOMATION_SUBUNIT_QUANTUM
+    normalized = export._normalize_controller_keypoints(keypoints)
+    expected = bytes(
+        export._sample_controller_curve_value(normalized, offset / pad.transport_subunit_count)
+        for offset in range(0, pad.transport_subunit_count, quantum)
+    )
+    assert pad.value_table == expected
+
+    for slot, event_index in enumerate(pad.slot_event_index):
+        event = pad.events[event_index]
+        assert event.offset_subunit <= slot * quantum
+        assert event.value == pad.value_table[slot]
+    assert [event.offset_subunit // quantum for event in pad.events] == [
+        slot for slot in range(len(expected)) if slot == 0 or expected[slot] != expected[slot - 1]
+    ]
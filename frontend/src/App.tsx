@@ -1331,6 +1331,7 @@ export default function App() {
   const sequencerTransportStartInFlightRef = useRef(false);
   const arrangerTransportActiveRef = useRef(false);
   const {
+    browserAudioAddedLatencyMs,
     browserAudioError,
     browserAudioStatus,
     browserAudioTransport,
@@ -3059,6 +3060,7 @@ export default function App() {
                     browserAudioTransport={browserAudioTransport}
                     browserAudioStatus={browserAudioTransport !== "off" ? browserAudioStatus : "off"}
                     browserAudioError={browserAudioTransport !== "off" ? browserAudioError : null}
+                    browserAudioAddedLatencyMs={browserAudioTransport !== "off" ? browserAudioAddedLatencyMs : null}
                     onBindMidiInput={(midiInput) => {
                       void bindMidiInput(midiInput);
                     }}
@@ -16,6 +16,8 @@ import type {
   SessionArpeggiatorConfigRequest,
   SessionArpeggiatorStatus,
   SessionCreateResponse,
+  SessionHotReloadResponse,
+  SessionHotReloadVoicePolicy,
   SessionSequencerConfigRequest,
   SessionSequencerQueuePadRequest,
   SessionSequencerStartRequest,
@@ -184,6 +186,11 @@ export const api = {
   getSession: (sessionId: string) => request<SessionInfo>(`/sessions/${sessionId}`),
   compileSession: (sessionId: string) =>
     request<CompileResponse>(`/sessions/${sessionId}/compile`, { method: "POST" }),
+  hotReloadSession: (sessionId: string, voicePolicy: SessionHotReloadVoicePolicy = "release") =>
+    request<SessionHotReloadResponse>(`/sessions/${sessionId}/hot-reload`, {
+      method: "POST",
+      body: JSON.stringify({ voice_policy: voicePolicy })
+    }),
   startSession: (sessionId: string) =>
     request<SessionActionResponse>(`/sessions/${sessionId}/start`, { method: "POST" }),
   stopSession: (sessionId: string) =>
@@ -1,3 +1,25 @@
+// Deinterleave kernels for the render quantum. They run on the real-time audio thread, so they take
+// plain typed arrays and offsets, allocate nothing and keep every loop monomorphic over Float32Array.
+
+function copyStereoSegment(samples, stride, sampleBase, left, right, outputOffset, frameCount) {
+  const outputEnd = outputOffset + frameCount;
+  let sampleIndex = sampleBase;
+  for (let frameIndex = outputOffset; frameIndex < outputEnd; frameIndex += 1) {
+    left[frameIndex] = samples[sampleIndex];
+    right[frameIndex] = samples[sampleIndex + 1];
+    sampleIndex += stride;
+  }
+}
+
+function copyChannelSegment(samples, stride, sampleBase, destination, outputOffset, frameCount) {
+  const outputEnd = outputOffset + frameCount;
+  let sampleIndex = sampleBase;
+  for (let frameIndex = outputOffset; frameIndex < outputEnd; frameIndex += 1) {
+    destination[frameIndex] = samples[sampleIndex];
+    sampleIndex += stride;
+  }
+}
+
 class BrowserClockProcessor extends AudioWorkletProcessor {
   constructor(options) {
     super();
@@ -8,6 +30,8 @@ class BrowserClockProcessor extends AudioWorkletProcessor {
     this.stateBuffer = new Int32Array(processorOptions.stateBuffer);
     this.lowWaterFrames = 0;
     this.refillRequested = false;
+    // Output channel -> ring channel, rebuilt only when the output channel count changes.
+    this.sourceChannels = new Int32Array(0);
     this.port.onmessage = (event) => {
       const message = event?.data;
       if (!message || message.type !== "set_refill_threshold") {
@@ -33,50 +57,40 @@ class BrowserClockProcessor extends AudioWorkletProcessor {
     const framesToConsume = Math.min(availableFrames, outputFrameCount);
     const channelCount = output.length;
 
-    for (let channelIndex = 0; channelIndex < channelCount; channelIndex += 1) {
-      output[channelIndex].fill(0);
-    }
-
     if (framesToConsume > 0) {
-      let remainingFrames = framesToConsume;
-      let outputOffset = 0;
-      let ringFrame = readFrame % this.capacityFrames;
+      const samples = this.sampleBuffer;
+      const stride = this.channels;
+      const ringFrame = readFrame % this.capacityFrames;
+      const firstFrames = Math.min(framesToConsume, this.capacityFrames - ringFrame);
+      const firstSampleBase = ringFrame * stride;
+      const wrappedFrames = framesToConsume - firstFrames;
 
-      if (channelCount === 2 && this.channels >= 2) {
+      if (channelCount === 2 && stride >= 2) {
         const left = output[0];
         const right = output[1];
-        while (remainingFrames > 0) {
-          const segmentFrames = Math.min(remainingFrames, this.capacityFrames - ringFrame);
-          let sampleBase = ringFrame * this.channels;
-          const segmentEnd = outputOffset + segmentFrames;
-          for (let frameIndex = outputOffset; frameIndex < segmentEnd; frameIndex += 1) {
-            left[frameIndex] = this.sampleBuffer[sampleBase];
-            right[frameIndex] = this.sampleBuffer[sampleBase + 1];
-            sampleBase += this.channels;
-          }
-          remainingFrames -= segmentFrames;
-          outputOffset = segmentEnd;
-          ringFrame = 0;
+        copyStereoSegment(samples, stride, firstSampleBase, left, right, 0, firstFrames);
+        if (wrappedFrames > 0) {
+          copyStereoSegment(samples, stride, 0, left, right, firstFrames, wrappedFrames);
         }
       } else {
-        while (remainingFrames > 0) {
-          const segmentFrames = Math.min(remainingFrames, this.capacityFrames - ringFrame);
-          let sampleBase = ringFrame * this.channels;
-          const segmentEnd = outputOffset + segmentFrames;
-          for (let frameIndex = outputOffset; frameIndex < segmentEnd; frameIndex += 1) {
-            for (let channelIndex = 0; channelIndex < channelCount; channelIndex += 1) {
-              const sourceChannel = Math.min(channelIndex, this.channels - 1);
-              output[channelIndex][frameIndex] = this.sampleBuffer[sampleBase + sourceChannel] ?? 0;
-            }
-            sampleBase += this.channels;
+        const sourceChannels = this.sourceChannelsFor(channelCount);
+        for (let channelIndex = 0; channelIndex < channelCount; channelIndex += 1) {
+          const destination = output[channelIndex];
+          const sourceChannel = sourceChannels[channelIndex];
+          copyChannelSegment(samples, stride, firstSampleBase + sourceChannel, destination, 0, firstFrames);
+          if (wrappedFrames > 0) {
+            copyChannelSegment(samples, stride, sourceChannel, destination, firstFrames, wrappedFrames);
           }
-          remainingFrames -= segmentFrames;
-          outputOffset = segmentEnd;
-          ringFrame = 0;
         }
       }
     }
 
+    if (framesToConsume < outputFrameCount) {
+      for (let channelIndex = 0; channelIndex < channelCount; channelIndex += 1) {
+        output[channelIndex].fill(0, framesToConsume);
+      }
+    }
+
     Atomics.store(this.stateBuffer, 0, readFrame + framesToConsume);
     const availableAfterConsume = Math.max(0, availableFrames - framesToConsume);
     if (framesToConsume < outputFrameCount) {
@@ -97,6 +111,16 @@ class BrowserClockProcessor extends AudioWorkletProcessor {
 
     return true;
   }
+
+  sourceChannelsFor(channelCount) {
+    if (this.sourceChannels.length !== channelCount) {
+      this.sourceChannels = new Int32Array(channelCount);
+      for (let channelIndex = 0; channelIndex < channelCount; channelIndex += 1) {
+        this.sourceChannels[channelIndex] = Math.min(channelIndex, this.channels - 1);
+      }
+    }
+    return this.sourceChannels;
+  }
 }
 
 registerProcessor("browser-clock-processor", BrowserClockProcessor);
@@ -9,6 +9,7 @@ interface RuntimePanelProps {
   browserAudioTransport?: "off" | "browser_clock";
   browserAudioStatus?: "off" | "connecting" | "live" | "error";
   browserAudioError?: string | null;
+  browserAudioAddedLatencyMs?: number | null;
   onBindMidiInput: (midiInput: string) => void;
   onToggleCollapse?: () => void;
 }
@@ -28,6 +29,7 @@ const RUNTIME_PANEL_COPY: Record<
     browserAudioBrowserClockConnecting: string;
     browserAudioBrowserClockLive: string;
     browserAudioBrowserClockError: string;
+    browserAudioAddedLatency: string;
     sessionEvents: string;
     noEvents: string;
   }
@@ -45,6 +47,7 @@ const RUNTIME_PANEL_COPY: Record<
     browserAudioBrowserClockConnecting: "Priming browser PCM queue...",
     browserAudioBrowserClockLive: "Browser-owned PCM runtime active",
     browserAudioBrowserClockError: "Browser PCM runtime error",
+    browserAudioAddedLatency: "Buffered latency",
     sessionEvents: "Session Events",
     noEvents: "No events yet."
   },
@@ -61,6 +64,7 @@ const RUNTIME_PANEL_COPY: Record<
     browserAudioBrowserClockConnecting: "PCM-Puffer im Browser wird vorbereitet...",
     browserAudioBrowserClockLive: "Browser-gesteuerte PCM-Laufzeit aktiv",
     browserAudioBrowserClockError: "Browser-PCM-Laufzeitfehler",
+    browserAudioAddedLatency: "Gepufferte Latenz",
     sessionEvents: "Session-Events",
     noEvents: "Noch keine Events."
   },
@@ -77,6 +81,7 @@ const RUNTIME_PANEL_COPY: Record<
     browserAudioBrowserClockConnecting: "Preparation de la file PCM navigateur...",
     browserAudioBrowserClockLive: "Runtime PCM pilote par le navigateur actif",
     browserAudioBrowserClockError: "Erreur runtime PCM navigateur",
+    browserAudioAddedLatency: "Latence tamponnee",
     sessionEvents: "Evenements de session",
     noEvents: "Pas encore d'evenements."
   },
@@ -93,6 +98,7 @@ const RUNTIME_PANEL_COPY: Record<
     browserAudioBrowserClockConnecting: "Preparando cola PCM del navegador...",
     browserAudioBrowserClockLive: "Runtime PCM controlado por el navegador activo",
     browserAudioBrowserClockError: "Error del runtime PCM del navegador",
+    browserAudioAddedLatency: "Latencia en bufer",
     sessionEvents: "Eventos de sesion",
     noEvents: "Aun no hay eventos."
   }
@@ -107,6 +113,7 @@ export function RuntimePanel({
   browserAudioTransport = "off",
   browserAudioStatus = "off",
   browserAudioError = null,
+  browserAudioAddedLatencyMs = null,
   onBindMidiInput,
   onToggleCollapse
 }: RuntimePanelProps) {
@@ -175,6 +182,11 @@ export function RuntimePanel({
           <div className="rounded-xl border border-slate-700 bg-slate-950/80 p-2">
           <div className="text-xs uppercase tracking-[0.2em] text-slate-500">{copy.browserAudio}</div>
           <div className="mt-2 text-[11px] text-slate-300">{browserAudioStatusText}</div>
+          {browserAudioAddedLatencyMs !== null ? (
+            <div className="mt-1 font-mono text-[10px] text-slate-400">
+              {copy.browserAudioAddedLatency}: {browserAudioAddedLatencyMs} ms
+            </div>
+          ) : null}
           {browserAudioError ? <div className="mt-1 text-[10px] text-rose-300">{browserAudioError}</div> : null}
         </div>
       ) : null}
@@ -15,6 +15,8 @@ import type {
 
 type BrowserAudioStatus = "off" | "connecting" | "live" | "error";
 
+const ADDED_LATENCY_POLL_INTERVAL_MS = 500;
+
 interface UseBrowserClockAudioControllerParams {
   applySequencerStatusRef: MutableRefObject<(status: SessionSequencerStatus) => void>;
   browserClockLatencySettings: BrowserClockLatencySettings;
@@ -26,6 +28,7 @@ interface UseBrowserClockAudioControllerParams {
 
 interface UseBrowserClockAudioControllerResult {
   browserClockClientRef: MutableRefObject<BrowserClockAudioClient>;
+  browserAudioAddedLatencyMs: number | null;
   browserAudioError: string | null;
   browserAudioStatus: BrowserAudioStatus;
   browserAudioTransport: "browser_clock" | "off";
@@ -67,6 +70,7 @@ export function useBrowserClockAudioController({
   const [browserClockPlaybackTransportSubunit, setBrowserClockPlaybackTransportSubunit] = useState<number | null>(null);
   const [browserAudioStatus, setBrowserAudioStatus] = useState<BrowserAudioStatus>("off");
   const [browserAudioError, setBrowserAudioError] = useState<string | null>(null);
+  const [browserAudioAddedLatencyMs, setBrowserAudioAddedLatencyMs] = useState<number | null>(null);
   const [runtimeAudioOutputMode, setRuntimeAudioOutputMode] = useState<SessionAudioOutputMode | null>(null);
 
   useEffect(() => {
@@ -175,6 +179,24 @@ export function useBrowserClockAudioController({
     };
   }, [effectiveAudioOutputMode, sequencer.isPlaying]);
 
+  useEffect(() => {
+    if (browserAudioStatus !== "live") {
+      setBrowserAudioAddedLatencyMs(null);
+      return;
+    }
+
+    const syncAddedLatency = () => {
+      const addedLatencyMs = browserClockClientRef.current.getJitterBufferState()?.addedLatencyMs;
+      setBrowserAudioAddedLatencyMs(addedLatencyMs === undefined ? null : Math.round(addedLatencyMs));
+    };
+
+    syncAddedLatency();
+    const timer = window.setInterval(syncAddedLatency, ADDED_LATENCY_POLL_INTERVAL_MS);
+    return () => {
+      window.clearInterval(timer);
+    };
+  }, [browserAudioStatus]);
+
   const disconnectBrowserClockAudio = useCallback(() => {
     void browserClockClientRef.current.disconnect();
   }, []);
@@ -232,6 +254,7 @@ export function useBrowserClockAudioController({
 
   return {
     browserClockClientRef,
+    browserAudioAddedLatencyMs,
     browserAudioError,
     browserAudioStatus,
     browserAudioTransport,
@@ -40,6 +40,9 @@ import { useBrowserClockAudioController } from "./useBrowserClockAudioController
 
 type AppStoreState = ReturnType<typeof useAppStore.getState>;
 
+// The playhead repaints once per display frame, so the backend may drop step snapshots closer together.
+const SESSION_EVENT_SEQUENCER_FRAME_MS = 16;
+
 type SequencerRuntimeControllerErrors = {
   noActiveRuntimeSession: string;
   startInstrumentsFirstForSequencer: string;
@@ -76,6 +79,7 @@ interface UseSequencerRuntimeControllerParams {
 }
 
 interface UseSequencerRuntimeControllerResult {
+  browserAudioAddedLatencyMs: number | null;
   browserAudioError: string | null;
   browserAudioStatus: "off" | "connecting" | "live" | "error";
   browserAudioTransport: "browser_clock" | "off";
@@ -133,6 +137,7 @@ export function useSequencerRuntimeController({
 
   const {
     browserClockClientRef,
+    browserAudioAddedLatencyMs,
     browserAudioError,
     browserAudioStatus,
     browserAudioTransport,
@@ -521,7 +526,7 @@ export function useSequencerRuntimeController({
     }
 
     const sessionId = activeSessionId;
-    const url = `${wsBaseUrl()}/ws/sessions/${sessionId}`;
+    const url = `${wsBaseUrl()}/ws/sessions/${sessionId}?sequencer_frame_ms=${SESSION_EVENT_SEQUENCER_FRAME_MS}`;
     let socket: WebSocket | null = null;
     let heartbeatTimer: number | null = null;
     let reconnectTimer: number | null = null;
@@ -1071,6 +1076,7 @@ export function useSequencerRuntimeController({
   }, [stopSequencerTransport]);
 
   return {
+    browserAudioAddedLatencyMs,
     browserAudioError,
     browserAudioStatus,
     browserAudioTransport,
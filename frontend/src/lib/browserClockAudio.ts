@@ -1,5 +1,10 @@
 import { wsBaseUrl } from "../api/client";
-import { resolveDefaultBrowserClockLatencySettings } from "./browserClockLatencyConfig";
+import { applyBrowserClockStatusDelta, decodeBrowserClockRenderFrame } from "./browserClockFrames";
+import { BrowserClockJitterController, type BrowserClockJitterBufferState } from "./browserClockJitterBuffer";
+import {
+  resolveDefaultBrowserClockLatencySettings,
+  resolveDefaultBrowserClockPcmEncoding
+} from "./browserClockLatencyConfig";
 import type {
   BrowserClockClaimControllerRequest,
   BrowserClockClockSyncMessage,
@@ -24,6 +29,11 @@ import type {
 
 type BrowserAudioStatus = "off" | "connecting" | "live" | "error";
 
+export type BrowserClockJitterBufferStatus = BrowserClockJitterBufferState & {
+  // Audio the ring is currently aiming to hold, after startup priming, recovery boost and frame clamps.
+  addedLatencyMs: number;
+};
+
 type BrowserClockCallbacks = {
   onStatusChange: (status: BrowserAudioStatus) => void;
   onErrorChange: (message: string | null) => void;
@@ -51,15 +61,23 @@ const CLOCK_SYNC_MAX_AGE_MS = 2_000;
 const SEQUENCER_REQUEST_TIMEOUT_MS = 5_000;
 const AUDIO_UNLOCK_MESSAGE = "Tap anywhere to enable browser audio.";
 const UNDERRUN_RECOVERY_WINDOW_MS = 5_000;
+const AUDIO_RENDER_QUANTUM_FRAMES = 128;
 
 type PendingRenderChunk = {
   metadata: BrowserClockRenderChunkMessage;
   request: PendingRenderRequest;
 };
 
+type RenderChunkLayout = {
+  target_frame_count: number;
+  channels: number;
+  sequencer_status: SessionSequencerStatus;
+};
+
 type QueueTargets = {
   lowWaterFrames: number;
   highWaterFrames: number;
+  maxRequestFrames: number;
   maxParallelRequests: number;
 };
 
@@ -120,6 +138,7 @@ export class BrowserClockAudioClient {
   private clockSyncTimer: number | null = null;
   private pendingChunk: PendingRenderChunk | null = null;
   private streamConfig: BrowserClockStreamConfigMessage | null = null;
+  private renderStatusBaseline: SessionSequencerStatus | null = null;
   private inFlightRenderRequests = 0;
   private inFlightImmediateRenderRequests = 0;
   private pendingRenderFrames = 0;
@@ -130,6 +149,9 @@ export class BrowserClockAudioClient {
   private lastClockSyncAtPerfMs = 0;
   private startupPrimed = false;
   private lastUnderrunCount = 0;
+  private lastObservedReadFrame = 0;
+  private lastObservedPlaybackAtMs = 0;
+  private readonly jitterController: BrowserClockJitterController;
   private underrunBoostFrames = 0;
   private underrunRecoveryUntil = 0;
   private lastImmediateRenderAtMs = 0;
@@ -141,12 +163,14 @@ export class BrowserClockAudioClient {
 
   constructor(callbacks: BrowserClockCallbacks) {
     this.callbacks = callbacks;
+    this.jitterController = new BrowserClockJitterController(this.currentLatencySettings());
   }
 
   refreshLatencySettings(): void {
     if (!this.streamConfig || this.socket?.readyState !== WebSocket.OPEN) {
       return;
     }
+    this.jitterController.reset(this.currentLatencySettings());
     this.sendClaimController();
     this.requestRefill();
     this.syncWorkletRefillThreshold();
@@ -207,6 +231,7 @@ export class BrowserClockAudioClient {
     this.stopClockSyncLoop();
     this.pendingChunk = null;
     this.streamConfig = null;
+    this.renderStatusBaseline = null;
     this.syncWorkletRefillThreshold(0);
     this.resetRenderPipelineState();
     this.resetClockSyncState();
@@ -342,7 +367,9 @@ export class BrowserClockAudioClient {
       audio_context_sample_rate: sampleRate,
       queue_low_water_frames: claimTargets.lowWaterFrames,
       queue_high_water_frames: claimTargets.highWaterFrames,
-      max_blocks_per_request: latencySettings.maxBlocksPerRequest
+      max_blocks_per_request: latencySettings.maxBlocksPerRequest,
+      render_chunk_format: "binary",
+      pcm_encoding: resolveDefaultBrowserClockPcmEncoding()
     };
 
     try {
@@ -391,6 +418,7 @@ export class BrowserClockAudioClient {
     this.socket = socket;
     this.pendingChunk = null;
     this.streamConfig = null;
+    this.renderStatusBaseline = null;
     this.resetRenderPipelineState();
     this.resetClockSyncState();
 
@@ -452,12 +480,15 @@ export class BrowserClockAudioClient {
       switch (parsed.type) {
         case "stream_config":
           this.streamConfig = parsed;
+          this.renderStatusBaseline = parsed.sequencer_status;
           this.pendingChunk = null;
           this.resetRenderPipelineState();
           this.clearPlaybackTimeline();
           this.nextChunkTransportSubunitStart = parsed.sequencer_status.transport_subunit;
           this.lastPlaybackTransportSubunit = parsed.sequencer_status.transport_subunit;
           this.lastUnderrunCount = this.readUnderrunCount();
+          this.resetPlaybackObservation();
+          this.jitterController.reset(this.currentLatencySettings());
           this.callbacks.onSequencerStatus(parsed.sequencer_status);
           this.finishPendingConnect(null);
           this.syncWorkletRefillThreshold();
@@ -497,6 +528,12 @@ export class BrowserClockAudioClient {
       return;
     }
 
+    if (this.streamConfig?.render_chunk_format === "binary") {
+      const arrayBuffer = payload instanceof Blob ? await payload.arrayBuffer() : payload;
+      this.handleBinaryRenderFrame(arrayBuffer);
+      return;
+    }
+
     const metadata = this.pendingChunk;
     if (!metadata) {
       this.handleFatalError("Received PCM data without matching render metadata.", { closeSocket: true });
@@ -505,14 +542,44 @@ export class BrowserClockAudioClient {
 
     const arrayBuffer = payload instanceof Blob ? await payload.arrayBuffer() : payload;
     this.pendingChunk = null;
-    this.inFlightRenderRequests = Math.max(0, this.inFlightRenderRequests - 1);
-    this.pendingRenderFrames = Math.max(0, this.pendingRenderFrames - metadata.request.estimatedFrames);
-    if (metadata.request.priority === "interactive") {
-      this.inFlightImmediateRenderRequests = Math.max(0, this.inFlightImmediateRenderRequests - 1);
+    this.completeRenderRequest(metadata.request);
+
+    try {
+      this.enqueuePcmChunk(metadata.metadata, new Float32Array(arrayBuffer));
+      this.updateStartupPrimed();
+      this.syncStatusFromState();
+      this.requestRefill();
+    } catch (error) {
+      const message = error instanceof Error ? error.message : "Failed to buffer browser-clock audio.";
+      this.handleFatalError(message, { closeSocket: true });
     }
+  }
 
+  private handleBinaryRenderFrame(buffer: ArrayBuffer): void {
     try {
-      this.enqueuePcmChunk(metadata.metadata, arrayBuffer);
+      const frame = decodeBrowserClockRenderFrame(buffer);
+      const baseline = this.renderStatusBaseline;
+      if (!baseline) {
+        throw new Error("Received a browser-clock render frame before stream configuration.");
+      }
+      const request = this.pendingRenderRequests.shift() ?? {
+        estimatedFrames: frame.targetFrameCount,
+        priority: "steady",
+        requestId: nextRequestId(),
+        clientPerfMs: 0
+      };
+      this.completeRenderRequest(request);
+
+      const sequencerStatus = applyBrowserClockStatusDelta(baseline, frame);
+      this.renderStatusBaseline = sequencerStatus;
+      this.enqueuePcmChunk(
+        {
+          target_frame_count: frame.targetFrameCount,
+          channels: frame.channels,
+          sequencer_status: sequencerStatus
+        },
+        frame.samples
+      );
       this.updateStartupPrimed();
       this.syncStatusFromState();
       this.requestRefill();
@@ -522,6 +589,17 @@ export class BrowserClockAudioClient {
     }
   }
 
+  private completeRenderRequest(request: PendingRenderRequest): void {
+    if (request.clientPerfMs > 0) {
+      this.jitterController.observeRenderRoundTrip(performance.now() - request.clientPerfMs);
+    }
+    this.inFlightRenderRequests = Math.max(0, this.inFlightRenderRequests - 1);
+    this.pendingRenderFrames = Math.max(0, this.pendingRenderFrames - request.estimatedFrames);
+    if (request.priority === "interactive") {
+      this.inFlightImmediateRenderRequests = Math.max(0, this.inFlightImmediateRenderRequests - 1);
+    }
+  }
+
   private handleEngineError(message: BrowserClockEngineErrorMessage): void {
     const error = new Error(message.detail);
     this.resetRenderPipelineState();
@@ -649,7 +727,7 @@ export class BrowserClockAudioClient {
         Math.min(
           streamConfig.max_blocks_per_request,
           latencySettings.maxBlocksPerRequest,
-          Math.ceil(deficitFrames / framesPerBlock)
+          Math.ceil(Math.min(deficitFrames, queueTargets.maxRequestFrames) / framesPerBlock)
         )
       );
       const estimatedFrames = this.dispatchRenderRequest(streamConfig, requestedBlocks, "steady");
@@ -790,11 +868,12 @@ export class BrowserClockAudioClient {
     return {
       lowWaterFrames: startupLowWaterFrames,
       highWaterFrames: startupHighWaterFrames,
+      maxRequestFrames: startupHighWaterFrames,
       maxParallelRequests: latencySettings.startupMaxParallelRequests
     };
   }
 
-  private enqueuePcmChunk(metadata: BrowserClockRenderChunkMessage, buffer: ArrayBuffer): void {
+  private enqueuePcmChunk(metadata: RenderChunkLayout, source: Float32Array): void {
     if (metadata.channels !== RING_BUFFER_CHANNELS) {
       throw new Error(`Expected ${RING_BUFFER_CHANNELS} output channels, received ${metadata.channels}.`);
     }
@@ -802,7 +881,6 @@ export class BrowserClockAudioClient {
       throw new Error("Browser-clock audio buffer is not initialized.");
     }
 
-    const source = new Float32Array(buffer);
     const expectedSamples = metadata.target_frame_count * metadata.channels;
     if (source.length !== expectedSamples) {
       throw new Error("Browser-clock PCM payload length did not match render metadata.");
@@ -861,18 +939,20 @@ export class BrowserClockAudioClient {
   private currentQueueTargets(streamConfig: BrowserClockStreamConfigMessage): QueueTargets {
     const latencySettings = this.currentLatencySettings();
     const claimTargets = this.buildClaimTargets(streamConfig.target_sample_rate, latencySettings);
+    const jitterBuffer = this.jitterController.state();
+    const requestFrames = Math.max(1024, latencyMsToFrames(streamConfig.target_sample_rate, jitterBuffer.requestMs));
     const steadyLowWaterFrames = this.clampBufferedFrames(
-      latencyMsToFrames(streamConfig.target_sample_rate, latencySettings.steadyLowWaterMs)
-    );
-    const steadyHighWaterFrames = this.clampBufferedFrames(
-      Math.max(steadyLowWaterFrames + 1024, latencyMsToFrames(streamConfig.target_sample_rate, latencySettings.steadyHighWaterMs))
+      latencyMsToFrames(streamConfig.target_sample_rate, jitterBuffer.lowWaterMs)
     );
+    const steadyHighWaterFrames = this.clampBufferedFrames(steadyLowWaterFrames + requestFrames);
     const recoveryBoostFrames = this.underrunBoostFrames;
 
     if (!this.startupPrimed) {
+      const highWaterFrames = this.clampBufferedFrames(claimTargets.highWaterFrames + recoveryBoostFrames);
       return {
         lowWaterFrames: this.clampBufferedFrames(claimTargets.lowWaterFrames + recoveryBoostFrames),
-        highWaterFrames: this.clampBufferedFrames(claimTargets.highWaterFrames + recoveryBoostFrames),
+        highWaterFrames,
+        maxRequestFrames: highWaterFrames,
         maxParallelRequests:
           recoveryBoostFrames > 0 ? latencySettings.recoveryMaxParallelRequests : claimTargets.maxParallelRequests
       };
@@ -885,6 +965,7 @@ export class BrowserClockAudioClient {
     return {
       lowWaterFrames,
       highWaterFrames,
+      maxRequestFrames: requestFrames,
       maxParallelRequests:
         recoveryBoostFrames > 0 ? latencySettings.recoveryMaxParallelRequests : latencySettings.steadyMaxParallelRequests
     };
@@ -911,9 +992,50 @@ export class BrowserClockAudioClient {
     return Math.max(0, Atomics.load(this.stateBuffer, 2));
   }
 
+  getJitterBufferState(): BrowserClockJitterBufferStatus | null {
+    const streamConfig = this.streamConfig;
+    if (!streamConfig) {
+      return null;
+    }
+    const queueTargets = this.currentQueueTargets(streamConfig);
+    const targetFrames = this.startupPrimed
+      ? (queueTargets.lowWaterFrames + queueTargets.highWaterFrames) / 2
+      : queueTargets.highWaterFrames;
+    return {
+      ...this.jitterController.state(),
+      addedLatencyMs: (targetFrames * 1000) / streamConfig.target_sample_rate
+    };
+  }
+
+  private resetPlaybackObservation(): void {
+    this.lastObservedReadFrame = this.stateBuffer ? Atomics.load(this.stateBuffer, 0) : 0;
+    this.lastObservedPlaybackAtMs = performance.now();
+  }
+
+  private observePlayback(underrunDelta: number): void {
+    if (!this.stateBuffer) {
+      return;
+    }
+    const readFrame = Atomics.load(this.stateBuffer, 0);
+    const nowMs = performance.now();
+    // A starved quantum still advances the read index by whatever it consumed, so underruns are already
+    // inside the consumed quanta. A fully empty quantum consumes nothing, so count at least one per underrun.
+    const consumedQuanta = Math.floor(
+      Math.max(0, readFrame - this.lastObservedReadFrame) / AUDIO_RENDER_QUANTUM_FRAMES
+    );
+    const playedQuanta = Math.max(underrunDelta, consumedQuanta);
+    if (playedQuanta <= 0) {
+      return;
+    }
+    this.jitterController.observePlayback(playedQuanta, underrunDelta, nowMs - this.lastObservedPlaybackAtMs);
+    this.lastObservedReadFrame += consumedQuanta * AUDIO_RENDER_QUANTUM_FRAMES;
+    this.lastObservedPlaybackAtMs = nowMs;
+  }
+
   private observeUnderruns(streamConfig: BrowserClockStreamConfigMessage): void {
     const latencySettings = this.currentLatencySettings();
     const currentUnderrunCount = this.readUnderrunCount();
+    this.observePlayback(Math.max(0, currentUnderrunCount - this.lastUnderrunCount));
     if (currentUnderrunCount > this.lastUnderrunCount) {
       const delta = currentUnderrunCount - this.lastUnderrunCount;
       const boostFramesPerUnderrun = latencyMsToFrames(
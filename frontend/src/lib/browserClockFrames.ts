@@ -0,0 +1,261 @@
+import type { BrowserClockPcmEncoding, SessionSequencerStatus } from "../types";
+
+// Mirrors backend/app/engine/browser_clock_frames.py (`<4sBBBBIIQQIIIQfffI`, little-endian).
+const RENDER_CHUNK_FRAME_MAGIC = 0x4352434f; // "OCRC" read as a little-endian uint32
+const RENDER_CHUNK_FRAME_VERSION = 1;
+const RENDER_CHUNK_HEADER_BYTES = 68;
+const RENDER_CHUNK_FLAG_STATUS_DELTA = 0x01;
+const S16_FULL_SCALE = 32_767;
+
+const PCM_ENCODINGS: Record<number, BrowserClockPcmEncoding> = {
+  0: "f32le",
+  1: "s16le",
+  2: "rice24"
+};
+
+// Mirrors backend/app/engine/lossless_pcm.py.
+const RICE24_PARTITION_FRAMES = 256;
+const RICE24_CHANNEL_HEADER_BYTES = 8;
+const RICE24_FULL_SCALE = 8_388_607;
+
+type BrowserClockStatusEntries = {
+  tracks?: SessionSequencerStatus["tracks"];
+  controller_tracks?: SessionSequencerStatus["controller_tracks"];
+  arpeggiators?: SessionSequencerStatus["arpeggiators"];
+};
+
+export type BrowserClockRenderFrame = {
+  chunkSequence: number;
+  blockCount: number;
+  engineSampleStart: number;
+  engineSampleEnd: number;
+  engineSampleRate: number;
+  targetSampleRate: number;
+  targetFrameCount: number;
+  channels: number;
+  transportSubunit: number;
+  pcmEncoding: BrowserClockPcmEncoding;
+  renderServiceTimeMs: number | null;
+  websocketMessageWaitMs: number | null;
+  noteOnToRenderCompleteMs: number | null;
+  sequencerStatusDelta: Partial<SessionSequencerStatus> | null;
+  sequencerStatusEntries: BrowserClockStatusEntries | null;
+  samples: Float32Array;
+};
+
+function finiteOrNull(value: number): number | null {
+  return Number.isFinite(value) ? value : null;
+}
+
+class MsbBitReader {
+  private bytes: Uint8Array;
+  private position = 0;
+
+  constructor(bytes: Uint8Array) {
+    this.bytes = bytes;
+  }
+
+  readUnary(): number {
+    let count = 0;
+    for (;;) {
+      const byteIndex = this.position >>> 3;
+      if (byteIndex >= this.bytes.length) {
+        throw new Error("Browser-clock compressed PCM bitstream ended early.");
+      }
+      const bitOffset = this.position & 7;
+      // Left-align the unread bits of the current byte so clz32 counts the leading zeros directly.
+      const window = (this.bytes[byteIndex] << (24 + bitOffset)) >>> 0;
+      if (window === 0) {
+        count += 8 - bitOffset;
+        this.position += 8 - bitOffset;
+        continue;
+      }
+      const zeros = Math.clz32(window);
+      count += zeros;
+      this.position += zeros + 1;
+      return count;
+    }
+  }
+
+  readBits(bitCount: number): number {
+    let value = 0;
+    for (let remaining = bitCount; remaining > 0; ) {
+      const byteIndex = this.position >>> 3;
+      if (byteIndex >= this.bytes.length) {
+        throw new Error("Browser-clock compressed PCM bitstream ended early.");
+      }
+      const bitOffset = this.position & 7;
+      const take = Math.min(remaining, 8 - bitOffset);
+      const bits = (this.bytes[byteIndex] >>> (8 - bitOffset - take)) & ((1 << take) - 1);
+      value = value * (1 << take) + bits;
+      remaining -= take;
+      this.position += take;
+    }
+    return value;
+  }
+}
+
+function decodeRice24Samples(
+  buffer: ArrayBuffer,
+  byteOffset: number,
+  frameCount: number,
+  channels: number
+): Float32Array {
+  const view = new DataView(buffer);
+  const samples = new Float32Array(frameCount * channels);
+  const values = new Float64Array(frameCount);
+  let offset = byteOffset;
+
+  for (let channel = 0; channel < channels; channel += 1) {
+    if (offset + RICE24_CHANNEL_HEADER_BYTES > buffer.byteLength) {
+      throw new Error("Browser-clock compressed PCM payload is truncated.");
+    }
+    const order = view.getUint8(offset);
+    const partitionCount = view.getUint16(offset + 2, true);
+    const bitstreamBytes = view.getUint32(offset + 4, true);
+    offset += RICE24_CHANNEL_HEADER_BYTES;
+    if (offset + partitionCount + bitstreamBytes > buffer.byteLength) {
+      throw new Error("Browser-clock compressed PCM payload is truncated.");
+    }
+    const parameters = new Uint8Array(buffer, offset, partitionCount);
+    offset += partitionCount;
+    const reader = new MsbBitReader(new Uint8Array(buffer, offset, bitstreamBytes));
+    offset += bitstreamBytes;
+
+    for (let index = 0; index < frameCount; index += 1) {
+      const k = parameters[Math.floor(index / RICE24_PARTITION_FRAMES)];
+      const folded = reader.readUnary() * 2 ** k + reader.readBits(k);
+      values[index] = folded % 2 === 0 ? folded / 2 : -(folded + 1) / 2;
+    }
+    // Residuals were taken against zero history, so undoing each difference order is a running sum.
+    for (let pass = 0; pass < order; pass += 1) {
+      let sum = 0;
+      for (let index = 0; index < frameCount; index += 1) {
+        sum += values[index];
+        values[index] = sum;
+      }
+    }
+    for (let index = 0; index < frameCount; index += 1) {
+      samples[index * channels + channel] = values[index] / RICE24_FULL_SCALE;
+    }
+  }
+
+  return samples;
+}
+
+function decodeSamples(
+  buffer: ArrayBuffer,
+  byteOffset: number,
+  frameCount: number,
+  channels: number,
+  encoding: BrowserClockPcmEncoding
+): Float32Array {
+  const sampleCount = frameCount * channels;
+  if (encoding === "rice24") {
+    return decodeRice24Samples(buffer, byteOffset, frameCount, channels);
+  }
+  if (encoding === "f32le") {
+    if (buffer.byteLength - byteOffset !== sampleCount * 4) {
+      throw new Error("Browser-clock PCM payload length did not match render metadata.");
+    }
+    return new Float32Array(buffer, byteOffset, sampleCount);
+  }
+
+  if (buffer.byteLength - byteOffset !== sampleCount * 2) {
+    throw new Error("Browser-clock PCM payload length did not match render metadata.");
+  }
+  const source = new Int16Array(buffer, byteOffset, sampleCount);
+  const samples = new Float32Array(sampleCount);
+  for (let index = 0; index < sampleCount; index += 1) {
+    samples[index] = source[index] / S16_FULL_SCALE;
+  }
+  return samples;
+}
+
+export function decodeBrowserClockRenderFrame(buffer: ArrayBuffer): BrowserClockRenderFrame {
+  if (buffer.byteLength < RENDER_CHUNK_HEADER_BYTES) {
+    throw new Error("Browser-clock render frame is shorter than its header.");
+  }
+
+  const view = new DataView(buffer);
+  if (view.getUint32(0, true) !== RENDER_CHUNK_FRAME_MAGIC) {
+    throw new Error("Browser-clock render frame has an unknown signature.");
+  }
+  const version = view.getUint8(4);
+  if (version !== RENDER_CHUNK_FRAME_VERSION) {
+    throw new Error(`Unsupported browser-clock render frame version ${version}.`);
+  }
+  const pcmEncoding = PCM_ENCODINGS[view.getUint8(5)];
+  if (!pcmEncoding) {
+    throw new Error("Browser-clock render frame uses an unknown PCM encoding.");
+  }
+
+  const channels = view.getUint8(6);
+  const flags = view.getUint8(7);
+  const targetFrameCount = view.getUint32(40, true);
+  const jsonLength = view.getUint32(64, true);
+  const pcmOffset = RENDER_CHUNK_HEADER_BYTES + jsonLength;
+  if (pcmOffset > buffer.byteLength) {
+    throw new Error("Browser-clock render frame metadata overruns the payload.");
+  }
+
+  let sequencerStatusDelta: Partial<SessionSequencerStatus> | null = null;
+  let sequencerStatusEntries: BrowserClockStatusEntries | null = null;
+  if ((flags & RENDER_CHUNK_FLAG_STATUS_DELTA) !== 0 && jsonLength > 0) {
+    const text = new TextDecoder().decode(new Uint8Array(buffer, RENDER_CHUNK_HEADER_BYTES, jsonLength));
+    const parsed = JSON.parse(text) as {
+      sequencer_status?: Partial<SessionSequencerStatus>;
+      sequencer_status_entries?: BrowserClockStatusEntries;
+    };
+    sequencerStatusDelta = parsed.sequencer_status ?? null;
+    sequencerStatusEntries = parsed.sequencer_status_entries ?? null;
+  }
+
+  return {
+    chunkSequence: view.getUint32(8, true),
+    blockCount: view.getUint32(12, true),
+    engineSampleStart: Number(view.getBigUint64(16, true)),
+    engineSampleEnd: Number(view.getBigUint64(24, true)),
+    engineSampleRate: view.getUint32(32, true),
+    targetSampleRate: view.getUint32(36, true),
+    targetFrameCount,
+    channels,
+    transportSubunit: Number(view.getBigUint64(44, true)),
+    pcmEncoding,
+    renderServiceTimeMs: finiteOrNull(view.getFloat32(52, true)),
+    websocketMessageWaitMs: finiteOrNull(view.getFloat32(56, true)),
+    noteOnToRenderCompleteMs: finiteOrNull(view.getFloat32(60, true)),
+    sequencerStatusDelta,
+    sequencerStatusEntries,
+    samples: decodeSamples(buffer, pcmOffset, targetFrameCount, channels, pcmEncoding)
+  };
+}
+
+function mergeStatusEntries<T>(entries: T[], updates: T[] | undefined, key: (entry: T) => string): T[] {
+  if (!updates || updates.length === 0) {
+    return entries;
+  }
+  const updatesById = new Map(updates.map((entry) => [key(entry), entry]));
+  return entries.map((entry) => updatesById.get(key(entry)) ?? entry);
+}
+
+export function applyBrowserClockStatusDelta(
+  baseline: SessionSequencerStatus,
+  frame: BrowserClockRenderFrame
+): SessionSequencerStatus {
+  const status: SessionSequencerStatus = {
+    ...baseline,
+    ...(frame.sequencerStatusDelta ?? {}),
+    transport_subunit: frame.transportSubunit
+  };
+  const entries = frame.sequencerStatusEntries;
+  if (!entries) {
+    return status;
+  }
+  return {
+    ...status,
+    tracks: mergeStatusEntries(status.tracks, entries.tracks, (track) => track.track_id),
+    controller_tracks: mergeStatusEntries(status.controller_tracks, entries.controller_tracks, (track) => track.track_id),
+    arpeggiators: mergeStatusEntries(status.arpeggiators, entries.arpeggiators, (arpeggiator) => arpeggiator.arpeggiator_id)
+  };
+}
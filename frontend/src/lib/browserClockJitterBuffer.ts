@@ -0,0 +1,121 @@
+import type { BrowserClockLatencySettings } from "../types";
+import {
+  BROWSER_CLOCK_TARGET_UNDERRUN_PROBABILITY,
+  BROWSER_CLOCK_WATER_MS_MAX,
+  BROWSER_CLOCK_WATER_MS_MIN
+} from "./browserClockLatencyConfig";
+
+// RTT smoothing follows the TCP retransmission timer (RFC 6298): 1/8 for the mean, 1/4 for the deviation.
+const RTT_MEAN_GAIN = 0.125;
+const RTT_DEVIATION_GAIN = 0.25;
+// Underrun probability is averaged over roughly this many render quanta (about 5 s at 48 kHz).
+const UNDERRUN_WINDOW_QUANTA = 2_000;
+const MARGIN_MIN = 1;
+const MARGIN_MAX = 16;
+const MARGIN_INITIAL = 4;
+const MARGIN_STEP_PER_UNDERRUN = 1;
+const MARGIN_DECAY_PER_SECOND = 0.05;
+const REQUEST_MS_MIN = 10;
+
+export type BrowserClockJitterBufferState = {
+  lowWaterMs: number;
+  requestMs: number;
+  renderRttMs: number | null;
+  renderRttDeviationMs: number;
+  underrunProbability: number;
+  targetUnderrunProbability: number;
+};
+
+/**
+ * Adapts the browser-clock refill point to the observed render round trip and underrun rate.
+ *
+ * A refill is requested once the ring drops below the low-water mark and lands one render round trip
+ * later, so the low-water mark is the smoothed RTT plus `margin` RTT deviations. Each underrun widens
+ * the margin at once. While the smoothed per-quantum underrun probability stays under the target, the
+ * margin shrinks slowly, so good links settle at minimal latency and bad links stop glitching. Each
+ * request covers about one round trip of audio. Until the first round trip is measured, the steady
+ * low-water and high-water settings seed both values.
+ */
+export class BrowserClockJitterController {
+  private readonly targetUnderrunProbability: number;
+  private initialLowWaterMs = 0;
+  private initialRequestMs = 0;
+  private rttMeanMs: number | null = null;
+  private rttDeviationMs = 0;
+  private underrunProbability = 0;
+  private margin = MARGIN_INITIAL;
+
+  constructor(
+    latencySettings: BrowserClockLatencySettings,
+    targetUnderrunProbability: number = BROWSER_CLOCK_TARGET_UNDERRUN_PROBABILITY
+  ) {
+    this.targetUnderrunProbability = Math.max(1e-6, targetUnderrunProbability);
+    this.reset(latencySettings);
+  }
+
+  reset(latencySettings: BrowserClockLatencySettings): void {
+    this.initialLowWaterMs = latencySettings.steadyLowWaterMs;
+    this.initialRequestMs = Math.max(
+      REQUEST_MS_MIN,
+      latencySettings.steadyHighWaterMs - latencySettings.steadyLowWaterMs
+    );
+    this.rttMeanMs = null;
+    this.rttDeviationMs = 0;
+    this.underrunProbability = 0;
+    this.margin = MARGIN_INITIAL;
+  }
+
+  observeRenderRoundTrip(rttMs: number): void {
+    if (!Number.isFinite(rttMs) || rttMs < 0) {
+      return;
+    }
+    if (this.rttMeanMs === null) {
+      this.rttMeanMs = rttMs;
+      this.rttDeviationMs = rttMs / 2;
+      return;
+    }
+    this.rttDeviationMs += RTT_DEVIATION_GAIN * (Math.abs(rttMs - this.rttMeanMs) - this.rttDeviationMs);
+    this.rttMeanMs += RTT_MEAN_GAIN * (rttMs - this.rttMeanMs);
+  }
+
+  observePlayback(elapsedQuanta: number, underruns: number, elapsedMs: number): void {
+    if (elapsedQuanta <= 0) {
+      return;
+    }
+    const quantaUnderrunRate = Math.min(1, underruns / elapsedQuanta);
+    const gain = 1 - Math.pow(1 - 1 / UNDERRUN_WINDOW_QUANTA, elapsedQuanta);
+    this.underrunProbability += gain * (quantaUnderrunRate - this.underrunProbability);
+
+    if (underruns > 0) {
+      this.margin = Math.min(MARGIN_MAX, this.margin + underruns * MARGIN_STEP_PER_UNDERRUN);
+    } else if (this.underrunProbability < this.targetUnderrunProbability) {
+      this.margin = Math.max(MARGIN_MIN, this.margin - (MARGIN_DECAY_PER_SECOND * elapsedMs) / 1000);
+    }
+  }
+
+  state(): BrowserClockJitterBufferState {
+    return {
+      lowWaterMs: this.lowWaterMs(),
+      requestMs: this.requestMs(),
+      renderRttMs: this.rttMeanMs,
+      renderRttDeviationMs: this.rttDeviationMs,
+      underrunProbability: this.underrunProbability,
+      targetUnderrunProbability: this.targetUnderrunProbability
+    };
+  }
+
+  lowWaterMs(): number {
+    if (this.rttMeanMs === null) {
+      return this.initialLowWaterMs;
+    }
+    const lowWaterMs = this.rttMeanMs + this.margin * this.rttDeviationMs;
+    return Math.min(BROWSER_CLOCK_WATER_MS_MAX, Math.max(BROWSER_CLOCK_WATER_MS_MIN, lowWaterMs));
+  }
+
+  requestMs(): number {
+    if (this.rttMeanMs === null) {
+      return this.initialRequestMs;
+    }
+    return Math.min(BROWSER_CLOCK_WATER_MS_MAX, Math.max(REQUEST_MS_MIN, this.rttMeanMs + this.rttDeviationMs));
+  }
+}
@@ -1,5 +1,5 @@
 import { wsBaseUrl } from "../api/client";
-import type { BrowserClockLatencySettings } from "../types";
+import type { BrowserClockLatencySettings, BrowserClockPcmEncoding } from "../types";
 
 export const BROWSER_CLOCK_WATER_MS_MIN = 20;
 export const BROWSER_CLOCK_WATER_MS_MAX = 2_000;
@@ -13,6 +13,9 @@ export const BROWSER_CLOCK_IMMEDIATE_RENDER_BLOCKS_MIN = 1;
 export const BROWSER_CLOCK_IMMEDIATE_RENDER_BLOCKS_MAX = 128;
 export const BROWSER_CLOCK_IMMEDIATE_COOLDOWN_MS_MIN = 0;
 export const BROWSER_CLOCK_IMMEDIATE_COOLDOWN_MS_MAX = 1_000;
+// Steady-state underruns per render quantum the adaptive jitter buffer aims for, about one glitch per
+// 27 s at 48 kHz. The steady low-water and high-water settings only seed the adaptive marks.
+export const BROWSER_CLOCK_TARGET_UNDERRUN_PROBABILITY = 1e-4;
 
 export const REMOTE_BROWSER_CLOCK_LATENCY_SETTINGS: BrowserClockLatencySettings = {
   steadyLowWaterMs: 450,
@@ -110,6 +113,11 @@ export function resolveDefaultBrowserClockLatencySettings(): BrowserClockLatency
     : { ...REMOTE_BROWSER_CLOCK_LATENCY_SETTINGS };
 }
 
+export function resolveDefaultBrowserClockPcmEncoding(): BrowserClockPcmEncoding {
+  // Remote links get losslessly compressed int24 chunks; local links skip the codec and keep float32.
+  return isLikelyLocalBrowserClockHost() ? "f32le" : "rice24";
+}
+
 export function normalizeBrowserClockLatencySettings(
   value: Partial<BrowserClockLatencySettings> | null | undefined,
   fallback?: BrowserClockLatencySettings
@@ -49,6 +49,7 @@ export interface PerformanceCsdExportRequestPayload {
   performanceExport: PerformanceExportPayload;
   sequencerConfig: SessionSequencerConfigRequest;
   eventSource?: "midiFile" | "score";
+  renderAudio?: boolean;
   midiControllers?: Array<{
     controllerNumber: number;
     value: number;
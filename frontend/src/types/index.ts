@@ -888,12 +888,28 @@ export interface SessionActionResponse {
   detail: string;
 }
 
+export type SessionHotReloadVoicePolicy = "release" | "cut";
+
+export interface SessionHotReloadResponse {
+  session_id: string;
+  state: SessionState;
+  detail: string;
+  swapped_instruments: string[];
+  diagnostics: string[];
+}
+
+export type BrowserClockRenderChunkFormat = "json" | "binary";
+
+export type BrowserClockPcmEncoding = "f32le" | "s16le" | "rice24";
+
 export interface BrowserClockClaimControllerRequest {
   type: "claim_controller";
   audio_context_sample_rate: number;
   queue_low_water_frames: number;
   queue_high_water_frames: number;
   max_blocks_per_request: number;
+  render_chunk_format?: BrowserClockRenderChunkFormat;
+  pcm_encoding?: BrowserClockPcmEncoding;
 }
 
 export interface BrowserClockRequestRenderRequest {
@@ -964,6 +980,9 @@ export interface BrowserClockStreamConfigMessage {
   server_monotonic_ns: number;
   timing_report_interval_ms: number;
   engine_ksmps_latency_frames: number;
+  render_ahead_frames?: number;
+  render_chunk_format?: BrowserClockRenderChunkFormat;
+  pcm_encoding?: BrowserClockPcmEncoding;
   sequencer_status: SessionSequencerStatus;
 }
 
@@ -976,6 +995,9 @@ export interface BrowserClockRenderTelemetry {
   timing_report_age_ms: number | null;
   timing_sync_stale: boolean;
   clock_sync_rtt_ms: number | null;
+  clock_skew_ppm: number | null;
+  clock_fit_residual_ms: number | null;
+  clock_rejected_samples: number;
   websocket_message_wait_ms: number | null;
   render_service_time_ms: number;
   server_received_monotonic_ns: number;
@@ -1075,4 +1097,5 @@ export interface SessionEvent {
   ts: string;
   type: string;
   payload: JsonObject;
+  seq?: number | null;
 }
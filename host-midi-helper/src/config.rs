@@ -19,7 +19,7 @@ pub struct Config {
     #[arg(long, env = "VISUALCSOUND_HOST_MIDI_HOST_NAME")]
     pub host_name: Option<String>,
 
-    #[arg(long, env = "VISUALCSOUND_HOST_MIDI_PROTOCOL_VERSION", default_value_t = 1)]
+    #[arg(long, env = "VISUALCSOUND_HOST_MIDI_PROTOCOL_VERSION", default_value_t = 2)]
     pub protocol_version: u32,
 
     #[arg(long, env = "VISUALCSOUND_HOST_MIDI_CLOCK_SYNC_INTERVAL_MS", default_value_t = 250)]
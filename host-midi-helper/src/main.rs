@@ -17,10 +17,14 @@ use tracing_subscriber::EnvFilter;
 use crate::config::Config;
 use crate::platform::{CapturedMidiEvent, MidiDiscovery, PlatformError};
 use crate::protocol::{
+    BackendMessage,
+    BinaryFrameEncoder,
     ClockSyncRequest,
     DeviceInventoryRequest,
     MidiEventsRequest,
     RegisterHostRequest,
+    BINARY_PROTOCOL_VERSION,
+    JSON_PROTOCOL_VERSION,
 };
 
 #[derive(Debug, thiserror::Error)]
@@ -96,6 +100,9 @@ async fn run(config: Config) -> Result<(), BridgeError> {
     let mut batch_interval = interval(Duration::from_millis(config.batch_interval_ms.max(1)));
     batch_interval.set_missed_tick_behavior(MissedTickBehavior::Skip);
 
+    // Events stay JSON until the backend acknowledges version 2 and advertises `binary_midi_events`.
+    let mut negotiated_protocol_version = JSON_PROTOCOL_VERSION;
+    let mut frame_encoder = BinaryFrameEncoder::default();
     let mut pending_events = Vec::with_capacity(config.max_batch_size.max(1));
     loop {
         tokio::select! {
@@ -105,7 +112,16 @@ async fn run(config: Config) -> Result<(), BridgeError> {
             }
             message = read.next() => {
                 match message {
-                    Some(Ok(Message::Text(payload))) => debug!(payload = %payload, "Received websocket text message"),
+                    Some(Ok(Message::Text(payload))) => {
+                        debug!(payload = %payload, "Received websocket text message");
+                        if let Ok(message) = serde_json::from_str::<BackendMessage>(&payload) {
+                            if message.kind == "host_registered" {
+                                negotiated_protocol_version =
+                                    message.negotiated_protocol_version(config.protocol_version);
+                                info!(protocol_version = negotiated_protocol_version, "Host MIDI protocol negotiated");
+                            }
+                        }
+                    }
                     Some(Ok(Message::Close(frame))) => {
                         info!(?frame, "Backend closed host MIDI websocket");
                         break;
@@ -146,14 +162,14 @@ async fn run(config: Config) -> Result<(), BridgeError> {
                 }
             }
             _ = batch_interval.tick(), if !pending_events.is_empty() => {
-                flush_events(&mut write, &mut pending_events).await?;
+                flush_events(&mut write, &mut pending_events, negotiated_protocol_version, &mut frame_encoder).await?;
             }
             maybe_event = event_receiver.recv() => {
                 match maybe_event {
                     Some(event) => {
                         pending_events.push(event.into_protocol());
                         if pending_events.len() >= config.max_batch_size.max(1) {
-                            flush_events(&mut write, &mut pending_events).await?;
+                            flush_events(&mut write, &mut pending_events, negotiated_protocol_version, &mut frame_encoder).await?;
                         }
                     }
                     None => {
@@ -166,7 +182,13 @@ async fn run(config: Config) -> Result<(), BridgeError> {
     }
 
     if !pending_events.is_empty() {
-        flush_events(&mut write, &mut pending_events).await?;
+        flush_events(
+            &mut write,
+            &mut pending_events,
+            negotiated_protocol_version,
+            &mut frame_encoder,
+        )
+        .await?;
     }
     Ok(())
 }
@@ -174,18 +196,28 @@ async fn run(config: Config) -> Result<(), BridgeError> {
 async fn flush_events<S>(
     write: &mut S,
     pending_events: &mut Vec<crate::protocol::HostMidiEvent>,
+    protocol_version: u32,
+    frame_encoder: &mut BinaryFrameEncoder,
 ) -> Result<(), BridgeError>
 where
     S: futures_util::Sink<Message, Error = tungstenite::Error> + Unpin,
 {
-    send_json(
-        write,
-        &MidiEventsRequest {
-            kind: "midi_events",
-            events: pending_events.as_slice(),
-        },
-    )
-    .await?;
+    if protocol_version >= BINARY_PROTOCOL_VERSION {
+        for chunk in pending_events.chunks(BinaryFrameEncoder::max_records_per_frame()) {
+            write
+                .send(Message::Binary(frame_encoder.encode(chunk).into()))
+                .await?;
+        }
+    } else {
+        send_json(
+            write,
+            &MidiEventsRequest {
+                kind: "midi_events",
+                events: pending_events.as_slice(),
+            },
+        )
+        .await?;
+    }
     pending_events.clear();
     Ok(())
 }
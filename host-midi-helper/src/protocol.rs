@@ -1,4 +1,15 @@
-use serde::Serialize;
+use std::collections::HashMap;
+
+use serde::{Deserialize, Serialize};
+
+pub const JSON_PROTOCOL_VERSION: u32 = 1;
+pub const BINARY_PROTOCOL_VERSION: u32 = 2;
+
+const FRAME_MAGIC: &[u8; 2] = b"VM";
+const FRAME_KIND_EVENTS: u8 = 1;
+const FRAME_HEADER_LEN: usize = 8;
+const EVENT_RECORD_LEN: usize = 13;
+const MAX_DEVICE_TABLE_LEN: usize = 4096;
 
 #[allow(dead_code)]
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize)]
@@ -54,3 +65,184 @@ pub struct MidiEventsRequest<'a> {
     pub kind: &'static str,
     pub events: &'a [HostMidiEvent],
 }
+
+#[derive(Debug, Deserialize)]
+pub struct BackendMessage {
+    #[serde(rename = "type")]
+    pub kind: String,
+    #[serde(default)]
+    pub protocol_version: Option<u32>,
+    #[serde(default)]
+    pub binary_midi_events: Option<bool>,
+}
+
+impl BackendMessage {
+    /// Returns the event protocol to use after `host_registered`. Binary frames need the backend to
+    /// advertise `binary_midi_events`; a backend that predates them may echo the requested version back.
+    pub fn negotiated_protocol_version(&self, requested: u32) -> u32 {
+        let accepted = self
+            .protocol_version
+            .unwrap_or(JSON_PROTOCOL_VERSION)
+            .min(requested);
+        if accepted >= BINARY_PROTOCOL_VERSION && self.binary_midi_events != Some(true) {
+            JSON_PROTOCOL_VERSION
+        } else {
+            accepted
+        }
+    }
+}
+
+/// Encodes `midi_events` batches as protocol version 2 binary frames.
+///
+/// Little-endian layout: an 8-byte header (`"VM"`, version u8, kind u8, device definition count u16,
+/// record count u16), then device definitions (index u16, id length u8, UTF-8 id), then 13-byte records
+/// (device index u16, timestamp ns u64, 3 MIDI bytes). Device ids are interned once per connection, so
+/// a definition is only sent the first time a device appears.
+#[derive(Debug, Default)]
+pub struct BinaryFrameEncoder {
+    device_indices: HashMap<String, u16>,
+    definitions: Vec<u8>,
+    records: Vec<u8>,
+}
+
+impl BinaryFrameEncoder {
+    pub fn max_records_per_frame() -> usize {
+        usize::from(u16::MAX)
+    }
+
+    /// Encodes up to `max_records_per_frame()` events. Messages that are not 3 bytes long are skipped
+    /// because the backend only schedules note and controller messages.
+    pub fn encode(&mut self, events: &[HostMidiEvent]) -> Vec<u8> {
+        self.definitions.clear();
+        self.records.clear();
+        let mut definition_count: u16 = 0;
+        let mut record_count: u16 = 0;
+
+        for event in events.iter().take(Self::max_records_per_frame()) {
+            if event.message.len() != 3 {
+                continue;
+            }
+            let index = match self.device_indices.get(&event.device_id) {
+                Some(index) => *index,
+                None => {
+                    let id_bytes = event.device_id.as_bytes();
+                    if id_bytes.is_empty()
+                        || id_bytes.len() > usize::from(u8::MAX)
+                        || self.device_indices.len() >= MAX_DEVICE_TABLE_LEN
+                    {
+                        continue;
+                    }
+                    let index = self.device_indices.len() as u16;
+                    self.device_indices.insert(event.device_id.clone(), index);
+                    self.definitions.extend_from_slice(&index.to_le_bytes());
+                    self.definitions.push(id_bytes.len() as u8);
+                    self.definitions.extend_from_slice(id_bytes);
+                    definition_count += 1;
+                    index
+                }
+            };
+            self.records.extend_from_slice(&index.to_le_bytes());
+            self.records
+                .extend_from_slice(&event.event_timestamp_ns.to_le_bytes());
+            self.records.extend_from_slice(&event.message);
+            record_count += 1;
+        }
+
+        let mut frame =
+            Vec::with_capacity(FRAME_HEADER_LEN + self.definitions.len() + self.records.len());
+        frame.extend_from_slice(FRAME_MAGIC);
+        frame.push(BINARY_PROTOCOL_VERSION as u8);
+        frame.push(FRAME_KIND_EVENTS);
+        frame.extend_from_slice(&definition_count.to_le_bytes());
+        frame.extend_from_slice(&record_count.to_le_bytes());
+        frame.extend_from_slice(&self.definitions);
+        frame.extend_from_slice(&self.records);
+        debug_assert_eq!(
+            frame.len(),
+            FRAME_HEADER_LEN
+                + self.definitions.len()
+                + usize::from(record_count) * EVENT_RECORD_LEN
+        );
+        frame
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn event(device_id: &str, timestamp_ns: u64, message: &[u8]) -> HostMidiEvent {
+        HostMidiEvent {
+            device_id: device_id.to_string(),
+            message: message.to_vec(),
+            event_timestamp_ns: timestamp_ns,
+            timestamp_quality: TimestampQuality::Native,
+        }
+    }
+
+    fn registered(payload: &str) -> BackendMessage {
+        serde_json::from_str(payload).expect("valid backend message")
+    }
+
+    #[test]
+    fn encodes_header_definitions_and_records() {
+        let mut encoder = BinaryFrameEncoder::default();
+        let frame = encoder.encode(&[
+            event("keys", 0x0102_0304_0506_0708, &[0x90, 60, 100]),
+            event("keys", 7, &[0x80, 60, 0]),
+        ]);
+
+        let mut expected = b"VM".to_vec();
+        expected.extend_from_slice(&[2, 1, 1, 0, 2, 0]);
+        expected.extend_from_slice(&[0, 0, 4]);
+        expected.extend_from_slice(b"keys");
+        expected.extend_from_slice(&[0, 0]);
+        expected.extend_from_slice(&0x0102_0304_0506_0708u64.to_le_bytes());
+        expected.extend_from_slice(&[0x90, 60, 100]);
+        expected.extend_from_slice(&[0, 0]);
+        expected.extend_from_slice(&7u64.to_le_bytes());
+        expected.extend_from_slice(&[0x80, 60, 0]);
+        assert_eq!(frame, expected);
+    }
+
+    #[test]
+    fn interns_device_ids_once_per_connection() {
+        let mut encoder = BinaryFrameEncoder::default();
+        encoder.encode(&[event("keys", 1, &[0x90, 60, 100])]);
+        let frame = encoder.encode(&[
+            event("keys", 2, &[0x80, 60, 0]),
+            event("pads", 3, &[0xB0, 7, 80]),
+        ]);
+
+        assert_eq!(&frame[4..8], &[1, 0, 2, 0]);
+        assert_eq!(&frame[8..15], &[1, 0, 4, b'p', b'a', b'd', b's']);
+        assert_eq!(&frame[15..17], &[0, 0]);
+        assert_eq!(&frame[28..30], &[1, 0]);
+        assert_eq!(frame.len(), FRAME_HEADER_LEN + 7 + 2 * EVENT_RECORD_LEN);
+    }
+
+    #[test]
+    fn skips_messages_that_are_not_three_bytes() {
+        let mut encoder = BinaryFrameEncoder::default();
+        let frame = encoder.encode(&[
+            event("keys", 1, &[0xF8]),
+            event("keys", 2, &[0xF0, 0x7E, 0x00, 0xF7]),
+        ]);
+
+        assert_eq!(frame, [b'V', b'M', 2, 1, 0, 0, 0, 0]);
+    }
+
+    #[test]
+    fn binary_frames_require_the_backend_capability_flag() {
+        let legacy = registered(r#"{"type":"host_registered","protocol_version":2}"#);
+        assert_eq!(legacy.negotiated_protocol_version(2), JSON_PROTOCOL_VERSION);
+
+        let capable =
+            registered(r#"{"type":"host_registered","protocol_version":2,"binary_midi_events":true}"#);
+        assert_eq!(capable.negotiated_protocol_version(2), BINARY_PROTOCOL_VERSION);
+        assert_eq!(capable.negotiated_protocol_version(1), JSON_PROTOCOL_VERSION);
+
+        let unversioned = registered(r#"{"type":"host_registered"}"#);
+        assert_eq!(unversioned.negotiated_protocol_version(2), JSON_PROTOCOL_VERSION);
+    }
+}